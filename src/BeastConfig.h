@@ -202,6 +202,13 @@
 #define SKYWELL_ENABLE_TICKETS 0
 #endif
 
+/** Config: SKYWELL_ENABLE_OFFERS
+    Enables processing of offer create and cancel transactions
+*/
+#ifndef SKYWELL_ENABLE_OFFERS
+#define SKYWELL_ENABLE_OFFERS 0
+#endif
+
 /** Config: USEMYSQL
     use Mysql Database
 */
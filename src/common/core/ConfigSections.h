@@ -34,6 +34,7 @@ struct ConfigSection
 
 //  TODO Rename and replace these macros with variables.
 #define SECTION_ACCOUNT_PROBE_MAX       "account_probe_max"
+#define SECTION_ACCOUNT_TX_DB           "account_tx_db"
 #define SECTION_AMENDMENTS              "amendments"
 #define SECTION_CLUSTER_NODES           "cluster_nodes"
 #define SECTION_DEBUG_LOGFILE           "debug_logfile"
@@ -45,6 +45,7 @@ enum JobType
     jtPROPOSAL_ut,   // A proposal from an untrusted source
     jtLEDGER_DATA,   // Received data for a ledger we're acquiring
     jtCLIENT,        // A websocket command from the client
+    jtPUBPROPOSED,   // Publish transactions applied to the open ledger
     jtRPC,           // A websocket command from the client
     jtUPDATE_PF,     // Update pathfinding requests
     jtTRANSACTION,   // A transaction received from the network
@@ -52,6 +53,7 @@ enum JobType
     jtADVANCE,       // Advance validated/acquired ledgers
     jtPUBLEDGER,     // Publish a fully-accepted ledger
     jtTXN_DATA,      // Fetch a proposed set
+    jtSPECULATE,     // Build a candidate ledger ahead of consensus
     jtWAL,           // Write-ahead logging
     jtVALIDATION_t,  // A validation from a trusted source
     jtWRITE,         // Write out hashed objects
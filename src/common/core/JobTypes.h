@@ -70,6 +70,10 @@ public:
         add (jtCLIENT,        "clientCommand",
             maxLimit, true,   false, 2000,  5000);
 
+        // Publish transactions applied to the open ledger
+        add (jtPUBPROPOSED,   "publishProposed",
+            1,        false,  false, 0,     0);
+
         // A websocket command from the client
         add (jtRPC,           "RPC",
             maxLimit, false,  false, 0,     0);
@@ -98,6 +102,10 @@ public:
         add (jtTXN_DATA,      "fetchTxnData",
             1,        true,   false, 0,     0);
 
+        // Build a candidate ledger ahead of consensus
+        add (jtSPECULATE,     "speculateLedger",
+            1,        false,  false, 0,     0);
+
         // Write-ahead logging
         add (jtWAL,           "writeAhead",
             maxLimit, false,  false, 1000,  2500);
@@ -0,0 +1,52 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_CORE_WORKERPOOL_H_INCLUDED
+#define SKYWELL_CORE_WORKERPOOL_H_INCLUDED
+
+#include <cstddef>
+#include <functional>
+
+namespace truechain {
+
+/** Returns how many threads to split a number of items across.
+
+    Each thread is given at least itemsPerThread items, and no more
+    threads are used than the worker pool and the machine can run at
+    once. The result is never less than one.
+*/
+int parallelThreadCount (std::size_t items, std::size_t itemsPerThread = 1);
+
+/** Call work on up to the given number of threads at once.
+
+    The calling thread makes one of the calls, and the others are made
+    on threads of a pool shared by the whole process. Each call is
+    expected to take items from a counter shared with the others and
+    return once none are left. runParallel returns when every call has
+    returned, and rethrows the first exception any of them threw.
+
+    Calls the pool has not started by the time the caller's own call
+    returns are abandoned, so a caller never waits for a busy pool and
+    runParallel may be used from work already running on the pool.
+*/
+void runParallel (int threads, std::function <void ()> const& work);
+
+} // truechain
+
+#endif
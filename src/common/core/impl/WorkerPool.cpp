@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <common/core/WorkerPool.h>
+#include <beast/module/core/thread/Workers.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace truechain {
+
+namespace {
+
+enum
+{
+    // Most threads one parallel task runs on, its caller included
+    maximumThreads = 8
+};
+
+int
+hardwareThreads ()
+{
+    return std::max (1, std::min<int> (maximumThreads,
+        std::thread::hardware_concurrency ()));
+}
+
+class WorkerPool : private beast::Workers::Callback
+{
+public:
+    // Sized for the largest task rather than the machine, so a caller
+    // that asks for more threads than there are cores still gets them
+    WorkerPool ()
+        : m_workers (*this, "WorkerPool", maximumThreads - 1)
+    {
+    }
+
+    void
+    run (int threads, std::function <void ()> const& work)
+    {
+        Batch batch (work);
+
+        {
+            std::lock_guard <std::mutex> sl (m_mutex);
+
+            for (int i = 1; i < threads; ++i)
+                m_queue.push_back (&batch);
+        }
+
+        for (int i = 1; i < threads; ++i)
+            m_workers.addTask ();
+
+        try
+        {
+            work ();
+        }
+        catch (...)
+        {
+            batch.fail (std::current_exception ());
+        }
+
+        {
+            std::unique_lock <std::mutex> sl (m_mutex);
+
+            // Whatever is left has been done by the threads already running
+            m_queue.erase (std::remove (m_queue.begin (), m_queue.end (),
+                &batch), m_queue.end ());
+
+            batch.finished.wait (sl, [&batch] { return batch.running == 0; });
+        }
+
+        if (batch.error)
+            std::rethrow_exception (batch.error);
+    }
+
+private:
+    struct Batch
+    {
+        explicit Batch (std::function <void ()> const& work_)
+            : work (work_)
+        {
+        }
+
+        void
+        fail (std::exception_ptr e)
+        {
+            std::lock_guard <std::mutex> sl (lock);
+
+            if (!error)
+                error = e;
+        }
+
+        std::function <void ()> const& work;
+
+        // Calls in progress on the pool, guarded by the pool's mutex
+        int running = 0;
+        std::condition_variable finished;
+
+        std::mutex lock;
+        std::exception_ptr error;
+    };
+
+    void
+    processTask () override
+    {
+        Batch* batch;
+
+        {
+            std::lock_guard <std::mutex> sl (m_mutex);
+
+            // Abandoned by a caller that finished first
+            if (m_queue.empty ())
+                return;
+
+            batch = m_queue.front ();
+            m_queue.pop_front ();
+            ++batch->running;
+        }
+
+        try
+        {
+            batch->work ();
+        }
+        catch (...)
+        {
+            batch->fail (std::current_exception ());
+        }
+
+        std::lock_guard <std::mutex> sl (m_mutex);
+
+        if (--batch->running == 0)
+            batch->finished.notify_all ();
+    }
+
+    std::mutex m_mutex;
+    std::deque <Batch*> m_queue;
+    beast::Workers m_workers;
+};
+
+WorkerPool&
+workerPool ()
+{
+    static WorkerPool pool;
+    return pool;
+}
+
+} // anonymous namespace
+
+int
+parallelThreadCount (std::size_t items, std::size_t itemsPerThread)
+{
+    return std::max (1, std::min<int> (hardwareThreads (),
+        std::min<std::size_t> (maximumThreads, items / itemsPerThread)));
+}
+
+void
+runParallel (int threads, std::function <void ()> const& work)
+{
+    if (threads <= 1)
+        work ();
+    else
+        workerPool ().run (threads, work);
+}
+
+} // truechain
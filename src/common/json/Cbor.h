@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_JSON_CBOR_H_INCLUDED
+#define SKYWELL_JSON_CBOR_H_INCLUDED
+
+#include <common/json/Output.h>
+#include <cstdint>
+#include <string>
+
+namespace Json {
+
+/** Writes CBOR (RFC 7049) data items to an Output.
+
+    This is the binary counterpart of Writer.  Every collection is written
+    with its length up front, so the caller must know how many entries a map
+    or an array will hold before starting it:
+
+        {
+            CborWriter w (out);
+
+            w.startMap (2);
+            w.text ("hello");
+            w.text ("world");
+            w.text ("blob");
+            w.bytes (data, size);
+        }
+
+    Nothing is buffered; each call writes its item straight to the output.
+*/
+class CborWriter
+{
+public:
+    explicit CborWriter (Output const& output)
+        : output_ (output)
+    {
+    }
+
+    /** Start a map of size key/value pairs.  Write the key, then the value,
+        for each entry. */
+    void startMap (std::size_t size);
+
+    /** Start an array of size items. */
+    void startArray (std::size_t size);
+
+    void text (boost::string_ref const&);
+    void bytes (void const* data, std::size_t size);
+    void signedInt (std::int64_t);
+    void unsignedInt (std::uint64_t);
+    void real (double);
+    void boolean (bool);
+    void null ();
+
+    /** Write a whole Json::Value. */
+    void value (Value const&);
+
+private:
+    void head (std::uint8_t major, std::uint64_t n);
+
+    Output output_;
+};
+
+/** Writes a Json::Value to an Output as a single CBOR data item. */
+void outputCbor (Value const&, Output const&);
+
+/** Return the CBOR encoding of a Json::Value. */
+std::string cborAsString (Value const&);
+
+/** Decode a single CBOR data item into a Json::Value.
+
+    Byte strings become hex strings and integers that do not fit in a
+    Json::Value become decimal strings, the same way 64-bit quantities are
+    rendered elsewhere.  Map keys must be text.
+
+    @return false if the data is malformed, nested too deeply, or has
+            trailing bytes.
+*/
+bool parseCbor (boost::string_ref const&, Value&);
+
+} // Json
+
+#endif
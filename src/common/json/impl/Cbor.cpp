@@ -0,0 +1,515 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <common/json/Cbor.h>
+#include <common/json/json_value.h>
+#include <cmath>
+#include <cstring>
+
+namespace Json {
+
+namespace {
+
+// Major types, RFC 7049 section 2.1
+enum : std::uint8_t
+{
+    majorUnsigned = 0,
+    majorNegative = 1,
+    majorBytes    = 2,
+    majorText     = 3,
+    majorArray    = 4,
+    majorMap      = 5,
+    majorTag      = 6,
+    majorSimple   = 7
+};
+
+enum : std::uint8_t
+{
+    simpleFalse      = 20,
+    simpleTrue       = 21,
+    simpleNull       = 22,
+    simpleUndefined  = 23,
+    additionalHalf   = 25,
+    additionalFloat  = 26,
+    additionalDouble = 27,
+    additionalIndefinite = 31,
+    breakCode        = 0xff
+};
+
+// Deeper input than this is rejected rather than recursed into.
+int const maxDepth = 64;
+
+} // namespace
+
+void CborWriter::head (std::uint8_t major, std::uint64_t n)
+{
+    char buf[9];
+    std::size_t size;
+    major <<= 5;
+
+    if (n < 24)
+    {
+        buf[0] = static_cast<char> (major | n);
+        size = 1;
+    }
+    else if (n <= 0xff)
+    {
+        buf[0] = static_cast<char> (major | 24);
+        size = 2;
+    }
+    else if (n <= 0xffff)
+    {
+        buf[0] = static_cast<char> (major | 25);
+        size = 3;
+    }
+    else if (n <= 0xffffffff)
+    {
+        buf[0] = static_cast<char> (major | 26);
+        size = 5;
+    }
+    else
+    {
+        buf[0] = static_cast<char> (major | 27);
+        size = 9;
+    }
+
+    for (std::size_t i = size - 1; i > 0; --i, n >>= 8)
+        buf[i] = static_cast<char> (n & 0xff);
+
+    output_ (boost::string_ref (buf, size));
+}
+
+void CborWriter::startMap (std::size_t size)
+{
+    head (majorMap, size);
+}
+
+void CborWriter::startArray (std::size_t size)
+{
+    head (majorArray, size);
+}
+
+void CborWriter::text (boost::string_ref const& s)
+{
+    head (majorText, s.size ());
+    output_ (s);
+}
+
+void CborWriter::bytes (void const* data, std::size_t size)
+{
+    head (majorBytes, size);
+    output_ (boost::string_ref (static_cast<char const*> (data), size));
+}
+
+void CborWriter::signedInt (std::int64_t i)
+{
+    if (i >= 0)
+        head (majorUnsigned, static_cast<std::uint64_t> (i));
+    else
+        head (majorNegative, static_cast<std::uint64_t> (-(i + 1)));
+}
+
+void CborWriter::unsignedInt (std::uint64_t i)
+{
+    head (majorUnsigned, i);
+}
+
+void CborWriter::real (double d)
+{
+    std::uint64_t bits;
+    static_assert (sizeof (bits) == sizeof (d), "unexpected double size");
+    std::memcpy (&bits, &d, sizeof (bits));
+
+    char buf[9];
+    buf[0] = static_cast<char> ((majorSimple << 5) | additionalDouble);
+    for (int i = 8; i > 0; --i, bits >>= 8)
+        buf[i] = static_cast<char> (bits & 0xff);
+
+    output_ (boost::string_ref (buf, sizeof (buf)));
+}
+
+void CborWriter::boolean (bool b)
+{
+    head (majorSimple, b ? simpleTrue : simpleFalse);
+}
+
+void CborWriter::null ()
+{
+    head (majorSimple, simpleNull);
+}
+
+void CborWriter::value (Value const& value)
+{
+    switch (value.type())
+    {
+    case Json::nullValue:
+        null ();
+        break;
+
+    case Json::intValue:
+        signedInt (value.asInt ());
+        break;
+
+    case Json::uintValue:
+        unsignedInt (value.asUInt ());
+        break;
+
+    case Json::realValue:
+        real (value.asDouble ());
+        break;
+
+    case Json::stringValue:
+    {
+        auto const s = value.asCString ();
+        text (boost::string_ref (s, std::strlen (s)));
+        break;
+    }
+
+    case Json::booleanValue:
+        boolean (value.asBool ());
+        break;
+
+    case Json::arrayValue:
+        startArray (value.size ());
+        for (auto const& i: value)
+            this->value (i);
+        break;
+
+    case Json::objectValue:
+        startMap (value.size ());
+        for (auto it = value.begin (); it != value.end (); ++it)
+        {
+            auto const name = it.memberName ();
+            text (boost::string_ref (name, std::strlen (name)));
+            this->value (*it);
+        }
+        break;
+    } // switch
+}
+
+void outputCbor (Value const& value, Output const& out)
+{
+    CborWriter (out).value (value);
+}
+
+std::string cborAsString (Value const& value)
+{
+    std::string s;
+    outputCbor (value, stringOutput (s));
+    return s;
+}
+
+//------------------------------------------------------------------------------
+
+namespace {
+
+class CborReader
+{
+public:
+    explicit CborReader (boost::string_ref const& data)
+        : p_ (reinterpret_cast<std::uint8_t const*> (data.data ()))
+        , end_ (p_ + data.size ())
+    {
+    }
+
+    bool parse (Value& value)
+    {
+        return item (value, 0) && p_ == end_;
+    }
+
+private:
+    bool item (Value& value, int depth)
+    {
+        if (depth > maxDepth || p_ == end_)
+            return false;
+
+        std::uint8_t const initial = *p_++;
+        std::uint8_t const major = initial >> 5;
+        std::uint8_t const additional = initial & 0x1f;
+
+        if (major == majorSimple)
+            return simple (additional, value);
+
+        if (additional == additionalIndefinite)
+            return indefinite (major, value, depth);
+
+        std::uint64_t n;
+        if (! argument (additional, n))
+            return false;
+
+        switch (major)
+        {
+        case majorUnsigned:
+            if (n <= Value::maxUInt)
+                value = static_cast<Value::UInt> (n);
+            else
+                value = std::to_string (n);
+            return true;
+
+        case majorNegative:
+            if (n <= static_cast<std::uint64_t> (-(Value::minInt + 1)))
+                value = static_cast<Value::Int> (-1 - static_cast<std::int64_t> (n));
+            else
+                value = -1.0 - static_cast<double> (n);
+            return true;
+
+        case majorBytes:
+        {
+            if (n > remaining ())
+                return false;
+            std::string s;
+            appendHex (s, n);
+            value = std::move (s);
+            return true;
+        }
+
+        case majorText:
+            if (n > remaining ())
+                return false;
+            value = Value (reinterpret_cast<char const*> (p_),
+                reinterpret_cast<char const*> (p_ + n));
+            p_ += n;
+            return true;
+
+        case majorArray:
+            value = Value (arrayValue);
+            for (std::uint64_t i = 0; i < n; ++i)
+            {
+                if (! item (value.append (Value ()), depth + 1))
+                    return false;
+            }
+            return true;
+
+        case majorMap:
+            value = Value (objectValue);
+            for (std::uint64_t i = 0; i < n; ++i)
+            {
+                if (! member (value, depth + 1))
+                    return false;
+            }
+            return true;
+
+        case majorTag:
+            // Tags only add meaning to the item that follows; the item itself
+            // is all we keep.
+            return item (value, depth + 1);
+        }
+
+        return false;
+    }
+
+    bool indefinite (std::uint8_t major, Value& value, int depth)
+    {
+        switch (major)
+        {
+        case majorBytes:
+        case majorText:
+        {
+            std::string s;
+            while (! atBreak ())
+            {
+                if (p_ == end_ || (*p_ >> 5) != major)
+                    return false;
+                std::uint64_t n;
+                if (! argument (*p_++ & 0x1f, n) || n > remaining ())
+                    return false;
+                if (major == majorBytes)
+                {
+                    appendHex (s, n);
+                }
+                else
+                {
+                    s.append (reinterpret_cast<char const*> (p_), n);
+                    p_ += n;
+                }
+            }
+            value = std::move (s);
+            return true;
+        }
+
+        case majorArray:
+            value = Value (arrayValue);
+            while (! atBreak ())
+            {
+                if (! item (value.append (Value ()), depth + 1))
+                    return false;
+            }
+            return true;
+
+        case majorMap:
+            value = Value (objectValue);
+            while (! atBreak ())
+            {
+                if (! member (value, depth + 1))
+                    return false;
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    bool member (Value& object, int depth)
+    {
+        Value key;
+        if (! item (key, depth) || ! key.isString ())
+            return false;
+        return item (object[key.asString ()], depth);
+    }
+
+    bool simple (std::uint8_t additional, Value& value)
+    {
+        switch (additional)
+        {
+        case simpleFalse:
+            value = false;
+            return true;
+
+        case simpleTrue:
+            value = true;
+            return true;
+
+        case simpleNull:
+        case simpleUndefined:
+            value = Value ();
+            return true;
+
+        case additionalHalf:
+        {
+            std::uint64_t bits;
+            if (! read (2, bits))
+                return false;
+            value = half (static_cast<std::uint16_t> (bits));
+            return true;
+        }
+
+        case additionalFloat:
+        {
+            std::uint64_t bits;
+            if (! read (4, bits))
+                return false;
+            std::uint32_t const b = static_cast<std::uint32_t> (bits);
+            float f;
+            std::memcpy (&f, &b, sizeof (f));
+            value = static_cast<double> (f);
+            return true;
+        }
+
+        case additionalDouble:
+        {
+            std::uint64_t bits;
+            if (! read (8, bits))
+                return false;
+            double d;
+            std::memcpy (&d, &bits, sizeof (d));
+            value = d;
+            return true;
+        }
+        }
+
+        return false;
+    }
+
+    // RFC 7049 Appendix D
+    static double half (std::uint16_t h)
+    {
+        int const exp = (h >> 10) & 0x1f;
+        int const mant = h & 0x3ff;
+        double val;
+
+        if (exp == 0)
+            val = std::ldexp (mant, -24);
+        else if (exp != 31)
+            val = std::ldexp (mant + 1024, exp - 25);
+        else
+            val = mant == 0 ? HUGE_VAL : NAN;
+
+        return (h & 0x8000) ? -val : val;
+    }
+
+    bool argument (std::uint8_t additional, std::uint64_t& n)
+    {
+        if (additional < 24)
+        {
+            n = additional;
+            return true;
+        }
+
+        switch (additional)
+        {
+        case 24: return read (1, n);
+        case 25: return read (2, n);
+        case 26: return read (4, n);
+        case 27: return read (8, n);
+        }
+
+        return false;
+    }
+
+    bool read (std::size_t size, std::uint64_t& n)
+    {
+        if (remaining () < size)
+            return false;
+
+        n = 0;
+        while (size--)
+            n = (n << 8) | *p_++;
+        return true;
+    }
+
+    bool atBreak ()
+    {
+        if (p_ != end_ && *p_ == breakCode)
+        {
+            ++p_;
+            return true;
+        }
+        return false;
+    }
+
+    std::uint64_t remaining () const
+    {
+        return static_cast<std::uint64_t> (end_ - p_);
+    }
+
+    void appendHex (std::string& s, std::uint64_t n)
+    {
+        static char const digits[] = "0123456789ABCDEF";
+
+        s.reserve (s.size () + 2 * n);
+        for (auto const end = p_ + n; p_ != end; ++p_)
+        {
+            s += digits[*p_ >> 4];
+            s += digits[*p_ & 0xf];
+        }
+    }
+
+    std::uint8_t const* p_;
+    std::uint8_t const* const end_;
+};
+
+} // namespace
+
+bool parseCbor (boost::string_ref const& data, Value& value)
+{
+    return CborReader (data).parse (value);
+}
+
+} // Json
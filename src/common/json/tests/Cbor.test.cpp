@@ -0,0 +1,439 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <common/json/Cbor.h>
+#include <common/json/json_reader.h>
+#include <common/json/json_value.h>
+#include <common/json/to_string.h>
+#include <beast/unit_test/suite.h>
+#include <chrono>
+#include <string>
+
+namespace Json {
+
+// Sample payloads, shaped like the RPC results and stream messages that are
+// sent in either format
+namespace {
+
+char const* const txJson = R"({
+    "Account" : "jHb9CJAWyB4jr91VRWn96DkukG4bwdtyTh",
+    "Amount" : {
+        "currency" : "USD",
+        "issuer" : "jPMh7Pi9ct699iZUTWaytJUoHcJ7cgyziK",
+        "value" : "1.5"
+    },
+    "Destination" : "jPMh7Pi9ct699iZUTWaytJUoHcJ7cgyziK",
+    "Fee" : "10000",
+    "Flags" : 2147483648,
+    "Memos" : [],
+    "Sequence" : 42,
+    "SigningPubKey" : "0330E7FC9D56BB25D6893BA3F317AE5BCF33B3291BD63DB32654A313222F7FD020",
+    "TransactionType" : "Payment",
+    "TxnSignature" : "3045022100D9F6F3B63A6F0B8D3E1E1A1C0E4A2C1D3F5B6A7C8D9E0F1A2B3C4D5E6F708192022047A1B2C3D4E5F60718293A4B5C6D7E8F90A1B2C3D4E5F60718293A4B5C6D7E8F",
+    "hash" : "A8B26C2F1D6F3E8B7C9D0E1F2A3B4C5D6E7F8091A2B3C4D5E6F708192A3B4C5D",
+    "inLedger" : 348860,
+    "ledger_index" : 348860,
+    "validated" : true
+})";
+
+char const* const accountTxJson = R"({
+    "account" : "jHb9CJAWyB4jr91VRWn96DkukG4bwdtyTh",
+    "ledger_index_max" : 348860,
+    "ledger_index_min" : -1,
+    "limit" : 2,
+    "marker" : { "ledger" : 348000, "seq" : 7 },
+    "transactions" : [
+        {
+            "meta" : {
+                "AffectedNodes" : [
+                    {
+                        "ModifiedNode" : {
+                            "FinalFields" : {
+                                "Balance" : "99999990000",
+                                "Flags" : 0,
+                                "OwnerCount" : 0,
+                                "Sequence" : 43
+                            },
+                            "LedgerEntryType" : "AccountRoot",
+                            "PreviousFields" : { "Balance" : "100000000000" }
+                        }
+                    }
+                ],
+                "TransactionIndex" : 0,
+                "TransactionResult" : "tesSUCCESS"
+            },
+            "tx" : { "Account" : "jHb9CJAWyB4jr91VRWn96DkukG4bwdtyTh",
+                "Fee" : "10000", "Sequence" : 42 },
+            "validated" : true
+        },
+        {
+            "meta" : null,
+            "tx" : { "Account" : "jHb9CJAWyB4jr91VRWn96DkukG4bwdtyTh",
+                "Fee" : "10000", "Sequence" : 41 },
+            "validated" : false
+        }
+    ]
+})";
+
+char const* const ledgerJson = R"({
+    "ledger" : {
+        "accepted" : true,
+        "account_hash" : "2C23D15B6B549123FB351E4B5CDE81C564318EB845449CD43C3EA7953C4DB452",
+        "close_time" : 486191880,
+        "close_time_human" : "2015-Jun-29 05:18:00",
+        "close_time_resolution" : 10,
+        "closed" : true,
+        "ledger_index" : "348860",
+        "parent_hash" : "E14A6B4E2F8D1C3B5A7F9E0D2C4B6A8F1E3D5C7B9A0F2E4D6C8B0A1F3E5D7C9B",
+        "seqNum" : "348860",
+        "totalCoins" : "99999999999999990000",
+        "total_coins" : "99999999999999990000",
+        "transactions" : [
+            "A8B26C2F1D6F3E8B7C9D0E1F2A3B4C5D6E7F8091A2B3C4D5E6F708192A3B4C5D",
+            "0F1E2D3C4B5A69788796A5B4C3D2E1F00F1E2D3C4B5A69788796A5B4C3D2E1F0"
+        ]
+    },
+    "ledger_hash" : "1F6B3C0F9B5C8A4D7E2F1A0B9C8D7E6F5A4B3C2D1E0F9A8B7C6D5E4F3A2B1C0D",
+    "ledger_index" : 348860,
+    "load_factor" : 1.25
+})";
+
+char const* const streamJson = R"({
+    "engine_result" : "tecUNFUNDED_PAYMENT",
+    "engine_result_code" : 104,
+    "engine_result_message" : "Insufficient SWT balance to send.",
+    "ledger_current_index" : 348861,
+    "status" : "proposed",
+    "transaction" : {
+        "Account" : "jHb9CJAWyB4jr91VRWn96DkukG4bwdtyTh",
+        "Amount" : "1000000000000",
+        "Destination" : "jPMh7Pi9ct699iZUTWaytJUoHcJ7cgyziK",
+        "Fee" : "10000",
+        "Sequence" : 44
+    },
+    "type" : "transaction",
+    "validated" : false
+})";
+
+Value
+parseJson (char const* text)
+{
+    Value value;
+    Reader ().parse (text, value);
+    return value;
+}
+
+std::string
+toBytes (std::initializer_list<int> bytes)
+{
+    std::string s;
+    for (int b : bytes)
+        s += static_cast<char> (b);
+    return s;
+}
+
+}
+
+class Cbor_test : public beast::unit_test::suite
+{
+public:
+    // Every prefix of a whole item is missing something, and so must fail
+    void
+    expectTruncationFails (std::string const& cbor, std::string const& what)
+    {
+        std::size_t failures = 0;
+
+        for (std::size_t i = 0; i < cbor.size (); ++i)
+        {
+            Value value;
+            if (! parseCbor (boost::string_ref (cbor.data (), i), value))
+                ++failures;
+        }
+
+        expect (failures == cbor.size (), what + ": truncated input accepted");
+    }
+
+    // Signed and unsigned integers come back as whichever type CBOR chose,
+    // so values are compared by how they are written out.
+    void
+    expectRoundTrip (Value const& value, std::string const& what)
+    {
+        std::string const cbor = cborAsString (value);
+
+        Value back;
+        expect (parseCbor (cbor, back), what + ": parse failed");
+        expect (to_string (back) == to_string (value),
+            what + ": " + to_string (back));
+
+        Value trailing;
+        expect (! parseCbor (cbor + '\0', trailing),
+            what + ": trailing byte accepted");
+
+        expectTruncationFails (cbor, what);
+    }
+
+    void
+    expectEncoding (std::string const& cbor,
+        std::initializer_list<int> bytes, std::string const& what)
+    {
+        expect (cbor == toBytes (bytes), what);
+    }
+
+    void
+    expectDecoding (std::initializer_list<int> bytes, Value const& expected,
+        std::string const& what)
+    {
+        Value value;
+        expect (parseCbor (toBytes (bytes), value), what + ": parse failed");
+        expect (to_string (value) == to_string (expected),
+            what + ": " + to_string (value));
+    }
+
+    void
+    expectMalformed (std::string const& cbor, std::string const& what)
+    {
+        Value value;
+        expect (! parseCbor (cbor, value), what);
+    }
+
+    void
+    testWriter ()
+    {
+        testcase ("writer");
+
+        // RFC 7049 Appendix A
+        expectEncoding (cborAsString (Value (0u)), { 0x00 }, "0");
+        expectEncoding (cborAsString (Value (23u)), { 0x17 }, "23");
+        expectEncoding (cborAsString (Value (24u)), { 0x18, 0x18 }, "24");
+        expectEncoding (cborAsString (Value (1000u)),
+            { 0x19, 0x03, 0xe8 }, "1000");
+        expectEncoding (cborAsString (Value (1000000u)),
+            { 0x1a, 0x00, 0x0f, 0x42, 0x40 }, "1000000");
+        expectEncoding (cborAsString (Value (-1)), { 0x20 }, "-1");
+        expectEncoding (cborAsString (Value (-1000)),
+            { 0x39, 0x03, 0xe7 }, "-1000");
+        expectEncoding (cborAsString (Value (1.1)),
+            { 0xfb, 0x3f, 0xf1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a }, "1.1");
+        expectEncoding (cborAsString (Value (false)), { 0xf4 }, "false");
+        expectEncoding (cborAsString (Value (true)), { 0xf5 }, "true");
+        expectEncoding (cborAsString (Value ()), { 0xf6 }, "null");
+        expectEncoding (cborAsString (Value ("IETF")),
+            { 0x64, 0x49, 0x45, 0x54, 0x46 }, "text");
+        expectEncoding (cborAsString (Value (arrayValue)), { 0x80 }, "[]");
+        expectEncoding (cborAsString (Value (objectValue)), { 0xa0 }, "{}");
+
+        std::string s;
+        CborWriter w (stringOutput (s));
+        w.unsignedInt (1000000000000ull);
+        w.bytes ("\x01\x02\x03\x04", 4);
+        expectEncoding (s, { 0x1b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x10,
+            0x00, 0x44, 0x01, 0x02, 0x03, 0x04 }, "64 bit and bytes");
+    }
+
+    void
+    testReader ()
+    {
+        testcase ("reader");
+
+        expectDecoding ({ 0x44, 0x01, 0x02, 0xab, 0xcd }, "0102ABCD", "bytes");
+        expectDecoding ({ 0x1b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x10,
+            0x00 }, "1000000000000", "64 bit unsigned");
+        expectDecoding ({ 0x3b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x0f,
+            0xff }, -1000000000000.0, "64 bit negative");
+        expectDecoding ({ 0xf9, 0x3c, 0x00 }, 1.0, "half");
+        expectDecoding ({ 0xf9, 0xc4, 0x00 }, -4.0, "negative half");
+        expectDecoding ({ 0xfa, 0x47, 0xc3, 0x50, 0x00 }, 100000.0, "float");
+        expectDecoding ({ 0xf7 }, Value (), "undefined");
+        expectDecoding ({ 0xc0, 0x61, 0x61 }, "a", "tagged");
+        expectDecoding ({ 0x7f, 0x62, 0x73, 0x74, 0x63, 0x72, 0x65, 0x61,
+            0xff }, "strea", "indefinite text");
+        expectDecoding ({ 0x5f, 0x42, 0x01, 0x02, 0x41, 0x03, 0xff },
+            "010203", "indefinite bytes");
+        expectDecoding ({ 0x9f, 0x01, 0x82, 0x02, 0x03, 0xff },
+            parseJson ("[1, [2, 3]]"), "indefinite array");
+        expectDecoding ({ 0xbf, 0x61, 0x61, 0x01, 0x61, 0x62, 0x9f, 0xff,
+            0xff }, parseJson (R"({"a" : 1, "b" : []})"), "indefinite map");
+    }
+
+    void
+    testPayloads ()
+    {
+        testcase ("payloads");
+
+        expectRoundTrip (parseJson (txJson), "tx");
+        expectRoundTrip (parseJson (accountTxJson), "account_tx");
+        expectRoundTrip (parseJson (ledgerJson), "ledger");
+        expectRoundTrip (parseJson (streamJson), "stream");
+
+        Value edges (objectValue);
+        edges["max"] = Value::maxUInt;
+        edges["min"] = Value::minInt;
+        edges["real"] = -0.125;
+        edges["empty"] = "";
+        edges["utf8"] = "\xe6\xb0\xb4 \xf0\x9f\x8c\x8a";
+        edges["nested"] = parseJson ("[[[{}]], {}, [null]]");
+        expectRoundTrip (edges, "edge values");
+
+        // Validated transactions are streamed with the serialized
+        // transaction and metadata as byte strings
+        std::string stream;
+        {
+            CborWriter w (stringOutput (stream));
+            w.startMap (4);
+            w.text ("type");
+            w.text ("transaction");
+            w.text ("transaction");
+            w.bytes ("\x12\x00\x00\x22", 4);
+            w.text ("engine_result_code");
+            w.signedInt (-99);
+            w.text ("validated");
+            w.boolean (true);
+        }
+
+        Value value;
+        expect (parseCbor (stream, value), "stream parse failed");
+        expect (value["transaction"] == "12000022", "stream transaction");
+        expect (value["engine_result_code"] == -99, "stream result");
+        expect (value["validated"] == true, "stream validated");
+        expectTruncationFails (stream, "binary stream");
+    }
+
+    void
+    testMalformed ()
+    {
+        testcase ("malformed");
+
+        expectMalformed ("", "empty");
+        expectMalformed (toBytes ({ 0x1c }), "reserved argument");
+        expectMalformed (toBytes ({ 0xf8, 0x20 }), "one byte simple value");
+        expectMalformed (toBytes ({ 0xff }), "stray break");
+        expectMalformed (toBytes ({ 0x1f }), "indefinite integer");
+        expectMalformed (toBytes ({ 0xa1, 0x01, 0x02 }), "integer key");
+        expectMalformed (toBytes ({ 0xa1, 0x61, 0x61 }), "key without value");
+        expectMalformed (toBytes ({ 0x7f, 0x41, 0x61, 0xff }),
+            "bytes in indefinite text");
+        expectMalformed (toBytes ({ 0x7f, 0x7f, 0xff, 0xff }),
+            "nested indefinite text");
+        expectMalformed (toBytes ({ 0x9f, 0x01 }), "indefinite array unended");
+        expectMalformed (toBytes ({ 0x5a, 0xff, 0xff, 0xff, 0xff, 0x00 }),
+            "bytes longer than input");
+        expectMalformed (toBytes ({ 0x7b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+            0xff, 0xff, 0x61 }), "text longer than input");
+        expectMalformed (toBytes ({ 0x9b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+            0xff, 0xff, 0x00 }), "array longer than input");
+        expectMalformed (toBytes ({ 0xf6, 0xf6 }), "two items");
+
+        // Items may nest 64 deep
+        std::string const deepest = std::string (64, '\x81') + '\x00';
+        Value value;
+        expect (parseCbor (deepest, value), "64 deep rejected");
+        expectMalformed (std::string (65, '\x81') + '\x00', "65 deep");
+        expectMalformed (std::string (100000, '\x9f'), "deep indefinite");
+        expectMalformed (std::string (100000, '\xc0') + '\x00', "deep tags");
+    }
+
+    void
+    run ()
+    {
+        testWriter ();
+        testReader ();
+        testPayloads ();
+        testMalformed ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(Cbor,json,truechain);
+
+//------------------------------------------------------------------------------
+
+// Compares the size and speed of each format on the sample payloads
+class CborSpeed_test : public beast::unit_test::suite
+{
+public:
+    typedef std::chrono::high_resolution_clock clock_type;
+
+    enum
+    {
+        iterations = 2000
+    };
+
+    template <class Function>
+    double
+    time (Function f)
+    {
+        auto const start = clock_type::now ();
+        for (int i = 0; i < iterations; ++i)
+            f ();
+        return std::chrono::duration <double> (
+            clock_type::now () - start).count ();
+    }
+
+    void
+    compare (std::string const& what, Value const& value)
+    {
+        std::string const json = to_string (value);
+        std::string const cbor = cborAsString (value);
+        std::size_t sink = 0;
+
+        double const jsonWrite = time ([&] {
+            sink += to_string (value).size (); });
+        double const cborWrite = time ([&] {
+            sink += cborAsString (value).size (); });
+        double const jsonRead = time ([&] {
+            Value v;
+            Reader ().parse (json, v);
+            sink += v.size (); });
+        double const cborRead = time ([&] {
+            Value v;
+            parseCbor (cbor, v);
+            sink += v.size (); });
+
+        log << what << ": " << json.size () << " bytes of JSON, " <<
+            cbor.size () << " bytes of CBOR";
+        log << "  write " << std::to_string (iterations) << ": JSON " <<
+            jsonWrite << "s, CBOR " << cborWrite << "s";
+        log << "  read " << std::to_string (iterations) << ": JSON " <<
+            jsonRead << "s, CBOR " << cborRead << "s";
+
+        expect (sink != 0);
+    }
+
+    void
+    run ()
+    {
+        compare ("tx", parseJson (txJson));
+        compare ("account_tx", parseJson (accountTxJson));
+        compare ("ledger", parseJson (ledgerJson));
+        compare ("stream", parseJson (streamJson));
+
+        // A full page of account_tx results
+        Value page = parseJson (accountTxJson);
+        Value const entry = page["transactions"][0u];
+        Value& transactions = page["transactions"];
+        transactions = Value (arrayValue);
+        for (int i = 0; i < 200; ++i)
+            transactions.append (entry);
+        compare ("account_tx, 200 transactions", page);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(CborSpeed,json,truechain);
+
+} // Json
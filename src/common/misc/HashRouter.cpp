@@ -18,8 +18,10 @@
 //==============================================================================
 
 #include <BeastConfig.h>
-#include <map>
+#include <algorithm>
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 #include <common/misc/IHashRouter.h>
 #include <common/base/CountedObject.h>
@@ -44,20 +46,23 @@ private:
         {
         }
 
-        std::set <PeerShortID> const& peekPeers () const
-        {
-            return mPeers;
-        }
-
         void addPeer (PeerShortID peer)
         {
-            if (peer != 0)
-                mPeers.insert (peer);
+            if (peer == 0)
+                return;
+
+            // Few peers relay any given hash, so a sorted vector is
+            // both smaller and faster than a node based set.
+            auto const it = std::lower_bound (
+                mPeers.begin (), mPeers.end (), peer);
+
+            if (it == mPeers.end () || *it != peer)
+                mPeers.insert (it, peer);
         }
 
         bool hasPeer (PeerShortID peer) const
         {
-            return mPeers.count (peer) > 0;
+            return std::binary_search (mPeers.begin (), mPeers.end (), peer);
         }
 
         int getFlags (void) const
@@ -82,18 +87,59 @@ private:
 
         void swapSet (std::set <PeerShortID>& other)
         {
-            mPeers.swap (other);
+            std::vector <PeerShortID> peers (other.begin (), other.end ());
+            other.clear ();
+            other.insert (mPeers.begin (), mPeers.end ());
+            mPeers.swap (peers);
         }
 
     private:
         int mFlags;
-        std::set <PeerShortID> mPeers;
+        std::vector <PeerShortID> mPeers;
+    };
+
+    using LockType = std::mutex;
+    using ScopedLockType = std::lock_guard <LockType>;
+
+    /** A slice of the routing table with its own lock.
+
+        Hashes are spread over the shards so that peers relaying
+        unrelated objects rarely contend. Each shard expires its
+        entries from a ring of one-second buckets.
+    */
+    struct Shard
+    {
+        LockType mLock;
+
+        hash_map <uint256, Entry> mSuppressionMap;
+
+        // Hashes created in each second, indexed by second modulo holdTime
+        std::vector <std::vector <uint256>> mBuckets;
+
+        // The most recent second whose bucket we started to fill
+        int mLastSecond;
+    };
+
+    enum
+    {
+        // Number of independently locked slices of the table
+        shardCount = 16
     };
 
 public:
     explicit HashRouter (int holdTime)
-        : mHoldTime (holdTime)
+        : mHoldTime (std::max (holdTime, 1))
+        , mLookups (0)
+        , mHits (0)
+        , mStatsSecond (UptimeTimer::getInstance ().getElapsedSeconds ())
+        , mLastLookups (0)
+        , mLastHits (0)
     {
+        for (auto& shard : mShards)
+        {
+            shard.mBuckets.resize (mHoldTime);
+            shard.mLastSecond = mStatsSecond;
+        }
     }
 
     bool addSuppression (uint256 const& index);
@@ -106,87 +152,132 @@ public:
 
     bool swapSet (uint256 const& index, std::set<PeerShortID>& peers, int flag);
 
+    Stats getStats ();
+
 private:
-    Entry getEntry (uint256 const& );
+    Shard& getShard (uint256 const& index)
+    {
+        // The index is a hash, so any of its bytes will do
+        return mShards[*index.begin () % shardCount];
+    }
 
-    Entry& findCreateEntry (uint256 const& , bool& created);
+    Entry& findCreateEntry (Shard& shard, uint256 const& index, bool& created);
 
-    using LockType = std::mutex;
-    using ScopedLockType = std::lock_guard <LockType>;
-    LockType mLock;
+    void expire (Shard& shard, int now);
+
+    void rollStats (int now);
 
-    // Stores all suppressed hashes and their expiration time
-    hash_map <uint256, Entry> mSuppressionMap;
+    void countLookup (int now, bool hit);
 
-    // Stores all expiration times and the hashes indexed for them
-    std::map< int, std::list<uint256> > mSuppressionTimes;
+    Shard mShards[shardCount];
 
-    int mHoldTime;
+    int const mHoldTime;
+
+    // Lookups and hits so far in the current second
+    std::atomic <std::uint32_t> mLookups;
+    std::atomic <std::uint32_t> mHits;
+    std::atomic <int> mStatsSecond;
+
+    // Lookups and hits during the last full second
+    std::atomic <std::uint32_t> mLastLookups;
+    std::atomic <std::uint32_t> mLastHits;
 };
 
 //------------------------------------------------------------------------------
 
-HashRouter::Entry& HashRouter::findCreateEntry (uint256 const& index, bool& created)
+void HashRouter::expire (Shard& shard, int now)
 {
-    hash_map<uint256, Entry>::iterator fit = mSuppressionMap.find (index);
+    // Empty the bucket of every second we have moved past. Each bucket is
+    // reused holdTime seconds after it was filled, expiring its hashes.
+    int const steps = std::min (now - shard.mLastSecond, mHoldTime);
 
-    if (fit != mSuppressionMap.end ())
+    for (int i = 1; i <= steps; ++i)
     {
-        created = false;
-        return fit->second;
-    }
+        auto& bucket = shard.mBuckets[(shard.mLastSecond + i) % mHoldTime];
+
+        for (auto const& index : bucket)
+            shard.mSuppressionMap.erase (index);
 
-    created = true;
+        bucket.clear ();
+    }
 
-    int now = UptimeTimer::getInstance ().getElapsedSeconds ();
-    int expireTime = now - mHoldTime;
+    shard.mLastSecond = now;
+}
 
-    // See if any supressions need to be expired
-    std::map< int, std::list<uint256> >::iterator it = mSuppressionTimes.begin ();
+void HashRouter::rollStats (int now)
+{
+    int second = mStatsSecond.load ();
 
-    if ((it != mSuppressionTimes.end ()) && (it->first <= expireTime))
+    if ((now != second) && mStatsSecond.compare_exchange_strong (second, now))
     {
-        for(auto const& lit : it->second)
-            mSuppressionMap.erase (lit);
-        mSuppressionTimes.erase (it);
+        // Counts are only kept if they cover the second that just ended
+        std::uint32_t const lookups = mLookups.exchange (0);
+        std::uint32_t const hits = mHits.exchange (0);
+        bool const recent = (now - second) == 1;
+
+        mLastLookups = recent ? lookups : 0;
+        mLastHits = recent ? hits : 0;
     }
+}
 
-    mSuppressionTimes[now].push_back (index);
-    return mSuppressionMap.emplace (index, Entry ()).first->second;
+void HashRouter::countLookup (int now, bool hit)
+{
+    rollStats (now);
+
+    ++mLookups;
+
+    if (hit)
+        ++mHits;
 }
 
-bool HashRouter::addSuppression (uint256 const& index)
+HashRouter::Entry& HashRouter::findCreateEntry (
+    Shard& shard, uint256 const& index, bool& created)
 {
-    ScopedLockType sl (mLock);
+    int const now = UptimeTimer::getInstance ().getElapsedSeconds ();
 
-    bool created;
-    findCreateEntry (index, created);
-    return created;
+    auto fit = shard.mSuppressionMap.find (index);
+
+    created = (fit == shard.mSuppressionMap.end ());
+
+    countLookup (now, !created);
+
+    if (!created)
+        return fit->second;
+
+    if (now != shard.mLastSecond)
+        expire (shard, now);
+
+    shard.mBuckets[now % mHoldTime].push_back (index);
+    return shard.mSuppressionMap.emplace (index, Entry ()).first->second;
 }
 
-HashRouter::Entry HashRouter::getEntry (uint256 const& index)
+bool HashRouter::addSuppression (uint256 const& index)
 {
-    ScopedLockType sl (mLock);
+    Shard& shard = getShard (index);
+    ScopedLockType sl (shard.mLock);
 
     bool created;
-    return findCreateEntry (index, created);
+    findCreateEntry (shard, index, created);
+    return created;
 }
 
 bool HashRouter::addSuppressionPeer (uint256 const& index, PeerShortID peer)
 {
-    ScopedLockType sl (mLock);
+    Shard& shard = getShard (index);
+    ScopedLockType sl (shard.mLock);
 
     bool created;
-    findCreateEntry (index, created).addPeer (peer);
+    findCreateEntry (shard, index, created).addPeer (peer);
     return created;
 }
 
 bool HashRouter::addSuppressionPeer (uint256 const& index, PeerShortID peer, int& flags)
 {
-    ScopedLockType sl (mLock);
+    Shard& shard = getShard (index);
+    ScopedLockType sl (shard.mLock);
 
     bool created;
-    Entry& s = findCreateEntry (index, created);
+    Entry& s = findCreateEntry (shard, index, created);
     s.addPeer (peer);
     flags = s.getFlags ();
     return created;
@@ -194,18 +285,20 @@ bool HashRouter::addSuppressionPeer (uint256 const& index, PeerShortID peer, int
 
 int HashRouter::getFlags (uint256 const& index)
 {
-    ScopedLockType sl (mLock);
+    Shard& shard = getShard (index);
+    ScopedLockType sl (shard.mLock);
 
     bool created;
-    return findCreateEntry (index, created).getFlags ();
+    return findCreateEntry (shard, index, created).getFlags ();
 }
 
 bool HashRouter::addSuppressionFlags (uint256 const& index, int flag)
 {
-    ScopedLockType sl (mLock);
+    Shard& shard = getShard (index);
+    ScopedLockType sl (shard.mLock);
 
     bool created;
-    findCreateEntry (index, created).setFlag (flag);
+    findCreateEntry (shard, index, created).setFlag (flag);
     return created;
 }
 
@@ -218,10 +311,11 @@ bool HashRouter::setFlag (uint256 const& index, int flag)
     // return: true = changed, false = unchanged
     assert (flag != 0);
 
-    ScopedLockType sl (mLock);
+    Shard& shard = getShard (index);
+    ScopedLockType sl (shard.mLock);
 
     bool created;
-    Entry& s = findCreateEntry (index, created);
+    Entry& s = findCreateEntry (shard, index, created);
 
     if ((s.getFlags () & flag) == flag)
         return false;
@@ -232,10 +326,11 @@ bool HashRouter::setFlag (uint256 const& index, int flag)
 
 bool HashRouter::swapSet (uint256 const& index, std::set<PeerShortID>& peers, int flag)
 {
-    ScopedLockType sl (mLock);
+    Shard& shard = getShard (index);
+    ScopedLockType sl (shard.mLock);
 
     bool created;
-    Entry& s = findCreateEntry (index, created);
+    Entry& s = findCreateEntry (shard, index, created);
 
     if ((s.getFlags () & flag) == flag)
         return false;
@@ -246,6 +341,25 @@ bool HashRouter::swapSet (uint256 const& index, std::set<PeerShortID>& peers, in
     return true;
 }
 
+IHashRouter::Stats HashRouter::getStats ()
+{
+    Stats ret;
+
+    ret.size = 0;
+    for (auto& shard : mShards)
+    {
+        ScopedLockType sl (shard.mLock);
+        ret.size += shard.mSuppressionMap.size ();
+    }
+
+    // Roll the counters over if no lookup has done so this second
+    rollStats (UptimeTimer::getInstance ().getElapsedSeconds ());
+
+    ret.lookupsPerSecond = mLastLookups;
+    ret.hitsPerSecond = mLastHits;
+    return ret;
+}
+
 IHashRouter* IHashRouter::New (int holdTime)
 {
     return new HashRouter (holdTime);
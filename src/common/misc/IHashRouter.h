@@ -20,6 +20,7 @@
 #ifndef SKYWELL_APP_MISC_IHASHROUTER_H_INCLUDED
 #define SKYWELL_APP_MISC_IHASHROUTER_H_INCLUDED
 
+#include <cstddef>
 #include <cstdint>
 #include <set>
 #include <common/base/base_uint.h>
@@ -81,6 +82,18 @@ public:
 
     virtual bool swapSet (uint256 const& index, std::set<PeerShortID>& peers, int flag) = 0;
 
+    struct Stats
+    {
+        // Number of hashes currently held
+        std::size_t size;
+
+        // Lookups, and lookups finding a known hash, during the last second
+        std::uint32_t lookupsPerSecond;
+        std::uint32_t hitsPerSecond;
+    };
+
+    virtual Stats getStats () = 0;
+
     //  TODO This appears to be unused!
     //
 //    virtual Entry getEntry (uint256 const&) = 0;
@@ -23,6 +23,7 @@
 #include <beast/cxx14/memory.h> // <memory>
 #include <beast/utility/make_lock.h>
 #include <boost/optional.hpp>
+#include <deque>
 #include <tuple>
 
 
@@ -38,6 +39,7 @@
 #include <ledger/OrderBookDB.h>
 #include <main/LoadManager.h>
 #include <main/LocalCredentials.h>
+#include <transaction/book/BookIndex.h>
 #include <transaction/book/Quality.h>
 #include <common/misc/IHashRouter.h>
 #include <common/misc/NetworkOPs.h>
@@ -50,6 +52,7 @@
 #include <common/base/UptimeTimer.h>
 #include <common/core/Config.h>
 #include <common/core/LoadFeeTrack.h>
+#include <common/json/Cbor.h>
 #include <common/json/to_string.h>
 #include <network/resource/Fees.h>
 #include <network/resource/Gossip.h>
@@ -81,6 +84,13 @@ public:
         IO_ERROR    = 1,
         NO_NETWORK  = 2,
     };
+
+    enum
+    {
+        // Proposed transactions held for slow subscribers before
+        // the oldest are dropped
+        maxProposedQueue = 4096
+    };
     // missing node handler
     std::uint32_t maxSeq = 0;
     std::mutex maxSeqLock;
@@ -415,6 +425,17 @@ public:
         return m_localTX->size ();
     }
 
+    PublishStats getProposedPublishStats () override
+    {
+        std::lock_guard <std::mutex> sl (mProposedLock);
+
+        PublishStats stats;
+        stats.queued = mProposed.size ();
+        stats.published = mProposedPublished;
+        stats.dropped = mProposedDropped;
+        return stats;
+    }
+
     //Helper function to generate SQL query to get transactions
     std::string transactionsSQL (
         std::string selection, SkywellAddress const& account,
@@ -521,25 +542,54 @@ private:
     Json::Value transJson (
 		const STTx& stTxn, TER terResult, bool bValidated,
         Ledger::ref lpCurrent);
+    std::string transCbor (
+        Ledger::ref lpCurrent, const AcceptedLedgerTx& alTx);
     bool haveConsensusObject ();
 
     Json::Value pubBootstrapAccountInfo (
         Ledger::ref lpAccepted, SkywellAddress const& naAccountID);
 
+    class PubMessage;
+    typedef std::vector <InfoSub::pointer> Listeners;
+
+    static void collectListeners (SubMapType& subs, Listeners& listeners);
+
+    // Publishing can't erase account listeners that went away, so they
+    // are dropped whenever an account's set is copied
+    static void dropExpired (SubMapType& subs);
+
     void pubValidatedTransaction (
-        Ledger::ref alAccepted, const AcceptedLedgerTx& alTransaction);
+        Ledger::ref alAccepted, const AcceptedLedgerTx& alTransaction,
+        Listeners const& listeners);
     void pubAccountTransaction (
         Ledger::ref lpCurrent, const AcceptedLedgerTx& alTransaction,
-        bool isAccepted);
+        PubMessage const& message, bool isAccepted);
+
+    void pubProposed (Ledger::ref lpCurrent, STTx::ref stTxn, TER terResult);
+    void pubProposedJob ();
 
     void pubServer ();
 
     std::string getHostId (bool forAdmin);
 
 private:
+    // Add one offer to a book page and charge what it pays out to the
+    // owner's running balance
+    void addBookOffer (Book const& book, Account const& uTakerID,
+        std::uint32_t uTransferRate, SLE const& sleOffer,
+        STAmount const& saDirRate, STAmount const& saOwnerFunds,
+        bool firstOwnerOffer, std::map<Account, STAmount>& umBalance,
+        Json::Value& jvOffers);
+
     clock_type& m_clock;
 
-    typedef hash_map <Account, SubMapType> SubInfoMapType;
+    // Account subscriptions are published to without taking mSubLock.
+    // Changes, made under mSubLock, build a new map and swap it in; the
+    // listener set of each account is shared between versions and copied
+    // only when that account's subscriptions change.
+    typedef std::shared_ptr <SubMapType const> AccountListeners;
+    typedef hash_map <Account, AccountListeners> SubInfoMapType;
+    typedef std::shared_ptr <SubInfoMapType const> SubInfoMapPtr;
     typedef hash_map<std::string, InfoSub::pointer> subRpcMapType;
 
     // XXX Split into more locks.
@@ -589,8 +639,8 @@ private:
     // Recent positions taken
     std::map<uint256, std::pair<int, std::shared_ptr<SHAMap>>> mRecentPositions;
 
-    SubInfoMapType mSubAccount;
-    SubInfoMapType mSubRTAccount;
+    SubInfoMapPtr mSubAccount = std::make_shared <SubInfoMapType const> ();
+    SubInfoMapPtr mSubRTAccount = std::make_shared <SubInfoMapType const> ();
 
     subRpcMapType mRpcSubMap;
 
@@ -599,6 +649,23 @@ private:
     SubMapType mSubTransactions;       // all accepted transactions
     SubMapType mSubRTTransactions;     // all proposed and accepted transactions
 
+    // The offers of the books asked for in the newest closed ledger
+    core::BookIndex mBookIndex;
+
+    // A transaction applied to the open ledger, waiting to be published
+    struct ProposedTx
+    {
+        Ledger::pointer ledger;
+        STTx::pointer txn;
+        TER result;
+    };
+
+    std::mutex mProposedLock;
+    std::deque <ProposedTx> mProposed;
+    bool mProposedJob = false;          // a publishing job is queued or running
+    std::uint64_t mProposedPublished = 0;
+    std::uint64_t mProposedDropped = 0;
+
     TaggedCache<uint256, Blob>  mFetchPack;
     std::uint32_t mFetchSeq;
 
@@ -614,6 +681,57 @@ private:
     std::size_t const m_network_quorum;
 };
 
+//------------------------------------------------------------------------------
+
+/** A stream message rendered once and handed unchanged to every listener.
+
+    JSON listeners share the text; binary listeners share an encoding made
+    on first use.
+*/
+class NetworkOPsImp::PubMessage
+{
+public:
+    using Encoder = std::function <std::string (Json::Value const&)>;
+
+    explicit PubMessage (Json::Value&& json, Encoder binary = nullptr)
+        : json_ (std::move (json))
+        , text_ (to_string (json_))
+        , makeBinary_ (std::move (binary))
+    {
+    }
+
+    PubMessage (PubMessage const&) = delete;
+    PubMessage& operator= (PubMessage const&) = delete;
+
+    Json::Value const& getJson () const
+    {
+        return json_;
+    }
+
+    void send (InfoSub& listener) const
+    {
+        auto const format = listener.getWireFormat ();
+
+        if (format == RPC::WireFormat::json)
+        {
+            listener.send (json_, text_, true);
+            return;
+        }
+
+        if (binary_.empty ())
+            binary_ = makeBinary_ ? makeBinary_ (json_)
+                : RPC::encodeResponse (json_, format);
+
+        listener.sendEncoded (binary_, true);
+    }
+
+private:
+    Json::Value const json_;
+    std::string const text_;
+    Encoder makeBinary_;
+    mutable std::string binary_;
+};
+
 //------------------------------------------------------------------------------
 std::string
 NetworkOPsImp::getHostId (bool forAdmin)
@@ -1119,9 +1237,7 @@ Transaction::pointer NetworkOPsImp::processTransactionCb (
                 tx.set_status (protocol::tsCURRENT);
                 tx.set_receivetimestamp (getNetworkTimeNC ());
                 // FIXME: This should be when we received it
-                getApp ().overlay ().foreach (send_if_not (
-                    std::make_shared<Message> (tx, protocol::mtTRANSACTION),
-                    peer_in_set(peers)));
+                getApp ().overlay ().relay (tx, std::move (peers));
             }
         }
     }
@@ -1993,8 +2109,14 @@ NetworkOPsImp::getTxsAccount (
         convertBlobsToTxResult (ret, ledger_index, status, rawTxn, rawMeta);
     };
 
-    accountTxPage(getApp().getTxnDB (), saveLedgerAsync, bound, account,
-        minLedger, maxLedger, forward, token, limit, bAdmin, page_length);
+    auto const index = getApp().getAccountTxIndex ();
+
+    if (index && index->covers (minLedger, maxLedger))
+        accountTxIndexPage(*index, getApp().getTxnDB (), bound, account,
+            minLedger, maxLedger, forward, token, limit, bAdmin, page_length);
+    else
+        accountTxPage(getApp().getTxnDB (), saveLedgerAsync, bound, account,
+            minLedger, maxLedger, forward, token, limit, bAdmin, page_length);
 
     return ret;
 }
@@ -2018,8 +2140,14 @@ NetworkOPsImp::getTxsAccountB (
         ret.emplace_back (strHex(rawTxn), strHex (rawMeta), ledgerIndex);
     };
 
-    accountTxPage(getApp().getTxnDB (), saveLedgerAsync, bound, account,
-        minLedger, maxLedger, forward, token, limit, bAdmin, page_length);
+    auto const index = getApp().getAccountTxIndex ();
+
+    if (index && index->covers (minLedger, maxLedger))
+        accountTxIndexPage(*index, getApp().getTxnDB (), bound, account,
+            minLedger, maxLedger, forward, token, limit, bAdmin, page_length);
+    else
+        accountTxPage(getApp().getTxnDB (), saveLedgerAsync, bound, account,
+            minLedger, maxLedger, forward, token, limit, bAdmin, page_length);
     return ret;
 }
 
@@ -2288,30 +2416,110 @@ Json::Value NetworkOPsImp::pubBootstrapAccountInfo (
 void NetworkOPsImp::pubProposedTransaction (
     Ledger::ref lpCurrent, STTx::ref stTxn, TER terResult)
 {
-    Json::Value jvObj   = transJson (*stTxn, terResult, false, lpCurrent);
-
+    // Publishing builds JSON and walks the subscriber maps. Keep that off
+    // the thread applying transactions to the open ledger.
     {
         ScopedLockType sl (mSubLock);
 
-        auto it = mSubRTTransactions.begin ();
-        while (it != mSubRTTransactions.end ())
+        if (mSubRTTransactions.empty () &&
+                std::atomic_load (&mSubRTAccount)->empty ())
+            return;
+    }
+
+    std::lock_guard <std::mutex> sl (mProposedLock);
+
+    if (mProposed.size () >= maxProposedQueue)
+    {
+        // Subscribers are not keeping up, shed the oldest
+        mProposed.pop_front ();
+
+        if ((mProposedDropped++ % maxProposedQueue) == 0)
+            m_journal.warning << "Proposed transaction publishing is behind, "
+                << mProposedDropped << " dropped";
+    }
+
+    mProposed.push_back ({lpCurrent, stTxn, terResult});
+
+    if (!mProposedJob)
+    {
+        mProposedJob = true;
+        m_job_queue.addJob (jtPUBPROPOSED, "pubProposed",
+            std::bind (&NetworkOPsImp::pubProposedJob, this));
+    }
+}
+
+void NetworkOPsImp::pubProposedJob ()
+{
+    for (;;)
+    {
+        ProposedTx tx;
+
         {
-            InfoSub::pointer p = it->second.lock ();
+            std::lock_guard <std::mutex> sl (mProposedLock);
 
-            if (p)
+            if (mProposed.empty ())
             {
-                p->send (jvObj, true);
-                ++it;
-            }
-            else
-            {
-                it = mSubRTTransactions.erase (it);
+                mProposedJob = false;
+                return;
             }
+
+            tx = std::move (mProposed.front ());
+            mProposed.pop_front ();
+            ++mProposedPublished;
         }
+
+        pubProposed (tx.ledger, tx.txn, tx.result);
     }
+}
+
+void NetworkOPsImp::pubProposed (
+    Ledger::ref lpCurrent, STTx::ref stTxn, TER terResult)
+{
+    PubMessage const message (
+        transJson (*stTxn, terResult, false, lpCurrent));
+
+    Listeners listeners;
+    {
+        ScopedLockType sl (mSubLock);
+        collectListeners (mSubRTTransactions, listeners);
+    }
+
+    for (auto const& p : listeners)
+        message.send (*p);
+
     AcceptedLedgerTx alt (lpCurrent, stTxn, terResult);
     m_journal.trace << "pubProposed: " << alt.getJson ();
-    pubAccountTransaction (lpCurrent, alt, false);
+    pubAccountTransaction (lpCurrent, alt, message, false);
+}
+
+void NetworkOPsImp::collectListeners (
+    SubMapType& subs, Listeners& listeners)
+{
+    auto it = subs.begin ();
+    while (it != subs.end ())
+    {
+        if (auto p = it->second.lock ())
+        {
+            listeners.push_back (std::move (p));
+            ++it;
+        }
+        else
+        {
+            it = subs.erase (it);
+        }
+    }
+}
+
+void NetworkOPsImp::dropExpired (SubMapType& subs)
+{
+    auto it = subs.begin ();
+    while (it != subs.end ())
+    {
+        if (it->second.expired ())
+            it = subs.erase (it);
+        else
+            ++it;
+    }
 }
 
 void NetworkOPsImp::pubLedger (Ledger::ref accepted)
@@ -2322,53 +2530,71 @@ void NetworkOPsImp::pubLedger (Ledger::ref accepted)
     auto alpAccepted = AcceptedLedger::makeAcceptedLedger (accepted);
     Ledger::ref lpAccepted = alpAccepted->getLedger ();
 
+    // The listeners are gathered once for the whole ledger, and nothing is
+    // sent while mSubLock is held.
+    Listeners ledgerListeners;
+    Listeners txnListeners;
     {
         ScopedLockType sl (mSubLock);
 
-        if (!mSubLedger.empty ())
-        {
-            Json::Value jvObj (Json::objectValue);
+        collectListeners (mSubLedger, ledgerListeners);
+        collectListeners (mSubTransactions, txnListeners);
+        collectListeners (mSubRTTransactions, txnListeners);
+    }
+
+    if (!ledgerListeners.empty ())
+    {
+        Json::Value jvObj (Json::objectValue);
 
-            jvObj[jss::type] = "ledgerClosed";
-            jvObj[jss::ledger_index] = lpAccepted->getLedgerSeq ();
-            jvObj[jss::ledger_hash] = to_string (lpAccepted->getHash ());
-            jvObj[jss::ledger_time]
-                    = Json::Value::UInt (lpAccepted->getCloseTimeNC ());
+        jvObj[jss::type] = "ledgerClosed";
+        jvObj[jss::ledger_index] = lpAccepted->getLedgerSeq ();
+        jvObj[jss::ledger_hash] = to_string (lpAccepted->getHash ());
+        jvObj[jss::ledger_time]
+                = Json::Value::UInt (lpAccepted->getCloseTimeNC ());
 
-            jvObj[jss::fee_ref]
-                    = Json::UInt (lpAccepted->getReferenceFeeUnits ());
-            jvObj[jss::fee_base] = Json::UInt (lpAccepted->getBaseFee ());
-            jvObj[jss::reserve_base] = Json::UInt (lpAccepted->getReserve (0));
-            jvObj[jss::reserve_inc] = Json::UInt (lpAccepted->getReserveInc ());
+        jvObj[jss::fee_ref]
+                = Json::UInt (lpAccepted->getReferenceFeeUnits ());
+        jvObj[jss::fee_base] = Json::UInt (lpAccepted->getBaseFee ());
+        jvObj[jss::reserve_base] = Json::UInt (lpAccepted->getReserve (0));
+        jvObj[jss::reserve_inc] = Json::UInt (lpAccepted->getReserveInc ());
 
-            jvObj[jss::txn_count] = Json::UInt (alpAccepted->getTxnCount ());
+        jvObj[jss::txn_count] = Json::UInt (alpAccepted->getTxnCount ());
 
-            if (mMode >= omSYNCING)
-            {
-                jvObj[jss::validated_ledgers]
-                        = getApp().getLedgerMaster ().getCompleteLedgers ();
-            }
+        if (mMode >= omSYNCING)
+        {
+            jvObj[jss::validated_ledgers]
+                    = getApp().getLedgerMaster ().getCompleteLedgers ();
+        }
+
+        // Binary listeners also get the serialized header.
+        auto binary = [&lpAccepted] (Json::Value const& jvObj)
+        {
+            Serializer header;
+            lpAccepted->addRaw (header);
 
-            auto it = mSubLedger.begin ();
-            while (it != mSubLedger.end ())
+            std::string s;
+            Json::CborWriter w (Json::stringOutput (s));
+            w.startMap (jvObj.size () + 1);
+            for (auto field = jvObj.begin (); field != jvObj.end (); ++field)
             {
-                InfoSub::pointer p = it->second.lock ();
-                if (p)
-                {
-                    p->send (jvObj, true);
-                    ++it;
-                }
-                else
-                    it = mSubLedger.erase (it);
+                w.text (field.memberName ());
+                w.value (*field);
             }
-        }
+            w.text (jss::ledger_data.c_str ());
+            w.bytes (header.getDataPtr (), header.getDataLength ());
+            return s;
+        };
+
+        PubMessage const message (std::move (jvObj), binary);
+
+        for (auto const& p : ledgerListeners)
+            message.send (*p);
     }
 
-    // Don't lock since pubAcceptedTransaction is locking.
     for (auto const& vt : alpAccepted->getMap ())
     {
         m_journal.trace << "pubAccepted: " << vt.second->getJson ();
-        pubValidatedTransaction (lpAccepted, *vt.second);
+        pubValidatedTransaction (lpAccepted, *vt.second, txnListeners);
     }
 }
 
@@ -2437,132 +2663,125 @@ Json::Value NetworkOPsImp::transJson(
     return jvObj;
 }
 
+// The binary form of a validated transaction for the transactions streams.
+// The transaction and its metadata are sent in their canonical serialization
+// instead of being rendered as JSON.
+std::string NetworkOPsImp::transCbor (
+    Ledger::ref lpCurrent, const AcceptedLedgerTx& alTx)
+{
+    std::string sToken;
+    std::string sHuman;
+
+    transResultInfo (alTx.getResult (), sToken, sHuman);
+
+    auto const sTxn = alTx.getTxn ()->getSerializer ();
+    auto const& meta = alTx.getRawMeta ();
+
+    std::string s;
+    Json::CborWriter w (Json::stringOutput (s));
+
+    w.startMap (12);
+    w.text (jss::type.c_str ());
+    w.text ("transaction");
+    w.text (jss::transaction.c_str ());
+    w.bytes (sTxn.getDataPtr (), sTxn.getDataLength ());
+    w.text (jss::meta.c_str ());
+    w.bytes (meta.data (), meta.size ());
+    w.text (jss::hash.c_str ());
+    w.text (to_string (alTx.getTransactionID ()));
+    w.text (jss::ledger_index.c_str ());
+    w.unsignedInt (lpCurrent->getLedgerSeq ());
+    w.text (jss::ledger_hash.c_str ());
+    w.text (to_string (lpCurrent->getHash ()));
+    w.text (jss::date.c_str ());
+    w.unsignedInt (lpCurrent->getCloseTimeNC ());
+    w.text (jss::validated.c_str ());
+    w.boolean (true);
+    w.text (jss::status.c_str ());
+    w.text ("closed");
+    w.text (jss::engine_result.c_str ());
+    w.text (sToken);
+    w.text (jss::engine_result_code.c_str ());
+    w.signedInt (alTx.getResult ());
+    w.text (jss::engine_result_message.c_str ());
+    w.text (sHuman);
+
+    return s;
+}
+
 void NetworkOPsImp::pubValidatedTransaction (
-    Ledger::ref alAccepted, const AcceptedLedgerTx& alTx)
+    Ledger::ref alAccepted, const AcceptedLedgerTx& alTx,
+    Listeners const& listeners)
 {
+    // Rendered once for the transaction streams, the account streams and
+    // the order books.
     Json::Value jvObj = transJson (
         *alTx.getTxn (), alTx.getResult (), true, alAccepted);
     jvObj[jss::meta] = alTx.getMeta ()->getJson (0);
 
-    std::string sObj = to_string (jvObj);
+    PubMessage const message (std::move (jvObj),
+        [&] (Json::Value const&) { return transCbor (alAccepted, alTx); });
 
-    {
-        ScopedLockType sl (mSubLock);
+    for (auto const& p : listeners)
+        message.send (*p);
 
-        auto it = mSubTransactions.begin ();
-        while (it != mSubTransactions.end ())
-        {
-            InfoSub::pointer p = it->second.lock ();
+    getApp().getOrderBookDB ().processTxn (
+        alAccepted, alTx, message.getJson ());
+    pubAccountTransaction (alAccepted, alTx, message, true);
+}
 
-            if (p)
-            {
-                p->send (jvObj, sObj, true);
-                ++it;
-            }
-            else
-                it = mSubTransactions.erase (it);
-        }
+void NetworkOPsImp::pubAccountTransaction (
+    Ledger::ref lpCurrent, const AcceptedLedgerTx& alTx,
+    PubMessage const& message, bool bAccepted)
+{
+    auto const rtAccounts = std::atomic_load (&mSubRTAccount);
 
-        it = mSubRTTransactions.begin ();
+    if (!bAccepted && rtAccounts->empty ())
+        return;
 
-        while (it != mSubRTTransactions.end ())
-        {
-            InfoSub::pointer p = it->second.lock ();
+    auto const accounts = std::atomic_load (&mSubAccount);
 
-            if (p)
-            {
-                p->send (jvObj, sObj, true);
-                ++it;
-            }
-            else
-                it = mSubRTTransactions.erase (it);
-        }
-    }
-    getApp().getOrderBookDB ().processTxn (alAccepted, alTx, jvObj);
-    pubAccountTransaction (alAccepted, alTx, true);
-}
+    if (accounts->empty () && rtAccounts->empty ())
+        return;
 
-void NetworkOPsImp::pubAccountTransaction (
-    Ledger::ref lpCurrent, const AcceptedLedgerTx& alTx, bool bAccepted)
-{
     hash_set<InfoSub::pointer>  notify;
     int                             iProposed   = 0;
     int                             iAccepted   = 0;
 
+    auto add = [&notify] (SubInfoMapType const& subMap,
+        Account const& account, int& count)
     {
-        ScopedLockType sl (mSubLock);
-
-        if (!bAccepted && mSubRTAccount.empty ()) return;
+        auto simiIt = subMap.find (account);
+        if (simiIt == subMap.end ())
+            return;
 
-        if (!mSubAccount.empty () || (!mSubRTAccount.empty ()) )
+        for (auto const& listener : *simiIt->second)
         {
-            for (auto const& affectedAccount: alTx.getAffected ())
+            // Listeners that went away are removed when they unsubscribe
+            if (auto p = listener.second.lock ())
             {
-                auto simiIt
-                        = mSubRTAccount.find (affectedAccount.getAccountID ());
-                if (simiIt != mSubRTAccount.end ())
-                {
-                    auto it = simiIt->second.begin ();
-
-                    while (it != simiIt->second.end ())
-                    {
-                        InfoSub::pointer p = it->second.lock ();
+                notify.insert (std::move (p));
+                ++count;
+            }
+        }
+    };
 
-                        if (p)
-                        {
-                            notify.insert (p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase (it);
-                    }
-                }
+    for (auto const& affectedAccount: alTx.getAffected ())
+    {
+        auto const& account = affectedAccount.getAccountID ();
 
-                if (bAccepted)
-                {
-                    simiIt  = mSubAccount.find (affectedAccount.getAccountID ());
+        add (*rtAccounts, account, iProposed);
 
-                    if (simiIt != mSubAccount.end ())
-                    {
-                        auto it = simiIt->second.begin ();
-                        while (it != simiIt->second.end ())
-                        {
-                            InfoSub::pointer p = it->second.lock ();
-
-                            if (p)
-                            {
-                                notify.insert (p);
-                                ++it;
-                                ++iAccepted;
-                            }
-                            else
-                                it = simiIt->second.erase (it);
-                        }
-                    }
-                }
-            }
-        }
+        if (bAccepted)
+            add (*accounts, account, iAccepted);
     }
+
     m_journal.trace << "pubAccountTransaction:" <<
         " iProposed=" << iProposed <<
         " iAccepted=" << iAccepted;
 
-    if (!notify.empty ())
-    {
-        Json::Value jvObj = transJson (
-            *alTx.getTxn (), alTx.getResult (), bAccepted, lpCurrent);
-
-        if (alTx.isApplied ())
-            jvObj[jss::meta] = alTx.getMeta ()->getJson (0);
-
-        std::string sObj = to_string (jvObj);
-
-        for (InfoSub::ref isrListener : notify)
-        {
-            isrListener->send (jvObj, sObj, true);
-        }
-    }
+    for (InfoSub::ref isrListener : notify)
+        message.send (*isrListener);
 }
 
 //
@@ -2573,7 +2792,7 @@ void NetworkOPsImp::subAccount (
     InfoSub::ref isrListener,
     const hash_set<SkywellAddress>& vnaAccountIDs, bool rt)
 {
-    SubInfoMapType& subMap = rt ? mSubRTAccount : mSubAccount;
+    SubInfoMapPtr& target = rt ? mSubRTAccount : mSubAccount;
 
     for (auto const& naAccountID : vnaAccountIDs)
     {
@@ -2585,23 +2804,21 @@ void NetworkOPsImp::subAccount (
 
     ScopedLockType sl (mSubLock);
 
+    auto subMap = std::make_shared <SubInfoMapType> (*target);
+
     for (auto const& naAccountID : vnaAccountIDs)
     {
-        auto simIterator = subMap.find (naAccountID.getAccountID ());
-        if (simIterator == subMap.end ())
-        {
-            // Not found, note that account has a new single listner.
-            SubMapType  usisElement;
-            usisElement[isrListener->getSeq ()] = isrListener;
-            subMap.insert (simIterator, make_pair (naAccountID.getAccountID (),
-                                                   usisElement));
-        }
-        else
-        {
-            // Found, note that the account has another listener.
-            simIterator->second[isrListener->getSeq ()] = isrListener;
-        }
+        auto& listeners = (*subMap)[naAccountID.getAccountID ()];
+        auto copy = listeners
+            ? std::make_shared <SubMapType> (*listeners)
+            : std::make_shared <SubMapType> ();
+
+        dropExpired (*copy);
+        (*copy)[isrListener->getSeq ()] = isrListener;
+        listeners = std::move (copy);
     }
+
+    std::atomic_store (&target, SubInfoMapPtr (std::move (subMap)));
 }
 
 void NetworkOPsImp::unsubAccount (
@@ -2626,24 +2843,33 @@ void NetworkOPsImp::unsubAccountInternal (
 {
     ScopedLockType sl (mSubLock);
 
-    SubInfoMapType& subMap = rt ? mSubRTAccount : mSubAccount;
+    SubInfoMapPtr& target = rt ? mSubRTAccount : mSubAccount;
+    auto subMap = std::make_shared <SubInfoMapType> (*target);
 
     for (auto const& naAccountID : vnaAccountIDs)
     {
-        auto simIterator = subMap.find (naAccountID.getAccountID ());
+        auto simIterator = subMap->find (naAccountID.getAccountID ());
 
-        if (simIterator != subMap.end ())
+        if (simIterator != subMap->end () &&
+            simIterator->second->count (uSeq) != 0)
         {
-            // Found
-            simIterator->second.erase (uSeq);
+            auto copy = std::make_shared <SubMapType> (*simIterator->second);
+            copy->erase (uSeq);
+            dropExpired (*copy);
 
-            if (simIterator->second.empty ())
+            if (copy->empty ())
             {
                 // Don't need hash entry.
-                subMap.erase (simIterator);
+                subMap->erase (simIterator);
+            }
+            else
+            {
+                simIterator->second = std::move (copy);
             }
         }
     }
+
+    std::atomic_store (&target, SubInfoMapPtr (std::move (subMap)));
 }
 
 bool NetworkOPsImp::subBook (InfoSub::ref isrListener, Book const& book)
@@ -2811,6 +3037,86 @@ InfoSub::pointer NetworkOPsImp::addRpcSub (
     return rspEntry;
 }
 
+void NetworkOPsImp::addBookOffer (
+    Book const& book,
+    Account const& uTakerID,
+    std::uint32_t uTransferRate,
+    SLE const& sleOffer,
+    STAmount const& saDirRate,
+    STAmount const& saOwnerFunds,
+    bool firstOwnerOffer,
+    std::map<Account, STAmount>& umBalance,
+    Json::Value& jvOffers)
+{
+    auto const uOfferOwnerID = sleOffer.getFieldAccount160 (sfAccount);
+    auto const& saTakerGets = sleOffer.getFieldAmount (sfTakerGets);
+    auto const& saTakerPays = sleOffer.getFieldAmount (sfTakerPays);
+
+    Json::Value jvOffer = sleOffer.getJson (0);
+
+    STAmount    saTakerGetsFunded;
+    STAmount    saOwnerFundsLimit;
+    std::uint32_t uOfferRate;
+
+
+    if (uTransferRate != QUALITY_ONE
+        // Have a tranfer fee.
+        && uTakerID != book.out.account
+        // Not taking offers of own IOUs.
+        && book.out.account != uOfferOwnerID)
+        // Offer owner not issuing ownfunds
+    {
+        // Need to charge a transfer fee to offer owner.
+        uOfferRate          = uTransferRate;
+        saOwnerFundsLimit   = divide (
+            saOwnerFunds,
+            STAmount (noIssue(), uOfferRate, -9),
+            saOwnerFunds.issue ());
+        // TODO(tom): why -9?
+    }
+    else
+    {
+        uOfferRate          = QUALITY_ONE;
+        saOwnerFundsLimit   = saOwnerFunds;
+    }
+
+    if (saOwnerFundsLimit >= saTakerGets)
+    {
+        // Sufficient funds no shenanigans.
+        saTakerGetsFunded   = saTakerGets;
+    }
+    else
+    {
+        // Only provide, if not fully funded.
+
+        saTakerGetsFunded   = saOwnerFundsLimit;
+
+        saTakerGetsFunded.setJson (jvOffer[jss::taker_gets_funded]);
+        std::min (
+            saTakerPays, multiply (
+                saTakerGetsFunded, saDirRate, saTakerPays.issue ())).setJson
+                (jvOffer[jss::taker_pays_funded]);
+    }
+
+    STAmount saOwnerPays = (QUALITY_ONE == uOfferRate)
+        ? saTakerGetsFunded
+        : std::min (
+            saOwnerFunds,
+            multiply (
+                saTakerGetsFunded,
+                STAmount (noIssue(), uOfferRate, -9),
+                saTakerGetsFunded.issue ()));
+
+    umBalance[uOfferOwnerID]    = saOwnerFunds - saOwnerPays;
+
+    // Include all offers funded and unfunded
+    Json::Value& jvOf = jvOffers.append (jvOffer);
+    jvOf[jss::quality] = saDirRate.getText ();
+
+    if (firstOwnerOffer)
+        jvOf[jss::owner_funds] = saOwnerFunds.getText ();
+}
+
 #ifndef USE_NEW_BOOK_PAGE
 
 // NIKB FIXME this should be looked at. There's no reason why this shouldn't
@@ -2843,6 +3149,60 @@ void NetworkOPsImp::getBookPage (
         m_journal.trace << "getBookPage: uTipIndex=" << uTipIndex;
     }
 
+    unsigned int left (iLimit == 0 ? 300 : iLimit);
+    if (! bAdmin && left > 300)
+        left = 300;
+
+    // A closed ledger's books are kept in memory between requests
+    auto const indexed = mBookIndex.getOffers (lpLedger, book);
+
+    if (indexed && (indexed->complete || (indexed->offers.size () >= left)))
+    {
+        for (auto const& offer : indexed->offers)
+        {
+            if (left-- == 0)
+                break;
+
+            STAmount saOwnerFunds;
+            bool firstOwnerOffer (true);
+
+            if (book.out.account == offer.owner)
+            {
+                // If an offer is selling issuer's own IOUs, it is fully
+                // funded.
+                saOwnerFunds = offer.entry->getFieldAmount (sfTakerGets);
+            }
+            else if (indexed->globalFreeze)
+            {
+                // If either asset is globally frozen, consider all offers
+                // that aren't ours to be totally unfunded
+                saOwnerFunds.clear (IssueRef (book.out.currency, book.out.account));
+            }
+            else
+            {
+                auto umBalanceEntry = umBalance.find (offer.owner);
+                if (umBalanceEntry != umBalance.end ())
+                {
+                    saOwnerFunds = umBalanceEntry->second;
+                    firstOwnerOffer = false;
+                }
+                else
+                {
+                    auto const funds = indexed->funds.find (offer.owner);
+                    assert (funds != indexed->funds.end ());
+                    if (funds != indexed->funds.end ())
+                        saOwnerFunds = funds->second;
+                }
+            }
+
+            addBookOffer (book, uTakerID, indexed->transferRate, *offer.entry,
+                offer.rate, saOwnerFunds, firstOwnerOffer, umBalance,
+                jvOffers);
+        }
+
+        return;
+    }
+
     LedgerEntrySet  lesActive (lpLedger, tapNONE, true);
 
     const bool      bGlobalFreeze =  lesActive.isGlobalFrozen (book.out.account) ||
@@ -2858,10 +3218,6 @@ void NetworkOPsImp::getBookPage (
 
     auto uTransferRate = truechainTransferRate (lesActive, book.out.account);
 
-    unsigned int left (iLimit == 0 ? 300 : iLimit);
-    if (! bAdmin && left > 300)
-        left = 300;
-
     while (!bDone && left-- > 0)
     {
         if (bDirectAdvance)
@@ -2901,8 +3257,6 @@ void NetworkOPsImp::getBookPage (
                         sleOffer->getFieldAccount160 (sfAccount);
                 auto const& saTakerGets =
                         sleOffer->getFieldAmount (sfTakerGets);
-                auto const& saTakerPays =
-                        sleOffer->getFieldAmount (sfTakerPays);
                 STAmount saOwnerFunds;
                 bool firstOwnerOffer (true);
 
@@ -2945,69 +3299,9 @@ void NetworkOPsImp::getBookPage (
                     }
                 }
 
-                Json::Value jvOffer = sleOffer->getJson (0);
-
-                STAmount    saTakerGetsFunded;
-                STAmount    saOwnerFundsLimit;
-                std::uint32_t uOfferRate;
-
-
-                if (uTransferRate != QUALITY_ONE
-                    // Have a tranfer fee.
-                    && uTakerID != book.out.account
-                    // Not taking offers of own IOUs.
-                    && book.out.account != uOfferOwnerID)
-                    // Offer owner not issuing ownfunds
-                {
-                    // Need to charge a transfer fee to offer owner.
-                    uOfferRate          = uTransferRate;
-                    saOwnerFundsLimit   = divide (
-                        saOwnerFunds,
-                        STAmount (noIssue(), uOfferRate, -9),
-                        saOwnerFunds.issue ());
-                    // TODO(tom): why -9?
-                }
-                else
-                {
-                    uOfferRate          = QUALITY_ONE;
-                    saOwnerFundsLimit   = saOwnerFunds;
-                }
-
-                if (saOwnerFundsLimit >= saTakerGets)
-                {
-                    // Sufficient funds no shenanigans.
-                    saTakerGetsFunded   = saTakerGets;
-                }
-                else
-                {
-                    // Only provide, if not fully funded.
-
-                    saTakerGetsFunded   = saOwnerFundsLimit;
-
-                    saTakerGetsFunded.setJson (jvOffer[jss::taker_gets_funded]);
-                    std::min (
-                        saTakerPays, multiply (
-                            saTakerGetsFunded, saDirRate, saTakerPays.issue ())).setJson
-                            (jvOffer[jss::taker_pays_funded]);
-                }
-
-                STAmount saOwnerPays = (QUALITY_ONE == uOfferRate)
-                    ? saTakerGetsFunded
-                    : std::min (
-                        saOwnerFunds,
-                        multiply (
-                            saTakerGetsFunded,
-                            STAmount (noIssue(), uOfferRate, -9),
-                            saTakerGetsFunded.issue ()));
-
-                umBalance[uOfferOwnerID]    = saOwnerFunds - saOwnerPays;
-
-                // Include all offers funded and unfunded
-                Json::Value& jvOf = jvOffers.append (jvOffer);
-                jvOf[jss::quality] = saDirRate.getText ();
-
-                if (firstOwnerOffer)
-                    jvOf[jss::owner_funds] = saOwnerFunds.getText ();
+                addBookOffer (book, uTakerID, uTransferRate, *sleOffer,
+                    saDirRate, saOwnerFunds, firstOwnerOffer, umBalance,
+                    jvOffers);
             }
             else
             {
@@ -274,6 +274,19 @@ public:
     virtual void addLocalTx (Ledger::ref openLedger, STTx::ref txn) = 0;
     virtual std::size_t getLocalTxCount () = 0;
 
+    struct PublishStats
+    {
+        // Proposed transactions waiting to be published
+        std::size_t queued;
+
+        // Proposed transactions published, and dropped because
+        // subscribers fell too far behind
+        std::uint64_t published;
+        std::uint64_t dropped;
+    };
+
+    virtual PublishStats getProposedPublishStats () = 0;
+
     //Helper function to generate SQL query to get transactions
     virtual std::string transactionsSQL (std::string selection,
         SkywellAddress const& account, std::int32_t minLedger, std::int32_t maxLedger,
@@ -317,6 +330,10 @@ public:
     // Monitoring: publisher side
     //
     virtual void pubLedger (Ledger::ref lpAccepted) = 0;
+
+    /** Queue a transaction applied to the open ledger for publication.
+        The ledger must not be modified afterwards.
+    */
     virtual void pubProposedTransaction (Ledger::ref lpCurrent,
         STTx::ref stTxn, TER terResult) = 0;
 };
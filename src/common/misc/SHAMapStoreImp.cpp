@@ -25,6 +25,7 @@
 
 #include <common/misc/SHAMapStoreImp.h>
 #include <common/core/ConfigSections.h>
+#include <ledger/AccountTxIndex.h>
 #include <ledger/LedgerMaster.h>
 #include <main/Application.h>
 
@@ -568,6 +569,12 @@ SHAMapStoreImp::clearPrior (LedgerIndex lastRotated)
     if (health())
         return;
 
+    // Before the SQL rows go, so the index never answers for them
+    if (auto index = getApp().getAccountTxIndex ())
+        index->clearPrior (lastRotated);
+    if (health())
+        return;
+
     // TODO This won't remove validations for ledgers that do not get
     // validated. That will likely require inserting LedgerSeq into
     // the validations table.
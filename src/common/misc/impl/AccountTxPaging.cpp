@@ -21,6 +21,7 @@
 #include <beast/cxx14/memory.h> // <memory>
 #include <boost/format.hpp>
 
+#include <ledger/LedgerMaster.h>
 #include <ledger/LedgerToJson.h>
 #include <main/Application.h>
 #include <common/misc/impl/AccountTxPaging.h>
@@ -264,4 +265,143 @@ accountTxPage (
     return;
 }
 
+// Read a transaction and its metadata from the ledger it was validated in,
+// falling back to the Transactions table
+static bool
+loadIndexedTransaction (
+    DatabaseCon& connection,
+    Ledger::pointer const& ledger,
+    uint256 const& transID,
+    std::string& status,
+    std::string& rawTxn,
+    std::string& rawMeta)
+{
+    if (ledger)
+    {
+        try
+        {
+            SHAMapTreeNode::TNType type;
+            auto item = ledger->peekTransactionMap ()->peekItem (transID, type);
+
+            if (item && (type == SHAMapTreeNode::tnTRANSACTION_MD))
+            {
+                SerialIter sit (item->peekSerializer ());
+                Blob const txn = sit.getVL ();
+                Blob const meta = sit.getVL ();
+
+                status.assign (1, TXN_SQL_VALIDATED);
+                rawTxn.assign (txn.begin (), txn.end ());
+                rawMeta.assign (meta.begin (), meta.end ());
+                return true;
+            }
+        }
+        catch (SHAMapMissingNode const&)
+        {
+            // The node store has been rotated past this ledger
+        }
+    }
+
+    auto db (connection.checkoutDb ());
+
+    boost::optional<std::string> sqlStatus;
+    boost::optional<std::string> txnData;
+    boost::optional<std::string> txnMeta;
+    soci::indicator dataPresent, metaPresent;
+
+    *db << boost::str (boost::format (
+            "SELECT Status,RawTxn,TxnMeta FROM Transactions "
+            "WHERE TransID = '%s';") % to_string (transID)),
+        soci::into (sqlStatus),
+        soci::into (txnData, dataPresent),
+        soci::into (txnMeta, metaPresent);
+
+    if (!db->got_data () || !sqlStatus)
+        return false;
+
+    status = *sqlStatus;
+    rawTxn = (dataPresent == soci::i_ok) ? *txnData : std::string ();
+    rawMeta = (metaPresent == soci::i_ok) ? *txnMeta : std::string ();
+    return true;
+}
+
+void
+accountTxIndexPage (
+    AccountTxIndex const& index,
+    DatabaseCon& connection,
+    std::function<void (std::uint32_t,
+                        std::string const&,
+                        std::string const&,
+                        std::string const&)> const& onTransaction,
+    SkywellAddress const& account,
+    std::int32_t minLedger,
+    std::int32_t maxLedger,
+    bool forward,
+    Json::Value& token,
+    int limit,
+    bool bAdmin,
+    std::uint32_t page_length)
+{
+    std::uint32_t numberOfResults;
+
+    if (limit <= 0 || (limit > page_length && !bAdmin))
+        numberOfResults = page_length;
+    else
+        numberOfResults = limit;
+
+    // The marker names the first entry of the next page, as for SQL paging,
+    // but here it is a seek rather than a scan from the start of the range
+    std::uint32_t findLedger = 0, findSeq = 0;
+
+    if (!token.isNull() && token.isObject())
+    {
+        try
+        {
+            if (!token.isMember(jss::ledger) || !token.isMember(jss::seq))
+                return;
+            findLedger = token[jss::ledger].asInt();
+            findSeq = token[jss::seq].asInt();
+        }
+        catch (...)
+        {
+            return;
+        }
+    }
+
+    token = Json::nullValue;
+
+    auto entries = index.getPage (account.getAccountID (),
+        minLedger, maxLedger, forward, findLedger, findSeq,
+        numberOfResults + 1);
+
+    if (entries.size () > numberOfResults)
+    {
+        token = Json::objectValue;
+        token[jss::ledger] = entries.back ().ledgerSeq;
+        token[jss::seq] = entries.back ().txnSeq;
+        entries.pop_back ();
+    }
+
+    Ledger::pointer ledger;
+    std::string status, rawTxn, rawMeta;
+
+    for (auto const& entry : entries)
+    {
+        if (!ledger || (ledger->getLedgerSeq () != entry.ledgerSeq))
+            ledger = getApp().getLedgerMaster ().getLedgerBySeq (
+                entry.ledgerSeq);
+
+        if (loadIndexedTransaction (
+                connection, ledger, entry.transID, status, rawTxn, rawMeta))
+        {
+            onTransaction (entry.ledgerSeq, status, rawTxn, rawMeta);
+        }
+        else
+        {
+            WriteLog (lsWARNING, AccountTxIndex)
+                << "Indexed transaction " << entry.transID
+                << " not found in ledger " << entry.ledgerSeq;
+        }
+    }
+}
+
 }
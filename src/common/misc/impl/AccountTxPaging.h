@@ -26,6 +26,7 @@
 
 #include <data/database/DatabaseCon.h>
 #include <common/misc/NetworkOPs.h>
+#include <ledger/AccountTxIndex.h>
 
 //------------------------------------------------------------------------------
 
@@ -59,6 +60,28 @@ accountTxPage (
     bool bAdmin,
     std::uint32_t pageLength);
 
+/** Like accountTxPage, but find the transactions through the account
+    transaction index, which must cover [minLedger, maxLedger].
+    Transactions are read from their ledger in the node store, or from
+    the database if the node store no longer has them.
+*/
+void
+accountTxIndexPage (
+    AccountTxIndex const& index,
+    DatabaseCon& database,
+    std::function<void (std::uint32_t,
+                        std::string const&,
+                        std::string const&,
+                        std::string const&)> const&,
+    SkywellAddress const& account,
+    std::int32_t minLedger,
+    std::int32_t maxLedger,
+    bool forward,
+    Json::Value& token,
+    int limit,
+    bool bAdmin,
+    std::uint32_t pageLength);
+
 }
 
 #endif
@@ -156,6 +156,12 @@ public:
     void visitNodes (std::function<bool (SHAMapTreeNode&)> const&) const;
     void visitLeaves(std::function<void (std::shared_ptr<SHAMapItem> const&)> const&) const;
 
+    /** Visit the leaves below one branch of the root, in key order.
+        Lets callers split a full traversal across threads.
+    */
+    void visitLeaves (int branch,
+        std::function<void (std::shared_ptr<SHAMapItem> const&)> const&) const;
+
     // comparison/sync functions
     void getMissingNodes (std::vector<SHAMapNodeID>& nodeIDs, std::vector<uint256>& hashes, int max,
                           SHAMapSyncFilter * filter);
@@ -164,6 +170,14 @@ public:
         std::vector<SHAMapNodeID>& nodeIDs,
             std::vector<Blob>& rawNode,
                 bool fatLeaves, std::uint32_t depth) const;
+
+    /** Get the leaves below a node, in key order.
+        @return false if the node is not in the map or has more than
+                max leaves below it.
+    */
+    bool getLeaves (SHAMapNodeID const& node,
+        std::vector<std::shared_ptr<SHAMapItem>>& items,
+            std::size_t max) const;
     
     bool getRootNode (Serializer & s, SHANodeFormat format) const;
     std::vector<uint256> getNeededHashes (int max, SHAMapSyncFilter * filter);
@@ -44,6 +44,49 @@ void SHAMap::visitLeaves (std::function<void (std::shared_ptr<SHAMapItem> const&
             std::cref (leafFunction), std::placeholders::_1));
 }
 
+void SHAMap::visitLeaves (int branch,
+    std::function<void (std::shared_ptr<SHAMapItem> const&)> const& leafFunction) const
+{
+    assert ((branch >= 0) && (branch < 16));
+
+    if (!root_ || root_->isEmpty ())
+        return;
+
+    if (root_->isLeaf ())
+    {
+        // A map with a single item keeps it in the root
+        if (SHAMapNodeID ().selectBranch (root_->peekItem ()->getTag ()) == branch)
+            leafFunction (root_->peekItem ());
+        return;
+    }
+
+    if (root_->isEmptyBranch (branch))
+        return;
+
+    // Depth first, pushing children in reverse so leaves come out in order
+    std::stack <std::shared_ptr<SHAMapTreeNode>,
+        std::vector <std::shared_ptr<SHAMapTreeNode>>> stack;
+    stack.push (descendNoStore (root_, branch));
+
+    while (!stack.empty ())
+    {
+        std::shared_ptr<SHAMapTreeNode> node = std::move (stack.top ());
+        stack.pop ();
+
+        if (node->isLeaf ())
+        {
+            leafFunction (node->peekItem ());
+            continue;
+        }
+
+        for (int pos = 15; pos >= 0; --pos)
+        {
+            if (!node->isEmptyBranch (pos))
+                stack.push (descendNoStore (node, pos));
+        }
+    }
+}
+
 void SHAMap::visitNodes(std::function<bool (SHAMapTreeNode&)> const& function) const
 {
     // Visit every node in a SHAMap
@@ -391,6 +434,56 @@ bool SHAMap::getNodeFat (SHAMapNodeID wanted,
     return true;
 }
 
+bool SHAMap::getLeaves (SHAMapNodeID const& wanted,
+    std::vector<std::shared_ptr<SHAMapItem>>& items,
+        std::size_t max) const
+{
+    SHAMapTreeNode* node = root_.get ();
+    SHAMapNodeID nodeID;
+
+    while (node && node->isInner () && (nodeID.getDepth() < wanted.getDepth()))
+    {
+        int branch = nodeID.selectBranch (wanted.getNodeID());
+
+        if (node->isEmptyBranch (branch))
+            return false;
+
+        node = descendThrow (node, branch);
+        nodeID = nodeID.getChildNodeID (branch);
+    }
+
+    if (!node || (nodeID != wanted))
+        return false;
+
+    // Push branches in reverse so they are visited in key order
+    std::stack<SHAMapTreeNode*> stack;
+    stack.push (node);
+
+    while (! stack.empty ())
+    {
+        node = stack.top ();
+        stack.pop ();
+
+        if (node->isLeaf ())
+        {
+            if (items.size () >= max)
+                return false;
+
+            items.push_back (node->peekItem ());
+        }
+        else
+        {
+            for (int i = 15; i >= 0; --i)
+            {
+                if (! node->isEmptyBranch (i))
+                    stack.push (descendThrow (node, i));
+            }
+        }
+    }
+
+    return true;
+}
+
 bool SHAMap::getRootNode (Serializer& s, SHANodeFormat format) const
 {
     root_->addRaw (s, format);
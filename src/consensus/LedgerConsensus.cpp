@@ -41,10 +41,13 @@
 #include <common/json/to_string.h>
 #include <transaction/tx/TransactionAcquire.h>
 #include <transaction/tx/InboundTransactions.h>
+#include <transaction/tx/TransactionMaster.h>
+#include <transaction/tx/ParallelApply.h>
 #include <network/overlay/Overlay.h>
 #include <network/overlay/predicates.h>
 #include <protocol/STValidation.h>
 #include <protocol/UintTypes.h>
+#include <mutex>
 
 namespace truechain {
 
@@ -104,6 +107,7 @@ public:
         , mHaveCloseTimeConsensus (false)
         , mConsensusStartTime
             (std::chrono::steady_clock::now ())
+        , mSpecTaken (false)
     {
         WriteLog (lsDEBUG, LedgerConsensus) << "Creating consensus object";
         WriteLog (lsTRACE, LedgerConsensus)
@@ -922,17 +926,28 @@ private:
         // Put failed transactions into a deterministic order
         CanonicalTXSet retriableTransactions (set->getHash ());
 
-        // Build the new last closed ledger
-        Ledger::pointer newLCL
-            = std::make_shared<Ledger> (false
-            , *mPreviousLedger);
+        // Use the ledger we built while establishing, if it is for this set
+        Ledger::pointer newLCL = takeSpeculation (
+            set->getHash (), retriableTransactions);
+
+        if (newLCL)
+        {
+            WriteLog (lsDEBUG, LedgerConsensus)
+                << "Using speculatively built last closed ledger";
+        }
+        else
+        {
+            // Build the new last closed ledger
+            newLCL = std::make_shared<Ledger> (false, *mPreviousLedger);
+
+            // Set up to write SHAMap changes to our database,
+            //   perform updates, extract changes
+            WriteLog (lsDEBUG, LedgerConsensus)
+                << "Applying consensus set transactions to the"
+                << " last closed ledger";
+            applyTransactions (set, newLCL, newLCL, retriableTransactions, false);
+        }
 
-        // Set up to write SHAMap changes to our database,
-        //   perform updates, extract changes
-        WriteLog (lsDEBUG, LedgerConsensus)
-            << "Applying consensus set transactions to the"
-            << " last closed ledger";
-        applyTransactions (set, newLCL, newLCL, retriableTransactions, false);
         newLCL->updateSkipList ();
         newLCL->setClosed ();
 
@@ -1021,9 +1036,8 @@ private:
                     WriteLog (lsDEBUG, LedgerConsensus)
                         << "Test applying disputed transaction that did"
                         << " not get in";
-                    SerialIter sit (it.second->peekTransaction ());
-                    STTx::pointer txn
-                        = std::make_shared<STTx>(sit);
+                    STTx::pointer txn = getApp().getMasterTransaction ()
+                        .fetchParsed (it.first, it.second->peekTransaction ());
 
                     retriableTransactions.push_back (txn);
                     anyDisputes = true;
@@ -1362,6 +1376,9 @@ private:
         WriteLog (lsINFO, LedgerConsensus) << "initial position " << txSet;
         mapCompleteInternal (txSet, initialSet, false);
 
+        if (mHaveCorrectLCL)
+            speculate (initialSet);
+
         if (mValidating)
         {
             mOurPosition = std::make_shared<LedgerProposal>
@@ -1584,6 +1601,9 @@ private:
                     propose ();
 
                 mapCompleteInternal (newHash, ourPosition, false);
+
+                if (mHaveCorrectLCL)
+                    speculate (ourPosition);
             }
         }
     }
@@ -1713,6 +1733,115 @@ private:
         }
     }
 
+    /** Start building the ledger our position would produce.
+
+        The build runs in the background while we establish consensus.
+        If we accept the same set on the same previous ledger, accept
+        uses the result instead of applying the transactions itself.
+    */
+    void speculate (std::shared_ptr<SHAMap> const& set)
+    {
+        std::lock_guard <std::mutex> sl (mSpecLock);
+
+        if (mSpecTaken)
+            return;
+
+        if (mSpecBuilding.isNonZero ())
+        {
+            // Picked up when the build in progress finishes
+            mSpecPending = std::make_pair (set, mPreviousLedger);
+            return;
+        }
+
+        mSpecBuilding = set->getHash ();
+        getApp().getJobQueue().addJob (jtSPECULATE, "speculateLedger",
+            std::bind (&LedgerConsensusImp::buildSpeculation,
+                shared_from_this (), std::placeholders::_1,
+                    set, mPreviousLedger));
+    }
+
+    void buildSpeculation (Job&, std::shared_ptr<SHAMap> set,
+        Ledger::pointer previousLedger)
+    {
+        while (set)
+        {
+            {
+                std::lock_guard <std::mutex> sl (mSpecLock);
+
+                if (mSpecTaken)
+                {
+                    // accept no longer wants the result
+                    mSpecBuilding.zero ();
+                    return;
+                }
+            }
+
+            auto retriable = std::make_shared <CanonicalTXSet> (set->getHash ());
+            Ledger::pointer ledger
+                = std::make_shared<Ledger> (false, *previousLedger);
+
+            applyTransactions (set, ledger, ledger, *retriable, false);
+
+            std::lock_guard <std::mutex> sl (mSpecLock);
+
+            if (mSpecTaken)
+            {
+                mSpecBuilding.zero ();
+                return;
+            }
+
+            mSpeculation.setHash = set->getHash ();
+            mSpeculation.previousHash = previousLedger->getHash ();
+            mSpeculation.ledger = ledger;
+            mSpeculation.retriable = retriable;
+
+            set.reset ();
+            previousLedger.reset ();
+
+            // Move on to our latest position, if it changed meanwhile
+            if (mSpecPending.first &&
+                (mSpecPending.first->getHash () != mSpeculation.setHash))
+            {
+                set = mSpecPending.first;
+                previousLedger = mSpecPending.second;
+                mSpecBuilding = set->getHash ();
+            }
+            else
+                mSpecBuilding.zero ();
+
+            mSpecPending = SpeculationRequest ();
+        }
+    }
+
+    /** Returns the ledger built ahead of time for a set, if any.
+        Never waits: a build that has not finished yet is abandoned and
+        the caller applies the set itself. The build may be queued behind
+        the caller on the job queue (standalone runs a single thread).
+    */
+    Ledger::pointer takeSpeculation (uint256 const& setHash,
+        CanonicalTXSet& retriable)
+    {
+        std::lock_guard <std::mutex> sl (mSpecLock);
+
+        // No further positions will be built, and a running build
+        // discards its result
+        mSpecTaken = true;
+        mSpecPending = SpeculationRequest ();
+
+        Ledger::pointer ledger;
+
+        // mSpeculation only ever holds a finished build
+        if (mSpeculation.ledger && (mSpeculation.setHash == setHash) &&
+            (mSpeculation.previousHash == mPreviousLedger->getHash ()))
+        {
+            ledger = mSpeculation.ledger;
+            retriable = *mSpeculation.retriable;
+        }
+
+        mSpeculation = Speculation ();
+        return ledger;
+    }
+
     void endConsensus ()
     {
         getApp().getOPs ().endConsensus (mHaveCorrectLCL);
@@ -1774,6 +1903,31 @@ private:
 
     // nodes that have bowed out of this consensus process
     NodeIDSet mDeadNodes;
+
+    // A ledger built from one of our positions, before we accept
+    struct Speculation
+    {
+        uint256 setHash;
+        uint256 previousHash;
+        Ledger::pointer ledger;
+        std::shared_ptr <CanonicalTXSet> retriable;
+    };
+
+    typedef std::pair <std::shared_ptr <SHAMap>, Ledger::pointer>
+        SpeculationRequest;
+
+    std::mutex mSpecLock;
+
+    // Set once accept has asked for the result
+    bool mSpecTaken;
+
+    // The set being built, or zero if no build is running
+    uint256 mSpecBuilding;
+
+    // Our latest position, if it changed while a build was running
+    SpeculationRequest mSpecPending;
+
+    Speculation mSpeculation;
 };
 
 //------------------------------------------------------------------------------
@@ -1791,19 +1945,11 @@ make_LedgerConsensus (LocalTxs& localtx,
         prevLCLHash, previousLedger, closeTime, feeVote);
 }
 
-/** Apply a transaction to a ledger
-
-  @param engine       The transaction engine containing the ledger.
-  @param txn          The transaction to be applied to ledger.
-  @param openLedger   true if ledger is open
-  @param retryAssured true if the transaction should be retried on failure.
-  @return             One of resultSuccess, resultFail or resultRetry.
-*/
+// The engine parameters to apply a transaction with
 static
-int applyTransaction (TransactionEngine& engine
-    , STTx::ref txn, bool openLedger, bool retryAssured)
+TransactionEngineParams applyParams (STTx::ref txn
+    , bool openLedger, bool retryAssured)
 {
-    // Returns false if the transaction has need not be retried.
     TransactionEngineParams parms = openLedger ? tapOPEN_LEDGER : tapNONE;
 
     if (retryAssured)
@@ -1823,34 +1969,69 @@ int applyTransaction (TransactionEngine& engine
         << (retryAssured ? "/retry" : "/final");
     WriteLog (lsTRACE, LedgerConsensus) << txn->getJson (0);
 
-    if(openLedger == false && (txn->getTimestamp()>= engine.getLedger()->getCloseTimeNC ()-1 ))
+    return parms;
+}
+
+// Whether a transaction is too new to go into a closed ledger yet
+static
+bool isPremature (TransactionEngine& engine, STTx::ref txn, bool openLedger)
+{
+    return !openLedger &&
+        (txn->getTimestamp() >= engine.getLedger()->getCloseTimeNC ()-1);
+}
+
+/** Classify the result of applying a transaction
+
+  @param result       The engine's result and whether it applied.
+  @return             One of resultSuccess, resultFail or resultRetry.
+*/
+static
+int applyResult (std::pair<TER, bool> const& result)
+{
+    if (result.second)
     {
-        return LedgerConsensusImp::resultRetry;
+        WriteLog (lsDEBUG, LedgerConsensus)
+        << "Transaction applied: " << transHuman (result.first);
+        return LedgerConsensusImp::resultSuccess;
     }
-    try
+
+    if (isTefFailure (result.first) || isTemMalformed (result.first) ||
+        isTelLocal (result.first))
     {
-        auto result = engine.applyTransaction (*txn, parms);
+        // failure
+        WriteLog (lsDEBUG, LedgerConsensus)
+            << "Transaction failure: " << transHuman (result.first);
+        return LedgerConsensusImp::resultFail;
+    }
 
-        if (result.second)
-        {
-            WriteLog (lsDEBUG, LedgerConsensus)
-            << "Transaction applied: " << transHuman (result.first);
-            return LedgerConsensusImp::resultSuccess;
-        }
+    WriteLog (lsDEBUG, LedgerConsensus)
+        << "Transaction retry: " << transHuman (result.first);
+    return LedgerConsensusImp::resultRetry;
+}
 
-        if (isTefFailure (result.first) || isTemMalformed (result.first) ||
-            isTelLocal (result.first))
-        {
-            // failure
-            WriteLog (lsDEBUG, LedgerConsensus)
-                << "Transaction failure: " << transHuman (result.first);
-            return LedgerConsensusImp::resultFail;
-        }
+/** Apply a transaction to a ledger
 
-        WriteLog (lsDEBUG, LedgerConsensus)
-            << "Transaction retry: " << transHuman (result.first);
+  @param engine       The transaction engine containing the ledger.
+  @param txn          The transaction to be applied to ledger.
+  @param openLedger   true if ledger is open
+  @param retryAssured true if the transaction should be retried on failure.
+  @return             One of resultSuccess, resultFail or resultRetry.
+*/
+static
+int applyTransaction (TransactionEngine& engine
+    , STTx::ref txn, bool openLedger, bool retryAssured)
+{
+    // Returns false if the transaction has need not be retried.
+    TransactionEngineParams parms = applyParams (txn, openLedger, retryAssured);
+
+    if (isPremature (engine, txn, openLedger))
+    {
         return LedgerConsensusImp::resultRetry;
     }
+    try
+    {
+        return applyResult (engine.applyTransaction (*txn, parms));
+    }
     catch (...)
     {
         WriteLog (lsWARNING, LedgerConsensus) << "Throws";
@@ -1876,6 +2057,9 @@ void applyTransactions (std::shared_ptr<SHAMap> const& set,
 
     if (set)
     {
+        std::vector<STTx::pointer> txns;
+        std::vector<TransactionEngineParams> params;
+
         for (std::shared_ptr<SHAMapItem> item = set->peekFirstItem (); !!item;
             item = set->peekNextItem (item->getTag ()))
         {
@@ -1887,16 +2071,19 @@ void applyTransactions (std::shared_ptr<SHAMap> const& set,
                     "Processing candidate transaction: " << item->getTag ();
                 try
                 {
-                    SerialIter sit (item->peekSerializer ());
-                    STTx::pointer txn
-                        = std::make_shared<STTx>(sit);
-                    if (applyTransaction (engine, txn,
-                              openLgr, true) == LedgerConsensusImp::resultRetry)
+                    // Most candidates were parsed when they reached us
+                    STTx::pointer txn =
+                        getApp().getMasterTransaction ().fetchParsed (item);
+
+                    if (isPremature (engine, txn, openLgr))
                     {
-                        // On failure, stash the failed transaction for
-                        // later retry.
                         retriableTransactions.push_back (txn);
                     }
+                    else
+                    {
+                        params.push_back (applyParams (txn, openLgr, true));
+                        txns.push_back (txn);
+                    }
                 }
                 catch (...)
                 {
@@ -1904,6 +2091,24 @@ void applyTransactions (std::shared_ptr<SHAMap> const& set,
                 }
             }
         }
+
+        // Transactions touching different entries are applied concurrently
+        auto const results = applyInParallel (engine, txns, params);
+
+        for (std::size_t i = 0; i < txns.size (); ++i)
+        {
+            if (results[i].first == tefEXCEPTION)
+            {
+                WriteLog (lsWARNING, LedgerConsensus) << "  Throws";
+            }
+            else if (applyResult (results[i]) ==
+                LedgerConsensusImp::resultRetry)
+            {
+                // On failure, stash the failed transaction for
+                // later retry.
+                retriableTransactions.push_back (txns[i]);
+            }
+        }
     }
 
     int changes;
@@ -0,0 +1,352 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ledger/AccountTxIndex.h>
+#include <common/base/RangeSet.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <rocksdb/db.h>
+#include <rocksdb/iterator.h>
+#include <rocksdb/options.h>
+#include <rocksdb/write_batch.h>
+#include <beast/cxx14/memory.h> // <memory>
+#include <algorithm>
+#include <array>
+#include <mutex>
+
+namespace truechain {
+
+class AccountTxIndexImp : public AccountTxIndex
+{
+private:
+    // Account entries: 'a' | AccountID | LedgerSeq | TxnSeq, big-endian
+    // Ledger entries: 'l' | LedgerSeq, listing that ledger's account keys
+    enum
+    {
+        keyBytes = 1 + Account::bytes + 4 + 4,
+        ledgerKeyBytes = 1 + 4,
+
+        // Ledgers forgotten per write when clearing
+        clearBatchLedgers = 256
+    };
+
+    typedef std::array<unsigned char, keyBytes> Key;
+    typedef std::array<unsigned char, ledgerKeyBytes> LedgerKey;
+
+    beast::Journal m_journal;
+    std::unique_ptr<rocksdb::DB> m_db;
+
+    std::mutex mutable m_lock;
+    RangeSet m_ledgers;
+
+    static char const accountPrefix = 'a';
+    static char const ledgerPrefix = 'l';
+    static char const* ledgersKey () { return "m:ledgers"; }
+
+    static void put32 (unsigned char* out, std::uint32_t v)
+    {
+        out[0] = static_cast<unsigned char> (v >> 24);
+        out[1] = static_cast<unsigned char> (v >> 16);
+        out[2] = static_cast<unsigned char> (v >> 8);
+        out[3] = static_cast<unsigned char> (v);
+    }
+
+    static std::uint32_t get32 (unsigned char const* in)
+    {
+        return (std::uint32_t (in[0]) << 24) | (std::uint32_t (in[1]) << 16) |
+            (std::uint32_t (in[2]) << 8) | std::uint32_t (in[3]);
+    }
+
+    static Key makeKey (Account const& account,
+        std::uint32_t ledgerSeq, std::uint32_t txnSeq)
+    {
+        Key key;
+        key[0] = accountPrefix;
+        std::copy (account.begin (), account.end (), key.begin () + 1);
+        put32 (key.data () + 1 + Account::bytes, ledgerSeq);
+        put32 (key.data () + 1 + Account::bytes + 4, txnSeq);
+        return key;
+    }
+
+    static LedgerKey makeLedgerKey (std::uint32_t ledgerSeq)
+    {
+        LedgerKey key;
+        key[0] = ledgerPrefix;
+        put32 (key.data () + 1, ledgerSeq);
+        return key;
+    }
+
+    template <std::size_t N>
+    static rocksdb::Slice slice (std::array<unsigned char, N> const& key)
+    {
+        return rocksdb::Slice (
+            reinterpret_cast<char const*> (key.data ()), key.size ());
+    }
+
+    // Queue the removal of the entries recorded for a ledger
+    static void removeLedger (rocksdb::Slice const& ledgerKey,
+        std::string const& keys, rocksdb::WriteBatch& batch)
+    {
+        for (std::size_t i = 0; i + keyBytes <= keys.size (); i += keyBytes)
+            batch.Delete (rocksdb::Slice (keys.data () + i, keyBytes));
+
+        batch.Delete (ledgerKey);
+    }
+
+    // Parse the output of RangeSet::toString
+    static void parseLedgers (std::string const& s, RangeSet& ledgers)
+    {
+        if (s.empty () || (s == "empty"))
+            return;
+
+        std::vector<std::string> ranges;
+        boost::split (ranges, s, boost::is_any_of (","));
+
+        for (auto const& range : ranges)
+        {
+            auto const dash = range.find ('-');
+            if (dash == std::string::npos)
+                ledgers.setValue (
+                    boost::lexical_cast<std::uint32_t> (range));
+            else
+                ledgers.setRange (
+                    boost::lexical_cast<std::uint32_t> (range.substr (0, dash)),
+                    boost::lexical_cast<std::uint32_t> (range.substr (dash + 1)));
+        }
+    }
+
+public:
+    AccountTxIndexImp (std::string const& path, beast::Journal journal)
+        : m_journal (journal)
+    {
+        rocksdb::Options options;
+        options.create_if_missing = true;
+
+        rocksdb::DB* db = nullptr;
+        rocksdb::Status status = rocksdb::DB::Open (options, path, &db);
+        if (!status.ok () || !db)
+            throw std::runtime_error (std::string (
+                "Unable to open/create account_tx index: ") +
+                    status.ToString ());
+        m_db.reset (db);
+
+        std::string ledgers;
+        if (m_db->Get (rocksdb::ReadOptions (), ledgersKey (), &ledgers).ok ())
+        {
+            try
+            {
+                parseLedgers (ledgers, m_ledgers);
+            }
+            catch (std::exception const&)
+            {
+                // Only the coverage is lost; queries fall back to SQL
+                m_journal.warning << "Bad ledger list in account_tx index";
+                m_ledgers = RangeSet ();
+            }
+        }
+
+        m_journal.info << "account_tx index has ledgers "
+                       << m_ledgers.toString ();
+    }
+
+    void insert (AcceptedLedger const& ledger) override
+    {
+        std::uint32_t const seq = ledger.getLedgerSeq ();
+        auto const ledgerKey = makeLedgerKey (seq);
+        rocksdb::WriteBatch batch;
+
+        std::lock_guard<std::mutex> sl (m_lock);
+
+        // A ledger saved again may not affect the same accounts, so what
+        // was recorded for it goes first. Later writes in the batch win.
+        std::string keys;
+        if (m_db->Get (rocksdb::ReadOptions (), slice (ledgerKey), &keys).ok ())
+            removeLedger (slice (ledgerKey), keys, batch);
+
+        keys.clear ();
+
+        for (auto const& vt : ledger.getMap ())
+        {
+            uint256 const transID = vt.second->getTransactionID ();
+            rocksdb::Slice const value (
+                reinterpret_cast<char const*> (transID.data ()), transID.bytes);
+
+            for (auto const& account : vt.second->getAffected ())
+            {
+                auto const key = makeKey (
+                    account.getAccountID (), seq, vt.second->getTxnSeq ());
+                batch.Put (slice (key), value);
+                keys.append (
+                    reinterpret_cast<char const*> (key.data ()), key.size ());
+            }
+        }
+
+        batch.Put (slice (ledgerKey), keys);
+
+        m_ledgers.setValue (seq);
+        batch.Put (ledgersKey (), m_ledgers.toString ());
+
+        rocksdb::Status status = m_db->Write (rocksdb::WriteOptions (), &batch);
+        if (!status.ok ())
+        {
+            m_journal.warning << "account_tx index write failed for "
+                              << seq << ": " << status.ToString ();
+            m_ledgers.clearValue (seq);
+        }
+    }
+
+    void clearPrior (std::uint32_t lastLedger) override
+    {
+        {
+            std::lock_guard<std::mutex> sl (m_lock);
+
+            // Stop answering for the ledgers before removing them
+            for (std::uint32_t i = m_ledgers.getFirst ();
+                i < lastLedger; ++i)
+                m_ledgers.clearValue (i);
+
+            rocksdb::Status status = m_db->Put (rocksdb::WriteOptions (),
+                ledgersKey (), m_ledgers.toString ());
+            if (!status.ok ())
+            {
+                m_journal.warning << "account_tx index clear failed: "
+                                  << status.ToString ();
+                return;
+            }
+        }
+
+        auto const first = makeLedgerKey (0);
+        auto const last = makeLedgerKey (lastLedger);
+        bool more = true;
+
+        while (more)
+        {
+            std::lock_guard<std::mutex> sl (m_lock);
+            rocksdb::WriteBatch batch;
+            std::unique_ptr<rocksdb::Iterator> it (
+                m_db->NewIterator (rocksdb::ReadOptions ()));
+
+            int ledgers = 0;
+            for (it->Seek (slice (first));
+                it->Valid () && (it->key ().compare (slice (last)) < 0);
+                it->Next ())
+            {
+                if (++ledgers > clearBatchLedgers)
+                    break;
+
+                removeLedger (it->key (), it->value ().ToString (), batch);
+            }
+
+            more = ledgers > clearBatchLedgers;
+
+            rocksdb::Status status = m_db->Write (rocksdb::WriteOptions (), &batch);
+            if (!status.ok ())
+            {
+                m_journal.warning << "account_tx index clear failed: "
+                                  << status.ToString ();
+                return;
+            }
+        }
+    }
+
+    bool covers (
+        std::uint32_t minLedger, std::uint32_t maxLedger) const override
+    {
+        std::lock_guard<std::mutex> sl (m_lock);
+
+        if (!m_ledgers.hasValue (minLedger) || !m_ledgers.hasValue (maxLedger))
+            return false;
+
+        auto const missing = m_ledgers.prevMissing (maxLedger);
+        return (missing == RangeSet::absent) || (missing < minLedger);
+    }
+
+    std::vector<Entry> getPage (
+        Account const& account,
+        std::uint32_t minLedger, std::uint32_t maxLedger, bool forward,
+        std::uint32_t startLedger, std::uint32_t startTxn,
+        std::size_t limit) const override
+    {
+        std::vector<Entry> ret;
+        std::unique_ptr<rocksdb::Iterator> it (
+            m_db->NewIterator (rocksdb::ReadOptions ()));
+
+        auto const first = makeKey (account, 0, 0);
+        auto const inAccount = [&] ()
+        {
+            if (!it->Valid ())
+                return false;
+
+            rocksdb::Slice const key = it->key ();
+            return (key.size () == keyBytes) &&
+                std::equal (first.begin (), first.begin () + 1 + Account::bytes,
+                    reinterpret_cast<unsigned char const*> (key.data ()));
+        };
+
+        if (forward)
+        {
+            it->Seek (slice ((startLedger != 0)
+                ? makeKey (account, startLedger, startTxn)
+                : makeKey (account, minLedger, 0)));
+        }
+        else
+        {
+            // Position on the last key at or before the starting point
+            auto const last = (startLedger != 0)
+                ? makeKey (account, startLedger, startTxn)
+                : makeKey (account, maxLedger, 0xFFFFFFFF);
+
+            it->Seek (slice (last));
+            if (!it->Valid ())
+                it->SeekToLast ();
+            else if (it->key ().compare (slice (last)) > 0)
+                it->Prev ();
+        }
+
+        for (; (ret.size () < limit) && inAccount ();
+            forward ? it->Next () : it->Prev ())
+        {
+            auto const key = reinterpret_cast<unsigned char const*> (
+                it->key ().data ());
+            std::uint32_t const ledgerSeq = get32 (key + 1 + Account::bytes);
+
+            if ((ledgerSeq < minLedger) || (ledgerSeq > maxLedger))
+                break;
+
+            if (it->value ().size () != uint256::bytes)
+                continue;
+
+            ret.push_back ({ledgerSeq, get32 (key + 1 + Account::bytes + 4),
+                uint256::fromVoid (it->value ().data ())});
+        }
+
+        return ret;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+std::unique_ptr<AccountTxIndex>
+make_AccountTxIndex (std::string const& path, beast::Journal journal)
+{
+    return std::make_unique<AccountTxIndexImp> (path, journal);
+}
+
+} // truechain
@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_APP_LEDGER_ACCOUNTTXINDEX_H_INCLUDED
+#define SKYWELL_APP_LEDGER_ACCOUNTTXINDEX_H_INCLUDED
+
+#include <ledger/AcceptedLedger.h>
+#include <beast/utility/Journal.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace truechain {
+
+/** An index of the transactions affecting each account.
+
+    Entries are keyed by (AccountID, LedgerSeq, TxnSeq) so that an account's
+    history is stored contiguously and in order, and map to the TransID.
+    A page of history costs a seek and a short scan however deep it is,
+    unlike the SQL AccountTransactions table paged with LIMIT offsets.
+*/
+class AccountTxIndex
+{
+public:
+    struct Entry
+    {
+        std::uint32_t ledgerSeq;
+        std::uint32_t txnSeq;
+        uint256 transID;
+    };
+
+    virtual ~AccountTxIndex () = default;
+
+    /** Record the transactions of a validated ledger.
+        A ledger recorded before is replaced.
+    */
+    virtual void insert (AcceptedLedger const& ledger) = 0;
+
+    /** Forget every ledger before lastLedger. */
+    virtual void clearPrior (std::uint32_t lastLedger) = 0;
+
+    /** @return true if every ledger in [minLedger, maxLedger] is recorded. */
+    virtual bool covers (
+        std::uint32_t minLedger, std::uint32_t maxLedger) const = 0;
+
+    /** Return up to limit entries for an account within
+        [minLedger, maxLedger], in ascending or descending order.
+
+        When startLedger is not zero the page begins at the entry
+        (startLedger, startTxn), inclusive.
+    */
+    virtual std::vector<Entry> getPage (
+        Account const& account,
+        std::uint32_t minLedger, std::uint32_t maxLedger, bool forward,
+        std::uint32_t startLedger, std::uint32_t startTxn,
+        std::size_t limit) const = 0;
+};
+
+/** Open or create the index stored at path. */
+std::unique_ptr<AccountTxIndex>
+make_AccountTxIndex (std::string const& path, beast::Journal journal);
+
+} // truechain
+
+#endif
@@ -30,9 +30,11 @@
 #include <ledger/TransactionStateSF.h>
 #include <main/Application.h>
 #include <network/overlay/Overlay.h>
+#include <protocol/BuildInfo.h>
 #include <protocol/HashPrefix.h>
 #include <protocol/JsonFields.h>
 #include <data/nodestore/Database.h>
+#include <algorithm>
 
 namespace truechain {
 
@@ -55,6 +57,18 @@ enum
 
     // How many nodes to consider a fetch "small"
     ,fetchSmallNodes = 32
+
+    // Requests to keep in flight to each peer that is not high latency
+    ,requestWindowDepth = 4
+
+    // Most nodes to ask for in a single windowed request
+    ,requestWindowNodes = 64
+
+    // Milliseconds before a node we asked for may be asked of another peer
+    ,nodeRetryMillis = 1000
+
+    // Shallowest state subtree we ask for as a whole
+    ,snapshotMinDepth = 2
 };
 
 InboundLedger::InboundLedger (uint256 const& hash, std::uint32_t seq, fcReason reason,
@@ -256,6 +270,13 @@ void InboundLedger::onTimer (bool wasProgress, ScopedLockType&)
 {
     mRecentNodes.clear ();
 
+    // Forget requests that were never answered, and decay throughput
+    for (auto& window : mWindows)
+    {
+        window.second.outstanding = 0;
+        window.second.useful /= 2;
+    }
+
     if (isDone())
     {
         if (m_journal.info) m_journal.info <<
@@ -536,19 +557,30 @@ void InboundLedger::trigger (Peer::ptr const& peer)
         }
         else
         {
+            std::vector<Peer::ptr> slots;
+
+            if (!mAggressive)
+                slots = getRequestSlots ();
+
+            std::size_t const maxNodes = slots.empty () ? 256 :
+                slots.size () * requestWindowNodes;
+
             std::vector<SHAMapNodeID> nodeIDs;
             std::vector<uint256> nodeHashes;
-            //  Why 256? Make this a constant
-            nodeIDs.reserve (256);
-            nodeHashes.reserve (256);
+            nodeIDs.reserve (maxNodes);
+            nodeHashes.reserve (maxNodes);
             AccountStateSF filter;
 
             // Release the lock while we process the large state map
             sl.unlock();
             mLedger->peekAccountStateMap ()->getMissingNodes (
-                nodeIDs, nodeHashes, 256, &filter);
+                nodeIDs, nodeHashes, maxNodes, &filter);
             sl.lock();
 
+            // If we are missing more than we can ask for, most of the
+            // state is probably missing, so take whole subtrees at once.
+            bool const bulk = !slots.empty () && (nodeIDs.size () >= maxNodes);
+
             // Make sure nothing happened while we released the lock
             if (!mFailed && !mComplete && !mHaveState)
             {
@@ -566,9 +598,30 @@ void InboundLedger::trigger (Peer::ptr const& peer)
                 }
                 else
                 {
-                    //  Why 128? Make this a constant
                     if (!mAggressive)
-                        filterNodes (nodeIDs, nodeHashes, 128, !isProgress ());
+                    {
+                        // Every peer has a full window, wait for replies
+                        if (slots.empty ())
+                            return;
+
+                        filterNodes (nodeIDs, nodeHashes, maxNodes, !isProgress ());
+                    }
+
+                    if (!nodeIDs.empty () && !slots.empty ())
+                    {
+                        tmGL.set_itype (protocol::liAS_NODE);
+
+                        if (bulk)
+                            sendLeafRequests (tmGL, nodeIDs, slots);
+
+                        if (m_journal.trace) m_journal.trace <<
+                            "Sending AS node " << nodeIDs.size () <<
+                                " requests to " << slots.size () << " slots";
+
+                        if (!nodeIDs.empty () && !slots.empty ())
+                            sendNodeRequests (tmGL, nodeIDs, slots);
+                        return;
+                    }
 
                     if (!nodeIDs.empty ())
                     {
@@ -621,13 +674,21 @@ void InboundLedger::trigger (Peer::ptr const& peer)
         }
         else
         {
+            std::vector<Peer::ptr> slots;
+
+            if (!mAggressive)
+                slots = getRequestSlots ();
+
+            std::size_t const maxNodes = slots.empty () ? 256 :
+                slots.size () * requestWindowNodes;
+
             std::vector<SHAMapNodeID> nodeIDs;
             std::vector<uint256> nodeHashes;
-            nodeIDs.reserve (256);
-            nodeHashes.reserve (256);
+            nodeIDs.reserve (maxNodes);
+            nodeHashes.reserve (maxNodes);
             TransactionStateSF filter;
             mLedger->peekTransactionMap ()->getMissingNodes (
-                nodeIDs, nodeHashes, 256, &filter);
+                nodeIDs, nodeHashes, maxNodes, &filter);
 
             if (nodeIDs.empty ())
             {
@@ -644,7 +705,23 @@ void InboundLedger::trigger (Peer::ptr const& peer)
             else
             {
                 if (!mAggressive)
-                    filterNodes (nodeIDs, nodeHashes, 128, !isProgress ());
+                {
+                    // Every peer has a full window, wait for replies
+                    if (slots.empty ())
+                        return;
+
+                    filterNodes (nodeIDs, nodeHashes, maxNodes, !isProgress ());
+                }
+
+                if (!nodeIDs.empty () && !slots.empty ())
+                {
+                    tmGL.set_itype (protocol::liTX_NODE);
+                    if (m_journal.trace) m_journal.trace <<
+                        "Sending TX node " << nodeIDs.size () <<
+                            " requests to " << slots.size () << " slots";
+                    sendNodeRequests (tmGL, nodeIDs, slots);
+                    return;
+                }
 
                 if (!nodeIDs.empty ())
                 {
@@ -689,9 +766,15 @@ void InboundLedger::filterNodes (std::vector<SHAMapNodeID>& nodeIDs,
 
     int dupCount = 0;
 
+    // A node asked for long enough ago may be asked of another peer
+    auto const now = m_clock.now ();
+    auto const retry = std::chrono::milliseconds (nodeRetryMillis);
+
     for (auto const& nodeHash : nodeHashes)
     {
-        if (mRecentNodes.count (nodeHash) != 0)
+        auto const it = mRecentNodes.find (nodeHash);
+
+        if ((it != mRecentNodes.end ()) && ((now - it->second) < retry))
         {
             duplicates.push_back (true);
             ++dupCount;
@@ -744,10 +827,268 @@ void InboundLedger::filterNodes (std::vector<SHAMapNodeID>& nodeIDs,
 
     for (auto const& nodeHash : nodeHashes)
     {
-        mRecentNodes.insert (nodeHash);
+        mRecentNodes[nodeHash] = now;
+    }
+}
+
+std::vector <Peer::ptr> InboundLedger::getRequestSlots ()
+{
+    std::vector <std::pair <int, Peer::ptr>> peers;
+
+    for (auto const& p : mPeers)
+    {
+        Peer::ptr peer (getApp().overlay ().findPeerByShortID (p.first));
+
+        if (peer)
+        {
+            // Favor low latency peers that have recently been useful
+            RequestWindow const& window = mWindows[p.first];
+            int const score = peer->getScore (peer->hasLedger (mHash, mSeq)) +
+                std::min (window.useful, 1000) * 10;
+            peers.emplace_back (score, peer);
+        }
+    }
+
+    std::sort (peers.begin (), peers.end (),
+        [](std::pair <int, Peer::ptr> const& a,
+           std::pair <int, Peer::ptr> const& b)
+        {
+            return a.first > b.first;
+        });
+
+    // Hand out free slots a round at a time, so the work is spread
+    // over every peer before any one of them gets a second request.
+    std::vector <Peer::ptr> slots;
+
+    for (int round = 0; round < requestWindowDepth; ++round)
+    {
+        for (auto const& p : peers)
+        {
+            int const depth = p.second->isHighLatency () ? 1 : requestWindowDepth;
+
+            if ((round < depth) &&
+                ((mWindows[p.second->id ()].outstanding + round) < depth))
+                slots.push_back (p.second);
+        }
+    }
+
+    return slots;
+}
+
+void InboundLedger::sendNodeRequests (protocol::TMGetLedger& tmGL,
+    std::vector<SHAMapNodeID> const& nodeIDs,
+    std::vector <Peer::ptr> const& slots)
+{
+    assert (!slots.empty ());
+
+    std::size_t const perRequest = std::min <std::size_t> (requestWindowNodes,
+        (nodeIDs.size () + slots.size () - 1) / slots.size ());
+
+    auto slot = slots.begin ();
+
+    for (std::size_t i = 0;
+        (i < nodeIDs.size ()) && (slot != slots.end ()); ++slot)
+    {
+        Peer::ptr const& peer = *slot;
+        std::size_t const count = std::min (perRequest, nodeIDs.size () - i);
+
+        tmGL.clear_nodeids ();
+
+        for (std::size_t j = 0; j < count; ++j)
+            *tmGL.add_nodeids () = nodeIDs[i + j].getRawString ();
+
+        // If the peer has high latency, or we are not asking for a lot
+        // of entries, query extra deep
+        int depth = peer->isHighLatency () ? 2 : 1;
+
+        if (count <= fetchSmallNodes)
+            ++depth;
+
+        tmGL.set_querydepth (depth);
+
+        peer->send (std::make_shared<Message> (tmGL, protocol::mtGET_LEDGER));
+        ++mWindows[peer->id ()].outstanding;
+
+        i += count;
     }
 }
 
+void InboundLedger::sendLeafRequests (protocol::TMGetLedger const& tmGL,
+    std::vector<SHAMapNodeID>& nodeIDs, std::vector <Peer::ptr>& slots)
+{
+    std::vector<SHAMapNodeID> subtrees;
+    std::vector<SHAMapNodeID> rest;
+
+    for (auto const& id : nodeIDs)
+    {
+        if ((id.getDepth () >= snapshotMinDepth) &&
+                (mLeafRefused.count (id) == 0))
+            subtrees.push_back (id);
+        else
+            rest.push_back (id);
+    }
+
+    std::vector <Peer::ptr> unused;
+    auto subtree = subtrees.begin ();
+
+    for (auto const& peer : slots)
+    {
+        // liAS_LEAVES was introduced with RTXP/1.3
+        if ((subtree == subtrees.end ()) ||
+            !peer->supportsVersion (to_packed (ProtocolVersion (1, 3))))
+        {
+            unused.push_back (peer);
+            continue;
+        }
+
+        protocol::TMGetLedger tmLeaves (tmGL);
+        tmLeaves.set_itype (protocol::liAS_LEAVES);
+        tmLeaves.clear_querydepth ();
+        tmLeaves.clear_nodeids ();
+        *tmLeaves.add_nodeids () = subtree->getRawString ();
+
+        peer->send (std::make_shared<Message> (
+            tmLeaves, protocol::mtGET_LEDGER));
+        ++mWindows[peer->id ()].outstanding;
+        ++subtree;
+    }
+
+    if (m_journal.trace) m_journal.trace <<
+        "Sending " << (slots.size () - unused.size ()) <<
+            " AS leaves requests";
+
+    // Subtrees we had no slot for are fetched node by node
+    rest.insert (rest.end (), subtree, subtrees.end ());
+    nodeIDs.swap (rest);
+    slots.swap (unused);
+}
+
+// Rebuild the wire nodes of a state subtree from its leaves
+static bool
+rebuildSubtree (SHAMapNodeID const& nodeID, std::string const& leaves,
+    std::vector<SHAMapNodeID>& nodeIDs, std::vector<Blob>& nodes)
+{
+    std::vector<std::shared_ptr<SHAMapItem>> items;
+
+    try
+    {
+        SerialIter sit (leaves);
+
+        while (!sit.empty ())
+        {
+            uint256 const tag = sit.get256 ();
+
+            // Keys must be unique and in order
+            if (!items.empty () && (tag <= items.back ()->getTag ()))
+                return false;
+
+            items.push_back (std::make_shared<SHAMapItem> (tag, sit.getVL ()));
+        }
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    if (items.empty ())
+        return false;
+
+    if (items.size () == 1)
+    {
+        // A lone leaf sits at the node itself
+        SHAMapTreeNode leaf (items.front (),
+            SHAMapTreeNode::tnACCOUNT_STATE, 0);
+        Serializer s;
+        leaf.addRaw (s, snfWIRE);
+        nodeIDs.push_back (nodeID);
+        nodes.push_back (std::move (s.modData ()));
+        return true;
+    }
+
+    // Keys sharing the node's prefix produce the same subtree in any map,
+    // and its hashes are checked against the parent as the nodes are added.
+    SHAMap map (SHAMapType::STATE, getApp().family(),
+        deprecatedLogs().journal("SHAMap"));
+    map.setUnbacked ();
+
+    for (auto const& item : items)
+        map.addGiveItem (item, false, false);
+
+    return map.getNodeFat (nodeID, nodeIDs, nodes, true, 256);
+}
+
+void InboundLedger::takeLeaves (Job&, std::weak_ptr<Peer> wPeer,
+    std::shared_ptr<protocol::TMLedgerData> packet)
+{
+    Peer::ptr peer = wPeer.lock ();
+
+    if (!peer || isDone ())
+        return;
+
+    {
+        ScopedLockType sl (mLock);
+
+        RequestWindow& window = mWindows[peer->id ()];
+
+        if (window.outstanding > 0)
+            --window.outstanding;
+    }
+
+    SHAMapAddNode san;
+
+    for (auto const& node : packet->nodes ())
+    {
+        if (!node.has_nodeid ())
+        {
+            peer->charge (Resource::feeInvalidRequest);
+            return;
+        }
+
+        SHAMapNodeID nodeID (node.nodeid ().data (), node.nodeid ().size ());
+
+        if (!nodeID.isValid () || nodeID.isRoot ())
+        {
+            peer->charge (Resource::feeInvalidRequest);
+            return;
+        }
+
+        if (!node.has_nodedata ())
+        {
+            // The peer would not send this subtree whole, so its
+            // children will be asked for instead
+            ScopedLockType sl (mLock);
+            mLeafRefused.insert (nodeID);
+            continue;
+        }
+
+        std::vector<SHAMapNodeID> nodeIDs;
+        std::vector<Blob> nodes;
+        SHAMapAddNode subtree;
+
+        // Hashing the subtree is the bulk of the work and needs no lock
+        if (!rebuildSubtree (nodeID, node.nodedata (), nodeIDs, nodes) ||
+            !takeAsNode (nodeIDs, nodes, subtree))
+        {
+            if (m_journal.warning) m_journal.warning <<
+                "Got bad AS leaves for " << nodeID;
+            peer->charge (Resource::feeBadData);
+            return;
+        }
+
+        san += subtree;
+    }
+
+    {
+        ScopedLockType sl (mLock);
+        mWindows[peer->id ()].useful += san.getGood ();
+    }
+
+    if (m_journal.debug) m_journal.debug <<
+        "Ledger AS leaves stats: " << san.get();
+
+    trigger (peer);
+}
+
 /** Take ledger header data
     Call with a lock
 */
@@ -1019,6 +1360,15 @@ std::vector<InboundLedger::neededHash_t> InboundLedger::getNeededHashes ()
 bool InboundLedger::gotData (std::weak_ptr<Peer> peer,
     std::shared_ptr<protocol::TMLedgerData> data)
 {
+    if (data->type () == protocol::liAS_LEAVES)
+    {
+        // Each reply gets its own job so subtrees are rebuilt in parallel
+        getApp().getJobQueue ().addJob (jtLEDGER_DATA, "takeLeaves",
+            std::bind (&InboundLedger::takeLeaves, shared_from_this (),
+                std::placeholders::_1, peer, data));
+        return false;
+    }
+
     ScopedLockType sl (mReceivedDataLock);
 
     mReceivedData.push_back (PeerDataPairType (peer, data));
@@ -1043,6 +1393,12 @@ int InboundLedger::processData (std::shared_ptr<Peer> peer,
 {
     ScopedLockType sl (mLock);
 
+    // This answers one of the requests in the peer's window
+    RequestWindow& window = mWindows[peer->id ()];
+
+    if (window.outstanding > 0)
+        --window.outstanding;
+
     if (packet.type () == protocol::liBASE)
     {
         if (packet.nodes_size () < 1)
@@ -1142,7 +1498,10 @@ int InboundLedger::processData (std::shared_ptr<Peer> peer,
         }
 
         if (!ret.isInvalid ())
+        {
             progress ();
+            window.useful += ret.getGood ();
+        }
         else
             if (m_journal.debug) m_journal.debug <<
                 "Peer sends invalid node data";
@@ -24,6 +24,7 @@
 #include <ledger/Ledger.h>
 #include <network/overlay/PeerSet.h>
 #include <common/base/CountedObject.h>
+#include <common/base/UnorderedContainers.h>
 
 namespace truechain {
 
@@ -140,7 +141,32 @@ private:
                      SHAMapAddNode&);
     bool takeAsRootNode (Blob const& data, SHAMapAddNode&);
 
+    // Returns a peer for each request we may send now, best peers first
+    std::vector <Peer::ptr> getRequestSlots ();
+
+    // Spread a node request over the given request slots
+    void sendNodeRequests (protocol::TMGetLedger& tmGL,
+        std::vector<SHAMapNodeID> const& nodeIDs,
+        std::vector <Peer::ptr> const& slots);
+
+    // Ask for whole state subtrees as leaves, using up request slots
+    void sendLeafRequests (protocol::TMGetLedger const& tmGL,
+        std::vector<SHAMapNodeID>& nodeIDs, std::vector <Peer::ptr>& slots);
+
+    void takeLeaves (Job&, std::weak_ptr<Peer>,
+        std::shared_ptr<protocol::TMLedgerData>);
+
 private:
+    // The requests in flight to one peer
+    struct RequestWindow
+    {
+        // Requests sent that the peer has not yet answered
+        int outstanding = 0;
+
+        // Useful nodes the peer has sent us recently
+        int useful = 0;
+    };
+
     Ledger::pointer    mLedger;
     bool               mHaveHeader;
     bool               mHaveState;
@@ -151,7 +177,13 @@ private:
     std::uint32_t      mSeq;
     fcReason           mReason;
 
-    std::set <uint256> mRecentNodes;
+    // Nodes we have asked for, and when
+    hash_map <uint256, clock_type::time_point> mRecentNodes;
+
+    hash_map <Peer::id_t, RequestWindow> mWindows;
+
+    // Subtrees peers would not send us as leaves
+    std::set <SHAMapNodeID> mLeafRefused;
 
     // Data we have received from peers
     PeerSet::LockType mReceivedDataLock;
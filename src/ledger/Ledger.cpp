@@ -22,6 +22,7 @@
 
 #include <ledger/Ledger.h>
 #include <ledger/AcceptedLedger.h>
+#include <ledger/AccountTxIndex.h>
 #include <ledger/InboundLedgers.h>
 #include <ledger/LedgerMaster.h>
 #include <ledger/LedgerTiming.h>
@@ -370,6 +371,8 @@ bool Ledger::hasAccount (SkywellAddress const& accountID) const
 
 bool Ledger::addSLE (SLE const& sle)
 {
+    invalidateManagement (sle.getType ());
+
     SHAMapItem item (sle.getIndex(), sle.getSerializer());
     return mAccountStateMap->addItem(item, false, false);
 }
@@ -772,6 +775,9 @@ bool Ledger::saveValidatedLedger (bool current)
         tr.commit ();
     }
 
+    if (auto index = getApp().getAccountTxIndex ())
+        index->insert (*aLedger);
+
     {
         auto db (getApp().getLedgerDB ().checkoutDb ());
 
@@ -1095,6 +1101,8 @@ LedgerStateParms Ledger::writeBack (LedgerStateParms parms, SLE::ref entry)
 {
     bool create = false;
 
+    invalidateManagement (entry->getType ());
+
     if (!mAccountStateMap->hasItem (entry->getIndex ()))
     {
         if ((parms & lepCREATE) == 0)
@@ -1303,6 +1311,29 @@ void Ledger::visitStateItems (std::function<void (SLE::ref)> function) const
     }
 }
 
+void Ledger::visitStateItems (
+    int branch, std::function<void (SLE::ref)> function) const
+{
+    try
+    {
+        if (mAccountStateMap)
+        {
+            mAccountStateMap->visitLeaves(branch,
+                std::bind(&visitHelper, std::ref(function),
+                          std::placeholders::_1));
+        }
+    }
+    catch (SHAMapMissingNode&)
+    {
+        if (mHash.isNonZero ())
+        {
+            getApp().getInboundLedgers().acquire(
+                mHash, mLedgerSeq, InboundLedger::fcGENERIC);
+        }
+        throw;
+    }
+}
+
 uint256 Ledger::getFirstLedgerIndex () const
 {
     std::shared_ptr<SHAMapItem> node = mAccountStateMap->peekFirstItem ();
@@ -1856,32 +1887,83 @@ uint256 Ledger::getBlackListIndex (const Account& uAccountID)
 uint256 Ledger::getLedgerManageFeeIndex ()
 {
     // get the index of the node that holds the fee schedul
-    Serializer s (2);
-    s.add16 (spaceManageFee);
-    return s.getSHA512Half ();
+    static uint256 const index = []
+    {
+        Serializer s (2);
+        s.add16 (spaceManageFee);
+        return s.getSHA512Half ();
+    }();
+
+    return index;
 }
 
 uint256 Ledger::getLedgerManageIssuerIndex ()
 {
     // get the index of the node that holds the fee schedul
-    Serializer s (2);
-    s.add16 (spaceIssuer);
-    return s.getSHA512Half ();
+    static uint256 const index = []
+    {
+        Serializer s (2);
+        s.add16 (spaceIssuer);
+        return s.getSHA512Half ();
+    }();
+
+    return index;
 }
 
+void Ledger::invalidateManagement (LedgerEntryType type)
+{
+    if (type != ltBLACKLIST && type != ltMANAGE_FEE && type != ltMANAGE_ISSUER)
+        return;
+
+    std::lock_guard <std::mutex> sl (mManageLock);
+
+    switch (type)
+    {
+    case ltBLACKLIST:
+        mManagement.blackList.clear ();
+        break;
+
+    case ltMANAGE_FEE:
+        mManagement.haveFeeAccount = false;
+        break;
+
+    case ltMANAGE_ISSUER:
+        mManagement.haveIssuerAccount = false;
+        break;
+
+    default:
+        break;
+    }
+}
 
 bool Ledger::checkBlackList (const Account& uAccountID)
 {
+    {
+        std::lock_guard <std::mutex> sl (mManageLock);
+        auto const it = mManagement.blackList.find (uAccountID);
+
+        if (it != mManagement.blackList.end ())
+            return it->second;
+    }
+
 	LedgerStateParms p = lepNONE;
 	SLE::pointer sle = getASNode (p, Ledger::getBlackListIndex (uAccountID), ltBLACKLIST);
-	if(sle)
-		return true;
-	else
-		return false;
+	bool const listed = static_cast<bool> (sle);
+
+    std::lock_guard <std::mutex> sl (mManageLock);
+    mManagement.blackList.emplace (uAccountID, listed);
+    return listed;
 }
 
 Account Ledger::getFeeAccountID ()
 {
+    {
+        std::lock_guard <std::mutex> sl (mManageLock);
+
+        if (mManagement.haveFeeAccount)
+            return mManagement.feeAccount;
+    }
+
 	Account feeaccountid = getConfig().FEE_ACCOUNTID.getAccountID();
 	LedgerStateParms p = lepNONE;
 	SLE::pointer sle = getASNode (p, Ledger::getLedgerManageFeeIndex (), ltMANAGE_FEE);
@@ -1892,8 +1974,10 @@ Account Ledger::getFeeAccountID ()
 			feeaccountid = sle->getFieldAccount160 (sfFeeAccountID);
 	}
 
-	mFeeAccountID = feeaccountid;
-	return mFeeAccountID;
+    std::lock_guard <std::mutex> sl (mManageLock);
+    mManagement.haveFeeAccount = true;
+    mManagement.feeAccount = feeaccountid;
+    return feeaccountid;
 }
 Account Ledger::getManagerAccountID ()
 {
@@ -1912,6 +1996,13 @@ Account Ledger::getManagerAccountID ()
 
 Account Ledger::getIssuerOpAccountID ()
 {
+    {
+        std::lock_guard <std::mutex> sl (mManageLock);
+
+        if (mManagement.haveIssuerAccount)
+            return mManagement.issuerAccount;
+    }
+
 	Account issueraccountid = getConfig().SISSUER_ACCOUNTID.getAccountID();
 	LedgerStateParms p = lepNONE;
 	SLE::pointer sle = getASNode (p, Ledger::getLedgerManageIssuerIndex (), ltMANAGE_ISSUER);
@@ -1921,7 +2012,11 @@ Account Ledger::getIssuerOpAccountID ()
 		if (sle->getFieldIndex (sfIssuerAccountID) != -1)
 			issueraccountid = sle->getFieldAccount160 (sfIssuerAccountID);
 	}
-	return issueraccountid;
+
+    std::lock_guard <std::mutex> sl (mManageLock);
+    mManagement.haveIssuerAccount = true;
+    mManagement.issuerAccount = issueraccountid;
+    return issueraccountid;
 }
 
 Ledger::StaticLockType Ledger::sPendingSaveLock;
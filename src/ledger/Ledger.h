@@ -21,6 +21,7 @@
 #define SKYWELL_APP_LEDGER_LEDGER_H_INCLUDED
 
 #include <set>
+#include <mutex>
 #include <transaction/tx/Transaction.h>
 #include <transaction/tx/TransactionMeta.h>
 #include <common/misc/AccountState.h>
@@ -29,6 +30,7 @@
 #include <protocol/STLedgerEntry.h>
 #include <protocol/Serializer.h>
 #include <protocol/Book.h>
+#include <common/base/UnorderedContainers.h>
 
 namespace truechain {
 
@@ -300,6 +302,11 @@ public:
         std::function <bool (SLE::ref)>) const;
     void visitStateItems (std::function<void (SLE::ref)>) const;
 
+    /** Visit the state entries below one branch of the state map's root.
+        Sixteen calls, one per branch, cover the whole state.
+    */
+    void visitStateItems (int branch, std::function<void (SLE::ref)>) const;
+
     // database functions (low-level)
     static Ledger::pointer loadByIndex (std::uint32_t ledgerIndex);
     static Ledger::pointer loadByHash (uint256 const& ledgerHash);
@@ -434,6 +441,11 @@ public:
     Account getManagerAccountID ();
     Account getIssuerOpAccountID ();
 
+    /** Forget the management settings read from this ledger.
+        Called whenever an entry of the given type is written or deleted.
+    */
+    void invalidateManagement (LedgerEntryType type);
+
 protected:
     SLE::pointer getASNode (
         LedgerStateParms& parms, uint256 const& nodeID, LedgerEntryType let) const;
@@ -481,7 +493,22 @@ private:
     // Skywell cost of the reference transaction
     std::uint64_t mBaseFee;
 
-    Account    mFeeAccountID;
+    // The fee and issuer accounts and the blacklist probes made against
+    // this ledger. They only change when a management entry is written,
+    // so they are kept until then.
+    struct Management
+    {
+        bool haveFeeAccount = false;
+        Account feeAccount;
+
+        bool haveIssuerAccount = false;
+        Account issuerAccount;
+
+        hash_map <Account, bool> blackList;
+    };
+
+    std::mutex mutable mManageLock;
+    Management mManagement;
 
     std::shared_ptr<SHAMap> mTransactionMap;
     std::shared_ptr<SHAMap> mAccountStateMap;
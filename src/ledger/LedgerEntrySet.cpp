@@ -58,7 +58,9 @@ void LedgerEntrySet::clear ()
 
 LedgerEntrySet LedgerEntrySet::duplicate () const
 {
-    return LedgerEntrySet (mLedger, mEntries, mSet, mSeq + 1, mDeferredCredits);
+    LedgerEntrySet les (mLedger, mEntries, mSet, mSeq + 1, mDeferredCredits);
+    les.mReads = mReads;
+    return les;
 }
 
 void LedgerEntrySet::swapWith (LedgerEntrySet& e)
@@ -70,28 +72,34 @@ void LedgerEntrySet::swapWith (LedgerEntrySet& e)
     swap (mParams, e.mParams);
     swap (mSeq, e.mSeq);
     swap (mDeferredCredits, e.mDeferredCredits);
+    swap (mReads, e.mReads);
 }
 
 // Find an entry in the set.  If it has the wrong sequence number, copy it and update the sequence number.
 // This is basically: copy-on-read.
 SLE::pointer LedgerEntrySet::getEntry (uint256 const& index, LedgerEntryAction& action)
 {
-    auto it = mEntries.find (index);
+    LedgerEntrySetEntries const& entries = mEntries;
+    auto const found = entries.find (index);
 
-    if (it == mEntries.end ())
+    if (found == entries.end ())
     {
         action = taaNONE;
         return SLE::pointer ();
     }
 
-    if (it->second.mSeq != mSeq)
-    {
-        assert (it->second.mSeq < mSeq);
-        it->second.mEntry = std::make_shared<STLedgerEntry> (*it->second.mEntry);
-        it->second.mSeq = mSeq;
-    }
+    action = found->second.mAction;
+
+    // Only an entry from before the last checkpoint needs copying
+    if (found->second.mSeq == mSeq)
+        return found->second.mEntry;
+
+    auto it = mEntries.find (index);
+
+    assert (it->second.mSeq < mSeq);
+    it->second.mEntry = std::make_shared<STLedgerEntry> (*it->second.mEntry);
+    it->second.mSeq = mSeq;
 
-    action = it->second.mAction;
     return it->second.mEntry;
 }
 
@@ -118,6 +126,9 @@ SLE::pointer LedgerEntrySet::entryCache (LedgerEntryType letType, uint256 const&
             assert (action != taaDELETE);
             sleEntry = mImmutable ? mLedger->getSLEi (index) : mLedger->getSLE (index);
 
+            if (mReads)
+                mReads->keys.insert (index);
+
             if (sleEntry)
                 entryCache (sleEntry);
         }
@@ -128,6 +139,23 @@ SLE::pointer LedgerEntrySet::entryCache (LedgerEntryType letType, uint256 const&
     return sleEntry;
 }
 
+// The ledger caches these, so they never pass through entryCache
+Account LedgerEntrySet::getFeeAccountID ()
+{
+    if (mReads)
+        mReads->keys.insert (Ledger::getLedgerManageFeeIndex ());
+
+    return mLedger->getFeeAccountID ();
+}
+
+Account LedgerEntrySet::getIssuerOpAccountID ()
+{
+    if (mReads)
+        mReads->keys.insert (Ledger::getLedgerManageIssuerIndex ());
+
+    return mLedger->getIssuerOpAccountID ();
+}
+
 void LedgerEntrySet::entryCache (SLE::ref sle)
 {
     assert (mLedger);
@@ -983,17 +1011,21 @@ uint256 LedgerEntrySet::getNextLedgerIndex (uint256 const& uHash)
 {
     // find next node in ledger that isn't deleted by LES
     uint256 ledgerNext = uHash;
-    std::map<uint256, LedgerEntrySetEntry>::const_iterator it;
+    LedgerEntrySetEntries const& entries = mEntries;
+    const_iterator it;
 
     do
     {
         ledgerNext = mLedger->getNextLedgerIndex (ledgerNext);
-        it  = mEntries.find (ledgerNext);
+        it  = entries.find (ledgerNext);
     }
-    while ((it != mEntries.end ()) && (it->second.mAction == taaDELETE));
+    while ((it != entries.end ()) && (it->second.mAction == taaDELETE));
+
+    if (mReads)
+        mReads->ranges.emplace_back (uHash, ledgerNext);
 
     // find next node in LES that isn't deleted
-    for (it = mEntries.upper_bound (uHash); it != mEntries.end (); ++it)
+    for (it = entries.upper_bound (uHash); it != entries.end (); ++it)
     {
         // node found in LES, node found in ledger, return earliest
         if (it->second.mAction != taaDELETE)
@@ -2211,11 +2243,15 @@ Account const& account, STAmount const& saTakerGets)
 	int freezerelation = 3;
     if(!saTakerGets.isNative ())
     {
-	Account mIssuerAccountID = mLedger->getIssuerOpAccountID ();
+	Account mIssuerAccountID = getIssuerOpAccountID ();
 	if (mIssuerAccountID == account)
 		return tesSUCCESS;
     }
 
+    // Owner directories are walked in the ledger, not through this set
+    if (mReads)
+        mReads->untracked = true;
+
     mLedger->visitAccountItems (account, 
         [&offers](SLE::ref offer)
         {
@@ -2303,6 +2339,10 @@ Account const& account, STAmount const& saTakerGets)
 Account LedgerEntrySet::AuthorizeAccountGet (Account const& account, Currency const& currency)
 {
     std::vector <SLE::pointer> TieAccount;
+
+    if (mReads)
+        mReads->untracked = true;
+
     mLedger->visitAccountItems (account, 
         [&TieAccount](SLE::ref sleCur)
         {
@@ -24,7 +24,11 @@
 #include <ledger/Ledger.h>
 #include <ledger/DeferredCredits.h>
 #include <common/base/CountedObject.h>
+#include <common/base/UnorderedContainers.h>
 #include <protocol/STLedgerEntry.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 namespace truechain {
 
@@ -88,6 +92,169 @@ public:
     }
 };
 
+/** The entries of a LedgerEntrySet, ordered by key.
+
+    Entries are kept in a sorted vector, which is cheap to copy and to
+    search for the few dozen entries a transaction touches. Copies share
+    the vector until one of them is modified, so checkpointing a set
+    with duplicate () costs nothing until the checkpoint is used.
+
+    Modifying the entries, including through a non-const iterator,
+    invalidates iterators.
+*/
+class LedgerEntrySetEntries
+{
+public:
+    typedef std::pair<uint256, LedgerEntrySetEntry> value_type;
+    typedef std::vector<value_type> container;
+    typedef container::iterator iterator;
+    typedef container::const_iterator const_iterator;
+
+    bool empty () const
+    {
+        return !mItems || mItems->empty ();
+    }
+
+    std::size_t size () const
+    {
+        return mItems ? mItems->size () : 0;
+    }
+
+    void clear ()
+    {
+        // Keep the storage for reuse unless a copy still needs it
+        if (mItems && (mItems.use_count () == 1))
+            mItems->clear ();
+        else
+            mItems.reset ();
+    }
+
+    void swap (LedgerEntrySetEntries& other)
+    {
+        mItems.swap (other.mItems);
+    }
+
+    const_iterator begin () const
+    {
+        return items ().cbegin ();
+    }
+
+    const_iterator end () const
+    {
+        return items ().cend ();
+    }
+
+    iterator begin ()
+    {
+        return mutate ().begin ();
+    }
+
+    iterator end ()
+    {
+        return mutate ().end ();
+    }
+
+    const_iterator find (uint256 const& key) const
+    {
+        auto const it = lower_bound (key);
+        return ((it != end ()) && (it->first == key)) ? it : end ();
+    }
+
+    iterator find (uint256 const& key)
+    {
+        auto& items = mutate ();
+        auto const it = std::lower_bound (items.begin (), items.end (),
+            key, keyLess ());
+        return ((it != items.end ()) && (it->first == key)) ?
+            it : items.end ();
+    }
+
+    const_iterator lower_bound (uint256 const& key) const
+    {
+        return std::lower_bound (begin (), end (), key, keyLess ());
+    }
+
+    const_iterator upper_bound (uint256 const& key) const
+    {
+        return std::upper_bound (begin (), end (), key, keyLess ());
+    }
+
+    std::pair<iterator, bool> insert (value_type const& value)
+    {
+        auto& items = mutate ();
+        auto const it = std::lower_bound (items.begin (), items.end (),
+            value.first, keyLess ());
+
+        if ((it != items.end ()) && (it->first == value.first))
+            return std::make_pair (it, false);
+
+        return std::make_pair (items.insert (it, value), true);
+    }
+
+    iterator erase (iterator it)
+    {
+        return mutate ().erase (it);
+    }
+
+private:
+    struct keyLess
+    {
+        bool operator() (value_type const& v, uint256 const& key) const
+        {
+            return v.first < key;
+        }
+
+        bool operator() (uint256 const& key, value_type const& v) const
+        {
+            return key < v.first;
+        }
+    };
+
+    container const& items () const
+    {
+        static container const none;
+        return mItems ? *mItems : none;
+    }
+
+    // The vector, unshared so that it can be modified
+    container& mutate ()
+    {
+        if (!mItems)
+            mItems = std::make_shared<container> ();
+        else if (mItems.use_count () > 1)
+            mItems = std::make_shared<container> (*mItems);
+
+        return *mItems;
+    }
+
+    std::shared_ptr<container> mItems;
+};
+
+/** The ledger keys a LedgerEntrySet read from its ledger.
+
+    Lets a caller tell whether a transaction applied against one ledger
+    would have seen the same entries in another.
+*/
+struct LedgerEntryReads
+{
+    // Keys looked up, whether or not the entry existed
+    hash_set<uint256> keys;
+
+    // Successor lookups; nothing existed after first, up to and
+    // including last. A zero last means the lookup ran off the end.
+    std::vector<std::pair<uint256, uint256>> ranges;
+
+    // Something was read bypassing the set
+    bool untracked = false;
+
+    void clear ()
+    {
+        keys.clear ();
+        ranges.clear ();
+        untracked = false;
+    }
+};
+
 /** An LES is a LedgerEntrySet.
 
     It's a view into a ledger used while a transaction is processing.
@@ -134,6 +301,12 @@ public:
         return mSeq;
     }
 
+    // Record what this set, and sets duplicated from it, read from the ledger
+    void trackReads (LedgerEntryReads* reads)
+    {
+        mReads = reads;
+    }
+
     void bumpSeq ()
     {
         ++mSeq;
@@ -149,6 +322,10 @@ public:
         return mLedger;
     }
 
+    // The management accounts, read from the ledger as this set would
+    Account getFeeAccountID ();
+    Account getIssuerOpAccountID ();
+
     // basic entry functions
     SLE::pointer getEntry (uint256 const& index, LedgerEntryAction&);
 
@@ -270,8 +447,8 @@ public:
     void calcRawMeta (Serializer&, TER result, std::uint32_t index);
 
     // iterator functions
-    typedef std::map<uint256, LedgerEntrySetEntry>::iterator iterator;
-    typedef std::map<uint256, LedgerEntrySetEntry>::const_iterator const_iterator;
+    typedef LedgerEntrySetEntries::iterator iterator;
+    typedef LedgerEntrySetEntries::const_iterator const_iterator;
 
     bool empty () const
     {
@@ -279,19 +456,19 @@ public:
     }
     const_iterator cbegin () const
     {
-        return mEntries.cbegin ();
+        return mEntries.begin ();
     }
     const_iterator cend () const
     {
-        return mEntries.cend ();
+        return mEntries.end ();
     }
     const_iterator begin () const
     {
-        return mEntries.cbegin ();
+        return mEntries.begin ();
     }
     const_iterator end () const
     {
-        return mEntries.cend ();
+        return mEntries.end ();
     }
     iterator begin ()
     {
@@ -322,7 +499,7 @@ public:
     Account AuthorizeAccountGet (Account const& account, Currency const& currency);
 private:
     Ledger::pointer mLedger;
-    std::map<uint256, LedgerEntrySetEntry>  mEntries; // cannot be unordered!
+    LedgerEntrySetEntries mEntries; // cannot be unordered!
     // Defers credits made to accounts until later
     boost::optional<DeferredCredits> mDeferredCredits;
 
@@ -332,9 +509,10 @@ private:
     TransactionEngineParams mParams;
     int mSeq;
     bool mImmutable;
+    LedgerEntryReads* mReads = nullptr;
 
     LedgerEntrySet (
-        Ledger::ref ledger, const std::map<uint256, LedgerEntrySetEntry>& e,
+        Ledger::ref ledger, LedgerEntrySetEntries const& e,
         const TransactionMetaSet & s, int m, boost::optional<DeferredCredits> const& ft) :
         mLedger (ledger), mEntries (e), mDeferredCredits (ft), mSet (s), mParams (tapNONE),
         mSeq (m), mImmutable (false)
@@ -415,6 +415,8 @@ public:
 		if (didApply)
 		{
 			mCurrentLedger.set(ledger);
+
+			// Only queued here; ledger is not touched again after this
 			getApp().getOPs().pubProposedTransaction(ledger, txn, result);
 		}
 		return result;
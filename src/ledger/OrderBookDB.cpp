@@ -24,13 +24,17 @@
 #include <common/base/Log.h>
 #include <common/core/Config.h>
 #include <common/core/JobQueue.h>
+#include <common/core/WorkerPool.h>
 #include <protocol/Indexes.h>
+#include <algorithm>
+#include <atomic>
 
 namespace truechain {
 
 OrderBookDB::OrderBookDB (Stoppable& parent)
     : Stoppable ("OrderBookDB", parent)
     , mSeq (0)
+    , mUpdateSeq (0)
 {
 }
 
@@ -46,21 +50,19 @@ void OrderBookDB::setup (Ledger::ref ledger)
         ScopedLockType sl (mLock);
         auto seq = ledger->getLedgerSeq ();
 
-        // Do a full update every 256 ledgers
-        if (mSeq != 0)
-        {
-            if (seq == mSeq)
-                return;
-            if ((seq > mSeq) && ((seq - mSeq) < 256))
-                return;
-            if ((seq < mSeq) && ((mSeq - seq) < 16))
-                return;
-        }
+        // The books are kept current from the metadata of every published
+        // ledger, so only rescan if we have nothing or skipped ledgers
+        if ((mSeq != 0) && (seq <= mSeq))
+            return;
+        if ((mUpdateSeq != 0) && (seq <= mUpdateSeq))
+            return;
 
         WriteLog (lsDEBUG, OrderBookDB)
-            << "Advancing from " << mSeq << " to " << seq;
+            << "Rebuilding from " << seq << " (was " << mSeq << ")";
 
         mSeq = seq;
+        mUpdateSeq = seq;
+        mPending.clear ();
     }
 
     if (getConfig().RUN_STANDALONE)
@@ -70,71 +72,111 @@ void OrderBookDB::setup (Ledger::ref ledger)
             std::bind(&OrderBookDB::update, this, ledger));
 }
 
-static void updateHelper (SLE::ref entry,
-    hash_set< uint256 >& seen,
-    OrderBookDB::IssueToOrderBook& destMap,
-    OrderBookDB::IssueToOrderBook& sourceMap,
-    hash_set< Issue >& SWTBooks,
-    int& books)
+// Is this entry the first page of a quality directory, and for what book?
+static bool getBookRoot (SLE::ref entry, Book& book)
 {
-    if (entry->getType () == ltDIR_NODE &&
-        entry->isFieldPresent (sfExchangeRate) &&
-        entry->getFieldH256 (sfRootIndex) == entry->getIndex())
-    {
-        Book book;
-        book.in.currency.copyFrom (entry->getFieldH160 (sfTakerPaysCurrency));
-        book.in.account.copyFrom (entry->getFieldH160 (sfTakerPaysIssuer));
-        book.out.account.copyFrom (entry->getFieldH160 (sfTakerGetsIssuer));
-        book.out.currency.copyFrom (entry->getFieldH160 (sfTakerGetsCurrency));
-
-        uint256 index = getBookBase (book);
-        if (seen.insert (index).second)
-        {
-            auto orderBook = std::make_shared<OrderBook> (index, book);
-            sourceMap[book.in].push_back (orderBook);
-            destMap[book.out].push_back (orderBook);
-            if (isSWT(book.out))
-                SWTBooks.insert(book.in);
-            ++books;
-        }
-    }
+    if (entry->getType () != ltDIR_NODE ||
+        !entry->isFieldPresent (sfExchangeRate) ||
+        entry->getFieldH256 (sfRootIndex) != entry->getIndex())
+        return false;
+
+    book.in.currency.copyFrom (entry->getFieldH160 (sfTakerPaysCurrency));
+    book.in.account.copyFrom (entry->getFieldH160 (sfTakerPaysIssuer));
+    book.out.account.copyFrom (entry->getFieldH160 (sfTakerGetsIssuer));
+    book.out.currency.copyFrom (entry->getFieldH160 (sfTakerGetsCurrency));
+    return true;
 }
 
 void OrderBookDB::update (Ledger::pointer ledger)
 {
-    hash_set< uint256 > seen;
-    OrderBookDB::IssueToOrderBook destMap;
-    OrderBookDB::IssueToOrderBook sourceMap;
-    hash_set< Issue > SWTBooks;
-
     WriteLog (lsDEBUG, OrderBookDB) << "OrderBookDB::update>";
 
-    // walk through the entire ledger looking for orderbook entries
-    int books = 0;
+    // Walk the sixteen subtrees below the state map's root concurrently,
+    // each one collecting the book directories it finds
+    std::vector<std::vector<Book>> found (16);
+    std::atomic<int> nextBranch (0);
+    std::atomic<bool> missing (false);
 
-    try
+    auto scan = [&] ()
     {
-        ledger->visitStateItems(std::bind(&updateHelper, std::placeholders::_1,
-                                          std::ref(seen), std::ref(destMap),
-            std::ref(sourceMap), std::ref(SWTBooks), std::ref(books)));
-    }
-    catch (const SHAMapMissingNode&)
+        int branch;
+        while (!missing && ((branch = nextBranch++) < 16))
+        {
+            auto& books = found[branch];
+            try
+            {
+                ledger->visitStateItems (branch, [&books] (SLE::ref entry)
+                {
+                    Book book;
+                    if (getBookRoot (entry, book))
+                        books.push_back (book);
+                });
+            }
+            catch (SHAMapMissingNode const&)
+            {
+                missing = true;
+            }
+        }
+    };
+
+    runParallel (parallelThreadCount (found.size ()), scan);
+
+    if (missing)
     {
         WriteLog (lsINFO, OrderBookDB)
             << "OrderBookDB::update encountered a missing node";
         ScopedLockType sl (mLock);
-        mSeq = 0;
+        if (mUpdateSeq == ledger->getLedgerSeq ())
+        {
+            mSeq = 0;
+            mUpdateSeq = 0;
+            mPending.clear ();
+        }
         return;
     }
 
+    hash_set< uint256 > seen;
+    OrderBookDB::IssueToOrderBook destMap;
+    OrderBookDB::IssueToOrderBook sourceMap;
+    hash_set< Issue > SWTBooks;
+    int books = 0;
+
+    for (auto const& branch : found)
+    {
+        for (auto const& book : branch)
+        {
+            uint256 index = getBookBase (book);
+            if (seen.insert (index).second)
+            {
+                auto orderBook = std::make_shared<OrderBook> (index, book);
+                sourceMap[book.in].push_back (orderBook);
+                destMap[book.out].push_back (orderBook);
+                if (isSWT(book.out))
+                    SWTBooks.insert(book.in);
+                ++books;
+            }
+        }
+    }
+
     WriteLog (lsDEBUG, OrderBookDB)
         << "OrderBookDB::update< " << books << " books found";
     {
         ScopedLockType sl (mLock);
 
+        // A newer rebuild has started; leave the books to it
+        if (mUpdateSeq != ledger->getLedgerSeq ())
+            return;
+
         mSWTBooks.swap(SWTBooks);
         mSourceMap.swap(sourceMap);
         mDestMap.swap(destMap);
+
+        // Catch up with the ledgers published while we were scanning
+        for (auto const& delta : mPending)
+            applyDelta (delta);
+
+        mPending.clear ();
+        mUpdateSeq = 0;
     }
     getApp().getLedgerMaster().newOrderBookDB();
 }
@@ -174,6 +216,49 @@ void OrderBookDB::addOrderBook(Book const& book)
         mSWTBooks.insert(book.in);
 }
 
+void OrderBookDB::rawRemoveBook (Book const& book)
+{
+    uint256 const index = getBookBase (book);
+    auto isBook = [&index] (OrderBook::ref ob)
+    {
+        return ob->getBookBase () == index;
+    };
+
+    auto source = mSourceMap.find (book.in);
+    if (source != mSourceMap.end ())
+    {
+        auto& list = source->second;
+        list.erase (std::remove_if (list.begin (), list.end (), isBook),
+            list.end ());
+
+        if (isSWT (book.out) && std::none_of (list.begin (), list.end (),
+                [] (OrderBook::ref ob) { return isSWT (ob->getCurrencyOut ()); }))
+            mSWTBooks.erase (book.in);
+
+        if (list.empty ())
+            mSourceMap.erase (source);
+    }
+
+    auto dest = mDestMap.find (book.out);
+    if (dest != mDestMap.end ())
+    {
+        auto& list = dest->second;
+        list.erase (std::remove_if (list.begin (), list.end (), isBook),
+            list.end ());
+
+        if (list.empty ())
+            mDestMap.erase (dest);
+    }
+}
+
+void OrderBookDB::applyDelta (BookDelta const& delta)
+{
+    if (delta.removed)
+        rawRemoveBook (delta.book);
+    else
+        addOrderBook (delta.book);
+}
+
 // return list of all orderbooks that want this issuerID and currencyID
 OrderBook::List OrderBookDB::getBooksByTakerPays (Issue const& issue)
 {
@@ -222,6 +307,25 @@ BookListeners::pointer OrderBookDB::getBookListeners (Book const& book)
     return ret;
 }
 
+// Read the book a quality directory belongs to from its metadata fields.
+// Created nodes omit default values, so absent currencies and issuers are SWT.
+static bool getMetaBook (STObject const& fields, Book& book)
+{
+    if (!fields.isFieldPresent (sfExchangeRate))
+        return false;
+
+    auto field = [&fields] (SField const& f)
+    {
+        return fields.isFieldPresent (f) ? fields.getFieldH160 (f) : uint160 ();
+    };
+
+    book.in.currency.copyFrom (field (sfTakerPaysCurrency));
+    book.in.account.copyFrom (field (sfTakerPaysIssuer));
+    book.out.account.copyFrom (field (sfTakerGetsIssuer));
+    book.out.currency.copyFrom (field (sfTakerGetsCurrency));
+    return true;
+}
+
 // Based on the meta, send the meta to the streams that are listening.
 // We need to determine which streams a given meta effects.
 void OrderBookDB::processTxn (
@@ -229,6 +333,58 @@ void OrderBookDB::processTxn (
 {
     ScopedLockType sl (mLock);
 
+    auto const seq = ledger->getLedgerSeq ();
+
+    // Keep the books current: a book appears with its first quality
+    // directory and goes when its last one is deleted. Failed
+    // transactions can remove offers too, so look at every result.
+    for (auto& node : alTx.getMeta ()->getNodes ())
+    {
+        try
+        {
+            if (node.getFieldU16 (sfLedgerEntryType) != ltDIR_NODE)
+                continue;
+
+            BookDelta delta {seq, Book (), false};
+            STObject const* data = nullptr;
+
+            if (node.getFName () == sfCreatedNode)
+                data = dynamic_cast<const STObject*> (
+                    node.peekAtPField (sfNewFields));
+            else if (node.getFName () == sfDeletedNode)
+            {
+                data = dynamic_cast<const STObject*> (
+                    node.peekAtPField (sfFinalFields));
+                delta.removed = true;
+            }
+
+            if (!data || !getMetaBook (*data, delta.book))
+                continue;
+
+            if (delta.removed)
+            {
+                // Other qualities may remain in this book
+                uint256 const base = getBookBase (delta.book);
+                if (ledger->getNextLedgerIndex (
+                        base, getQualityNext (base)).isNonZero ())
+                    continue;
+            }
+
+            applyDelta (delta);
+
+            if ((mUpdateSeq != 0) && (seq > mUpdateSeq))
+                mPending.push_back (delta);
+        }
+        catch (...)
+        {
+            WriteLog (lsINFO, OrderBookDB)
+                << "Directory fields not found in OrderBookDB::processTxn";
+        }
+    }
+
+    if (seq > mSeq)
+        mSeq = seq;
+
     if (alTx.getResult () == tesSUCCESS)
     {
         // Check if this is an offer or an offer cancel or a payment that
@@ -32,6 +32,11 @@ class OrderBookDB
 public:
     explicit OrderBookDB (Stoppable& parent);
 
+    /** Rebuild the index from a ledger's state if it is not current.
+        Once built, the index follows each validated ledger through
+        processTxn, so this only rescans on a cold start, after invalidate
+        or when publication skips ledgers.
+    */
     void setup (Ledger::ref ledger);
     void update (Ledger::pointer ledger);
     void invalidate ();
@@ -51,7 +56,9 @@ public:
     BookListeners::pointer getBookListeners (Book const&);
     BookListeners::pointer makeBookListeners (Book const&);
 
-    // see if this txn effects any orderbook
+    /** Update the books from a validated transaction's metadata and send
+        it to the streams of the books it affects.
+    */
     void processTxn (
         Ledger::ref ledger, const AcceptedLedgerTx& alTx,
         Json::Value const& jvObj);
@@ -60,6 +67,17 @@ public:
 
 private:
     void rawAddBook(Book const&);
+    void rawRemoveBook(Book const&);
+
+    // A book created or emptied by a ledger published during a rebuild
+    struct BookDelta
+    {
+        std::uint32_t seq;
+        Book book;
+        bool removed;
+    };
+
+    void applyDelta (BookDelta const&);
 
     // by ci/ii
     IssueToOrderBook mSourceMap;
@@ -79,7 +97,12 @@ private:
 
     BookToListenersMap mListeners;
 
+    // The ledger the books reflect
     std::uint32_t mSeq;
+
+    // The ledger being rescanned, and the changes to replay on top of it
+    std::uint32_t mUpdateSeq;
+    std::vector<BookDelta> mPending;
 };
 
 } // truechain
@@ -37,6 +37,7 @@
 #include <data/nodestore/DummyScheduler.h>
 #include <data/nodestore/Manager.h>
 #include <ledger/AcceptedLedger.h>
+#include <ledger/AccountTxIndex.h>
 #include <ledger/InboundLedgers.h>
 #include <ledger/LedgerMaster.h>
 #include <ledger/OrderBookDB.h>
@@ -296,6 +297,7 @@ public:
     std::unique_ptr <DatabaseCon> mTxnDB;
     std::unique_ptr <DatabaseCon> mLedgerDB;
     std::unique_ptr <DatabaseCon> mWalletDB;
+    std::unique_ptr <AccountTxIndex> m_accountTxIndex;
     std::unique_ptr <Overlay> m_overlay;
     std::vector <std::unique_ptr<beast::Stoppable>> websocketServers_;
 
@@ -624,6 +626,10 @@ public:
         assert (mWalletDB.get() != nullptr);
         return *mWalletDB;
     }
+    AccountTxIndex* getAccountTxIndex ()
+    {
+        return m_accountTxIndex.get ();
+    }
 
     bool isShutdown ()
     {
@@ -747,6 +753,16 @@ public:
         mTxnDB->setupCheckpointing (m_jobQueue.get());
         mLedgerDB->setupCheckpointing (m_jobQueue.get());
 
+        {
+            std::string path;
+            if (get_if_exists (getConfig ().section (SECTION_ACCOUNT_TX_DB),
+                    "path", path))
+            {
+                m_accountTxIndex = make_AccountTxIndex (
+                    path, m_logs.journal ("AccountTxIndex"));
+            }
+        }
+
         if (!getConfig ().RUN_STANDALONE)
             updateTables ();
 
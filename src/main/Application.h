@@ -38,6 +38,7 @@ namespace NodeStore { class Database; }
 namespace RPC { class Manager; }
 
 //  TODO Fix forward declares required for header dependency loops
+class AccountTxIndex;
 class AmendmentTable;
 class CollectorManager;
 namespace shamap {
@@ -119,6 +120,9 @@ public:
     virtual DatabaseCon& getTxnDB () = 0;
     virtual DatabaseCon& getLedgerDB () = 0;
 
+    /** The account transaction index, or nullptr if not configured. */
+    virtual AccountTxIndex* getAccountTxIndex () = 0;
+
     virtual std::chrono::milliseconds getIOLatency () = 0;
 
     /** Retrieve the "wallet database"
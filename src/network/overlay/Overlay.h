@@ -33,6 +33,7 @@
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <functional>
+#include <set>
 
 namespace boost { namespace asio { namespace ssl { class context; } } }
 
@@ -156,6 +157,15 @@ public:
     relay (protocol::TMValidation& m,
         uint256 const& uid) = 0;
 
+    /** Relay a transaction to every peer not in skip.
+        Transactions are held briefly and sent as one TMTransactions
+        message to peers which understand batches.
+    */
+    virtual
+    void
+    relay (protocol::TMTransaction const& m,
+        std::set<Peer::id_t>&& skip) = 0;
+
     /** Visit every active peer and return a value
         The functor must:
         - Be callable as:
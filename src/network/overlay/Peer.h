@@ -81,6 +81,11 @@ public:
     bool
     isHighLatency() const = 0;
 
+    /** Returns our priority for querying this peer, higher is better. */
+    virtual
+    int
+    getScore (bool haveItem) = 0;
+
     virtual
     SkywellAddress const&
     getNodePublic() const = 0;
@@ -119,6 +119,72 @@ OverlayImpl::Timer::on_timer (error_code ec)
 
 //------------------------------------------------------------------------------
 
+OverlayImpl::TxBatch::TxBatch (OverlayImpl& overlay)
+    : Child(overlay)
+    , timer_(overlay_.io_service_)
+{
+}
+
+void
+OverlayImpl::TxBatch::stop()
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    error_code ec;
+    timer_.cancel(ec);
+    pending_.clear();
+}
+
+void
+OverlayImpl::TxBatch::add (protocol::TMTransaction const& m,
+    std::set<Peer::id_t>&& skip)
+{
+    std::vector<Entry> batch;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        pending_.push_back (Entry {m, std::move(skip)});
+
+        if (pending_.size() >= Tuning::txBatchMaxSize)
+        {
+            batch.swap (pending_);
+        }
+        else if (pending_.size() == 1)
+        {
+            // First transaction of a new batch, start the clock
+            timer_.expires_from_now (
+                std::chrono::milliseconds(Tuning::txBatchMillis));
+            timer_.async_wait(overlay_.strand_.wrap(std::bind(
+                &TxBatch::on_timer, shared_from_this(),
+                    std::placeholders::_1)));
+        }
+    }
+
+    if (! batch.empty())
+        overlay_.sendTransactions (batch);
+}
+
+void
+OverlayImpl::TxBatch::on_timer (error_code ec)
+{
+    if (ec || overlay_.isStopping())
+    {
+        if (ec && ec != boost::asio::error::operation_aborted)
+            if (overlay_.journal_.error) overlay_.journal_.error <<
+                "TxBatch::on_timer: " << ec.message();
+        return;
+    }
+
+    std::vector<Entry> batch;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        batch.swap (pending_);
+    }
+
+    if (! batch.empty())
+        overlay_.sendTransactions (batch);
+}
+
+//------------------------------------------------------------------------------
+
 OverlayImpl::OverlayImpl (
     Setup const& setup,
     Stoppable& parent,
@@ -494,9 +560,12 @@ OverlayImpl::onStart ()
 {
 
     auto const timer = std::make_shared<Timer>(*this);
+    auto const txBatch = std::make_shared<TxBatch>(*this);
     std::lock_guard <decltype(mutex_)> lock (mutex_);
     list_.emplace(timer.get(), timer);
+    list_.emplace(txBatch.get(), txBatch);
     timer_ = timer;
+    txBatch_ = txBatch;
     timer->run();
 }
 
@@ -790,6 +859,69 @@ OverlayImpl::relay (protocol::TMValidation& m,
     });
 }
 
+void
+OverlayImpl::relay (protocol::TMTransaction const& m,
+    std::set<Peer::id_t>&& skip)
+{
+    if (auto const txBatch = txBatch_.lock())
+        txBatch->add (m, std::move(skip));
+    else
+        sendTransactions ({ TxBatch::Entry {m, std::move(skip)} });
+}
+
+void
+OverlayImpl::sendTransactions (std::vector<TxBatch::Entry> const& batch)
+{
+    // Built on demand: one message per transaction for peers that
+    // predate batching, and one batch per distinct subset of wanted
+    // transactions, so that peers with identical needs share a message.
+    std::vector<Message::pointer> singles (batch.size());
+    std::map<std::vector<bool>, Message::pointer> batches;
+
+    for_each([&](std::shared_ptr<PeerImp>&& p)
+    {
+        std::vector<bool> wanted (batch.size(), false);
+        std::size_t count = 0;
+
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            if (batch[i].skip.find (p->id()) == batch[i].skip.end())
+            {
+                wanted[i] = true;
+                ++count;
+            }
+        }
+
+        if (count == 0)
+            return;
+
+        if (count == 1 || ! p->txBatchAware())
+        {
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                if (! wanted[i])
+                    continue;
+                if (! singles[i])
+                    singles[i] = std::make_shared<Message>(
+                        batch[i].tx, protocol::mtTRANSACTION);
+                p->send(singles[i]);
+            }
+            return;
+        }
+
+        auto& sm = batches[wanted];
+        if (! sm)
+        {
+            protocol::TMTransactions msg;
+            for (std::size_t i = 0; i < batch.size(); ++i)
+                if (wanted[i])
+                    *msg.add_transactions() = batch[i].tx;
+            sm = std::make_shared<Message>(msg, protocol::mtTRANSACTIONS);
+        }
+        p->send(sm);
+    });
+}
+
 //------------------------------------------------------------------------------
 
 void
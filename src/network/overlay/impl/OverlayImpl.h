@@ -40,6 +40,8 @@
 #include <beast/cxx14/memory.h> // <memory>
 #include <mutex>
 #include <unordered_map>
+#include <set>
+#include <vector>
 
 namespace truechain {
 
@@ -94,6 +96,35 @@ private:
         on_timer (error_code ec);
     };
 
+    /** Collects relayed transactions into TMTransactions batches. */
+    struct TxBatch
+        : Child
+        , std::enable_shared_from_this<TxBatch>
+    {
+        struct Entry
+        {
+            protocol::TMTransaction tx;
+            std::set<Peer::id_t> skip;
+        };
+
+        boost::asio::basic_waitable_timer <clock_type> timer_;
+        std::mutex mutex_;
+        std::vector<Entry> pending_;
+
+        explicit
+        TxBatch (OverlayImpl& overlay);
+
+        void
+        stop() override;
+
+        void
+        add (protocol::TMTransaction const& m,
+            std::set<Peer::id_t>&& skip);
+
+        void
+        on_timer (error_code ec);
+    };
+
     boost::asio::io_service& io_service_;
     boost::optional<boost::asio::io_service::work> work_;
     boost::asio::io_service::strand strand_;
@@ -101,6 +132,7 @@ private:
     std::recursive_mutex mutex_; //  use std::mutex
     std::condition_variable_any cond_;
     std::weak_ptr<Timer> timer_;
+    std::weak_ptr<TxBatch> txBatch_;
     boost::container::flat_map<
         Child*, std::weak_ptr<Child>> list_;
 
@@ -193,6 +225,10 @@ public:
     relay (protocol::TMValidation& m,
         uint256 const& uid) override;
 
+    void
+    relay (protocol::TMTransaction const& m,
+        std::set<Peer::id_t>&& skip) override;
+
     //--------------------------------------------------------------------------
     //
     // OverlayImpl
@@ -316,6 +352,10 @@ private:
 
     void
     sendEndpoints();
+
+    /** Send relayed transactions to every peer that lacks them. */
+    void
+    sendTransactions (std::vector<TxBatch::Entry> const& batch);
 };
 
 } // truechain
@@ -34,6 +34,7 @@
 #include <common/core/JobQueue.h>
 #include <common/json/json_reader.h>
 #include <transaction/tx/InboundTransactions.h>
+#include <transaction/tx/TxSetSketch.h>
 #include <protocol/BuildInfo.h>
 #include <protocol/JsonFields.h>
 #include <beast/module/core/diagnostic/SemanticVersion.h>
@@ -388,6 +389,14 @@ PeerImp::supportsVersion (int version)
     return hello_.has_protoversion () && (hello_.protoversion () >= version);
 }
 
+bool
+PeerImp::txBatchAware() const
+{
+    // TMTransactions was introduced with RTXP/1.3
+    return hello_.has_protoversion () &&
+        (hello_.protoversion () >= to_packed (ProtocolVersion (1, 3)));
+}
+
 bool
 PeerImp::hasRange (std::uint32_t uMin, std::uint32_t uMax)
 {
@@ -976,7 +985,44 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMTransaction> const& m)
         return;
     }
 
-    SerialIter sit (m->rawtransaction ());
+    int flags;
+    STTx::pointer stx = prepareTransaction (*m, flags);
+
+    if (stx && canQueueTransactions ())
+        getApp().getJobQueue ().addJob (jtTRANSACTION,
+            "recvTransaction->checkTransaction",
+            std::bind(beast::weak_fn(&PeerImp::checkTransaction,
+            shared_from_this()), std::placeholders::_1, flags, stx));
+}
+
+void
+PeerImp::onMessage (std::shared_ptr <protocol::TMTransactions> const& m)
+{
+    if (sanity_.load() == Sanity::insane)
+        return;
+
+    if (getApp().getOPs().isNeedNetworkLedger ())
+        return;
+
+    if (m->transactions_size () > Tuning::txBatchMaxReceive)
+    {
+        p_journal_.debug <<
+            "Oversized transaction batch: " << m->transactions_size ();
+        fee_ = Resource::feeInvalidRequest;
+    }
+
+    // The whole batch is parsed and checked by a single job
+    if ((m->transactions_size () > 0) && canQueueTransactions ())
+        getApp().getJobQueue ().addJob (jtTRANSACTION,
+            "recvTransactions->checkTransactions",
+            std::bind(beast::weak_fn(&PeerImp::checkTransactions,
+            shared_from_this()), std::placeholders::_1, m));
+}
+
+STTx::pointer
+PeerImp::prepareTransaction (protocol::TMTransaction const& m, int& flags)
+{
+    SerialIter sit (m.rawtransaction ());
 
     try
     {
@@ -984,20 +1030,19 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMTransaction> const& m)
             STTx> (std::ref (sit));
         uint256 txID = stx->getTransactionID ();
 
-        int flags;
-
         if (! getApp().getHashRouter ().addSuppressionPeer (
             txID, id_, flags))
         {
             // we have seen this transaction recently
             if (flags & SF_BAD)
             {
-                fee_ = Resource::feeInvalidSignature;
-                return;
+                // Also called from a job, so charge now
+                charge (Resource::feeInvalidSignature);
+                return STTx::pointer ();
             }
 
             if (!(flags & SF_RETRY))
-                return;
+                return STTx::pointer ();
         }
 
         p_journal_.debug <<
@@ -1005,7 +1050,7 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMTransaction> const& m)
 
         if (cluster())
         {
-            if (! m->has_deferred () || ! m->deferred ())
+            if (! m.has_deferred () || ! m.deferred ())
             {
                 // Skip local checks if a server we trust
                 // put the transaction in its open ledger
@@ -1020,21 +1065,33 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMTransaction> const& m)
             }
         }
 
-        if (getApp().getJobQueue().getJobCount(jtTRANSACTION) > 100)
-            p_journal_.info << "Transaction queue is full";
-        else if (getApp().getLedgerMaster().getValidatedLedgerAge() > 240)
-            p_journal_.trace << "No new transactions until synchronized";
-        else
-            getApp().getJobQueue ().addJob (jtTRANSACTION,
-                "recvTransaction->checkTransaction",
-                std::bind(beast::weak_fn(&PeerImp::checkTransaction,
-                shared_from_this()), std::placeholders::_1, flags, stx));
+        return stx;
     }
     catch (...)
     {
         p_journal_.warning << "Transaction invalid: " <<
-            strHex(m->rawtransaction ());
+            strHex(m.rawtransaction ());
+    }
+
+    return STTx::pointer ();
+}
+
+bool
+PeerImp::canQueueTransactions ()
+{
+    if (getApp().getJobQueue().getJobCount(jtTRANSACTION) > 100)
+    {
+        p_journal_.info << "Transaction queue is full";
+        return false;
     }
+
+    if (getApp().getLedgerMaster().getValidatedLedgerAge() > 240)
+    {
+        p_journal_.trace << "No new transactions until synchronized";
+        return false;
+    }
+
+    return true;
 }
 
 void
@@ -1084,7 +1141,8 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMLedgerData> const& m)
 
     memcpy (hash.begin (), m->ledgerhash ().data (), 32);
 
-    if (m->type () == protocol::liTS_CANDIDATE)
+    if ((m->type () == protocol::liTS_CANDIDATE) ||
+        (m->type () == protocol::liTS_SKETCH))
     {
         // got data for a candidate transaction set
         getApp().getJobQueue().addJob(jtTXN_DATA, "recvPeerData", std::bind(
@@ -1686,6 +1744,24 @@ PeerImp::checkTransaction (Job&, int flags,
     }
 }
 
+void
+PeerImp::checkTransactions (Job& job,
+    std::shared_ptr<protocol::TMTransactions> const& m)
+{
+    // Anything past the limit was charged for when the batch arrived
+    int const count = std::min (m->transactions_size (),
+        static_cast<int> (Tuning::txBatchMaxReceive));
+
+    for (int i = 0; i < count; ++i)
+    {
+        int flags;
+        STTx::pointer stx = prepareTransaction (m->transactions (i), flags);
+
+        if (stx)
+            checkTransaction (job, flags, stx);
+    }
+}
+
 // Called from our JobQueue
 void
 PeerImp::checkPropose (Job& job,
@@ -1866,6 +1942,12 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
 
     std::string logMe;
 
+    if (packet.itype () == protocol::liTS_SKETCH)
+    {
+        getTxSetSketch (packet);
+        return;
+    }
+
     if (packet.itype () == protocol::liTS_CANDIDATE)
     {
         // Request is for a transaction candidate set
@@ -2090,7 +2172,8 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
             logMe += " TX:";
             logMe += to_string (map->getHash ());
         }
-        else if (packet.itype () == protocol::liAS_NODE)
+        else if ((packet.itype () == protocol::liAS_NODE) ||
+            (packet.itype () == protocol::liAS_LEAVES))
         {
             map = ledger->peekAccountStateMap ();
             logMe += " AS:";
@@ -2109,6 +2192,12 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
     if (p_journal_.trace) p_journal_.trace <<
         "GetLeder: " << logMe;
 
+    if (packet.itype () == protocol::liAS_LEAVES)
+    {
+        getStateLeaves (packet, *map, reply);
+        return;
+    }
+
     auto const depth =
         packet.has_querydepth() ?
             (std::min(packet.querydepth(), 3u)) :
@@ -2186,6 +2275,107 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
     send (oPacket);
 }
 
+void
+PeerImp::getStateLeaves (protocol::TMGetLedger const& packet,
+    SHAMap const& map, protocol::TMLedgerData& reply)
+{
+    // We only ever ask for one subtree at a time
+    if (packet.nodeids ().size () > Tuning::snapshotMaxSubtrees)
+    {
+        if (p_journal_.warning) p_journal_.warning <<
+            "GetLedger: Too many leaves nodes";
+        charge (Resource::feeInvalidRequest);
+        return;
+    }
+
+    // Each requested subtree is answered with its leaves in key order,
+    // or with no data if it is too large, so the requester can split it.
+    for (int i = 0; i < packet.nodeids ().size (); ++i)
+    {
+        // Walking whole subtrees is more work than serving a few nodes
+        charge (Resource::feeHighBurdenPeer);
+
+        SHAMapNodeID mn (packet.nodeids (i).data (), packet.nodeids (i).size ());
+
+        if (!mn.isValid () || mn.isRoot ())
+        {
+            if (p_journal_.warning) p_journal_.warning <<
+                "GetLedger: Invalid leaves node";
+            charge (Resource::feeInvalidRequest);
+            return;
+        }
+
+        std::vector<std::shared_ptr<SHAMapItem>> items;
+        Serializer s;
+
+        try
+        {
+            if (map.getLeaves (mn, items, Tuning::snapshotMaxLeaves))
+            {
+                for (auto const& item : items)
+                {
+                    s.add256 (item->getTag ());
+                    s.addVL (item->peekData ());
+                }
+            }
+        }
+        catch (std::exception&)
+        {
+            if (p_journal_.warning) p_journal_.warning <<
+                "getLeaves( " << mn << ") throws exception";
+            s.erase ();
+        }
+
+        protocol::TMLedgerNode* node = reply.add_nodes ();
+        node->set_nodeid (packet.nodeids (i));
+
+        if (s.getLength () != 0)
+            node->set_nodedata (s.getDataPtr (), s.getLength ());
+    }
+
+    if (p_journal_.debug) p_journal_.debug <<
+        "Got request for leaves of " << packet.nodeids().size() << " nodes";
+
+    send (std::make_shared<Message> (reply, protocol::mtLEDGER_DATA));
+}
+
+void
+PeerImp::getTxSetSketch (protocol::TMGetLedger const& packet)
+{
+    if ((!packet.has_ledgerhash () || packet.ledgerhash ().size () != 32))
+    {
+        charge (Resource::feeInvalidRequest);
+        if (p_journal_.warning) p_journal_.warning <<
+            "GetLedger: Tx set sketch invalid";
+        return;
+    }
+
+    uint256 txHash;
+    memcpy (txHash.begin (), packet.ledgerhash ().data (), 32);
+
+    // Sketches are never routed, the requester falls back to nodes
+    std::shared_ptr<SHAMap> map =
+        getApp().getInboundTransactions().getSet (txHash, false);
+
+    if (!map)
+    {
+        if (p_journal_.debug) p_journal_.debug <<
+            "GetLedger: Can't provide sketch";
+        return;
+    }
+
+    Serializer s;
+    TxSetSketch (*map).add (s);
+
+    protocol::TMLedgerData reply;
+    reply.set_ledgerseq (0);
+    reply.set_ledgerhash (txHash.begin (), txHash.size ());
+    reply.set_type (protocol::liTS_SKETCH);
+    reply.add_nodes ()->set_nodedata (s.getDataPtr (), s.getLength ());
+
+    send (std::make_shared<Message> (reply, protocol::mtLEDGER_DATA));
+}
+
 void
 PeerImp::peerTXData (Job&, uint256 const& hash,
     std::shared_ptr <protocol::TMLedgerData> const& pPacket,
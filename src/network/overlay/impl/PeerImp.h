@@ -22,6 +22,7 @@
 
 #include <ledger/LedgerProposal.h>
 #include <common/base/Log.h> // deprecated
+#include <common/shamap/SHAMap.h>
 #include <data/nodestore/Database.h>
 #include <network/overlay/predicates.h>
 #include <network/overlay/impl/ProtocolMessage.h>
@@ -249,6 +250,10 @@ public:
         return hopsAware_;
     }
 
+    /** Returns `true` if the peer understands TMTransactions batches. */
+    bool
+    txBatchAware() const;
+
     void
     check();
 
@@ -304,7 +309,7 @@ public:
 
     // Called to determine our priority for querying
     int
-    getScore (bool haveItem);
+    getScore (bool haveItem) override;
 
     bool
     isHighLatency() const override;
@@ -400,6 +405,7 @@ public:
     void onMessage (std::shared_ptr <protocol::TMPeers> const& m);
     void onMessage (std::shared_ptr <protocol::TMEndpoints> const& m);
     void onMessage (std::shared_ptr <protocol::TMTransaction> const& m);
+    void onMessage (std::shared_ptr <protocol::TMTransactions> const& m);
     void onMessage (std::shared_ptr <protocol::TMGetLedger> const& m);
     void onMessage (std::shared_ptr <protocol::TMLedgerData> const& m);
     void onMessage (std::shared_ptr <protocol::TMProposeSet> const& m);
@@ -439,9 +445,24 @@ private:
     void
     doFetchPack (const std::shared_ptr<protocol::TMGetObjectByHash>& packet);
 
+    /** Parse a relayed transaction and apply suppression.
+        @return The transaction, or null if it should be dropped.
+    */
+    STTx::pointer
+    prepareTransaction (protocol::TMTransaction const& m, int& flags);
+
+    /** Returns `true` if relayed transactions may be queued for checking. */
+    bool
+    canQueueTransactions ();
+
     void
     checkTransaction (Job&, int flags, STTx::pointer stx);
 
+    /** Parse and check a batch of relayed transactions. */
+    void
+    checkTransactions (Job& job,
+        std::shared_ptr<protocol::TMTransactions> const& m);
+
     void
     checkPropose (Job& job,
         std::shared_ptr<protocol::TMProposeSet> const& packet,
@@ -454,6 +475,15 @@ private:
     void
     getLedger (std::shared_ptr<protocol::TMGetLedger> const&packet);
 
+    // Reply with the state leaves below the requested nodes.
+    void
+    getStateLeaves (protocol::TMGetLedger const& packet,
+        SHAMap const& map, protocol::TMLedgerData& reply);
+
+    // Reply with a reconciliation sketch of a candidate tx set.
+    void
+    getTxSetSketch (protocol::TMGetLedger const& packet);
+
     // Called when we receive tx set data.
     void
     peerTXData (Job&, uint256 const& hash,
@@ -54,6 +54,7 @@ protocolMessageName (int type)
     case protocol::mtPROPOSE_LEDGER:    return "propose";
     case protocol::mtSTATUS_CHANGE:     return "status";
     case protocol::mtHAVE_SET:          return "have_set";
+    case protocol::mtTRANSACTIONS:      return "txs";
     case protocol::mtVALIDATION:        return "validation";
     case protocol::mtGET_OBJECTS:       return "get_objects";
     default:
@@ -123,6 +124,7 @@ invokeProtocolMessage (Buffers const& buffers, Handler& handler)
     case protocol::mtPROPOSE_LEDGER:ec = detail::invoke<protocol::TMProposeSet> (type, buffers, handler); break;
     case protocol::mtSTATUS_CHANGE: ec = detail::invoke<protocol::TMStatusChange> (type, buffers, handler); break;
     case protocol::mtHAVE_SET:      ec = detail::invoke<protocol::TMHaveTransactionSet> (type, buffers, handler); break;
+    case protocol::mtTRANSACTIONS:  ec = detail::invoke<protocol::TMTransactions> (type, buffers, handler); break;
     case protocol::mtVALIDATION:    ec = detail::invoke<protocol::TMValidation> (type, buffers, handler); break;
     case protocol::mtGET_OBJECTS:   ec = detail::invoke<protocol::TMGetObjectByHash> (type, buffers, handler); break;
     default:
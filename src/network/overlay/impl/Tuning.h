@@ -52,6 +52,22 @@ enum
 
     /** How often we check connections (seconds) */
     checkSeconds        =   10,
+
+    /** How long relayed transactions may wait to be batched (milliseconds) */
+    txBatchMillis       =    5,
+
+    /** How many relayed transactions fill a batch */
+    txBatchMaxSize      =  128,
+
+    /** Most transactions we check from one received batch. Peers never
+        send more, so the excess is charged for and dropped. */
+    txBatchMaxReceive   = txBatchMaxSize,
+
+    /** Most state leaves we send for one subtree of a snapshot */
+    snapshotMaxLeaves   = 4096,
+
+    /** Most subtrees one request for state leaves may name */
+    snapshotMaxSubtrees =    1,
 };
 
 } // Tuning
@@ -39,6 +39,9 @@ const ::google::protobuf::internal::GeneratedMessageReflection*
 const ::google::protobuf::Descriptor* TMTransaction_descriptor_ = NULL;
 const ::google::protobuf::internal::GeneratedMessageReflection*
   TMTransaction_reflection_ = NULL;
+const ::google::protobuf::Descriptor* TMTransactions_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  TMTransactions_reflection_ = NULL;
 const ::google::protobuf::Descriptor* TMStatusChange_descriptor_ = NULL;
 const ::google::protobuf::internal::GeneratedMessageReflection*
   TMStatusChange_reflection_ = NULL;
@@ -223,7 +226,22 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMTransaction));
-  TMStatusChange_descriptor_ = file->message_type(6);
+  TMTransactions_descriptor_ = file->message_type(6);
+  static const int TMTransactions_offsets_[1] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMTransactions, transactions_),
+  };
+  TMTransactions_reflection_ =
+    new ::google::protobuf::internal::GeneratedMessageReflection(
+      TMTransactions_descriptor_,
+      TMTransactions::default_instance_,
+      TMTransactions_offsets_,
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMTransactions, _has_bits_[0]),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMTransactions, _unknown_fields_),
+      -1,
+      ::google::protobuf::DescriptorPool::generated_pool(),
+      ::google::protobuf::MessageFactory::generated_factory(),
+      sizeof(TMTransactions));
+  TMStatusChange_descriptor_ = file->message_type(7);
   static const int TMStatusChange_offsets_[8] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMStatusChange, newstatus_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMStatusChange, newevent_),
@@ -245,7 +263,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMStatusChange));
-  TMProposeSet_descriptor_ = file->message_type(7);
+  TMProposeSet_descriptor_ = file->message_type(8);
   static const int TMProposeSet_offsets_[10] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMProposeSet, proposeseq_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMProposeSet, currenttxhash_),
@@ -269,7 +287,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMProposeSet));
-  TMHaveTransactionSet_descriptor_ = file->message_type(8);
+  TMHaveTransactionSet_descriptor_ = file->message_type(9);
   static const int TMHaveTransactionSet_offsets_[2] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMHaveTransactionSet, status_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMHaveTransactionSet, hash_),
@@ -285,7 +303,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMHaveTransactionSet));
-  TMValidation_descriptor_ = file->message_type(9);
+  TMValidation_descriptor_ = file->message_type(10);
   static const int TMValidation_offsets_[3] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMValidation, validation_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMValidation, checkedsignature_),
@@ -302,7 +320,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMValidation));
-  TMGetPeers_descriptor_ = file->message_type(10);
+  TMGetPeers_descriptor_ = file->message_type(11);
   static const int TMGetPeers_offsets_[1] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMGetPeers, doweneedthis_),
   };
@@ -317,7 +335,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMGetPeers));
-  TMIPv4Endpoint_descriptor_ = file->message_type(11);
+  TMIPv4Endpoint_descriptor_ = file->message_type(12);
   static const int TMIPv4Endpoint_offsets_[2] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMIPv4Endpoint, ipv4_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMIPv4Endpoint, ipv4port_),
@@ -333,7 +351,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMIPv4Endpoint));
-  TMPeers_descriptor_ = file->message_type(12);
+  TMPeers_descriptor_ = file->message_type(13);
   static const int TMPeers_offsets_[1] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMPeers, nodes_),
   };
@@ -348,7 +366,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMPeers));
-  TMEndpoint_descriptor_ = file->message_type(13);
+  TMEndpoint_descriptor_ = file->message_type(14);
   static const int TMEndpoint_offsets_[2] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMEndpoint, ipv4_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMEndpoint, hops_),
@@ -364,7 +382,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMEndpoint));
-  TMEndpoints_descriptor_ = file->message_type(14);
+  TMEndpoints_descriptor_ = file->message_type(15);
   static const int TMEndpoints_offsets_[2] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMEndpoints, version_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMEndpoints, endpoints_),
@@ -380,7 +398,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMEndpoints));
-  TMIndexedObject_descriptor_ = file->message_type(15);
+  TMIndexedObject_descriptor_ = file->message_type(16);
   static const int TMIndexedObject_offsets_[5] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMIndexedObject, hash_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMIndexedObject, nodeid_),
@@ -399,7 +417,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMIndexedObject));
-  TMGetObjectByHash_descriptor_ = file->message_type(16);
+  TMGetObjectByHash_descriptor_ = file->message_type(17);
   static const int TMGetObjectByHash_offsets_[6] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMGetObjectByHash, type_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMGetObjectByHash, query_),
@@ -420,7 +438,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMGetObjectByHash));
   TMGetObjectByHash_ObjectType_descriptor_ = TMGetObjectByHash_descriptor_->enum_type(0);
-  TMLedgerNode_descriptor_ = file->message_type(17);
+  TMLedgerNode_descriptor_ = file->message_type(18);
   static const int TMLedgerNode_offsets_[2] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMLedgerNode, nodedata_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMLedgerNode, nodeid_),
@@ -436,7 +454,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMLedgerNode));
-  TMGetLedger_descriptor_ = file->message_type(18);
+  TMGetLedger_descriptor_ = file->message_type(19);
   static const int TMGetLedger_offsets_[8] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMGetLedger, itype_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMGetLedger, ltype_),
@@ -458,7 +476,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMGetLedger));
-  TMLedgerData_descriptor_ = file->message_type(19);
+  TMLedgerData_descriptor_ = file->message_type(20);
   static const int TMLedgerData_offsets_[6] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMLedgerData, ledgerhash_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMLedgerData, ledgerseq_),
@@ -478,7 +496,7 @@ void protobuf_AssignDesc_truechain_2eproto() {
       ::google::protobuf::DescriptorPool::generated_pool(),
       ::google::protobuf::MessageFactory::generated_factory(),
       sizeof(TMLedgerData));
-  TMPing_descriptor_ = file->message_type(20);
+  TMPing_descriptor_ = file->message_type(21);
   static const int TMPing_offsets_[4] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMPing, type_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(TMPing, seq_),
@@ -530,6 +548,8 @@ void protobuf_RegisterTypes(const ::std::string&) {
     TMCluster_descriptor_, &TMCluster::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
     TMTransaction_descriptor_, &TMTransaction::default_instance());
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+    TMTransactions_descriptor_, &TMTransactions::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
     TMStatusChange_descriptor_, &TMStatusChange::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
@@ -577,6 +597,8 @@ void protobuf_ShutdownFile_truechain_2eproto() {
   delete TMCluster_reflection_;
   delete TMTransaction::default_instance_;
   delete TMTransaction_reflection_;
+  delete TMTransactions::default_instance_;
+  delete TMTransactions_reflection_;
   delete TMStatusChange::default_instance_;
   delete TMStatusChange_reflection_;
   delete TMProposeSet::default_instance_;
@@ -641,78 +663,81 @@ void protobuf_AddDesc_truechain_2eproto() {
     "action\022\026\n\016rawTransaction\030\001 \002(\014\022+\n\006status"
     "\030\002 \002(\0162\033.protocol.TransactionStatus\022\030\n\020r"
     "eceiveTimestamp\030\003 \001(\004\022\020\n\010deferred\030\004 \001(\010\""
-    "\333\001\n\016TMStatusChange\022\'\n\tnewStatus\030\001 \001(\0162\024."
-    "protocol.NodeStatus\022%\n\010newEvent\030\002 \001(\0162\023."
-    "protocol.NodeEvent\022\021\n\tledgerSeq\030\003 \001(\r\022\022\n"
-    "\nledgerHash\030\004 \001(\014\022\032\n\022ledgerHashPrevious\030"
-    "\005 \001(\014\022\023\n\013networkTime\030\006 \001(\004\022\020\n\010firstSeq\030\007"
-    " \001(\r\022\017\n\007lastSeq\030\010 \001(\r\"\353\001\n\014TMProposeSet\022\022"
-    "\n\nproposeSeq\030\001 \002(\r\022\025\n\rcurrentTxHash\030\002 \002("
-    "\014\022\022\n\nnodePubKey\030\003 \002(\014\022\021\n\tcloseTime\030\004 \002(\r"
-    "\022\021\n\tsignature\030\005 \002(\014\022\026\n\016previousledger\030\006 "
-    "\001(\014\022\030\n\020checkedSignature\030\007 \001(\010\022\031\n\021addedTr"
-    "ansactions\030\n \003(\014\022\033\n\023removedTransactions\030"
-    "\013 \003(\014\022\014\n\004hops\030\014 \001(\r\"K\n\024TMHaveTransaction"
-    "Set\022%\n\006status\030\001 \002(\0162\025.protocol.TxSetStat"
-    "us\022\014\n\004hash\030\002 \002(\014\"J\n\014TMValidation\022\022\n\nvali"
-    "dation\030\001 \002(\014\022\030\n\020checkedSignature\030\002 \001(\010\022\014"
-    "\n\004hops\030\003 \001(\r\"\"\n\nTMGetPeers\022\024\n\014doWeNeedTh"
-    "is\030\001 \002(\r\"0\n\016TMIPv4Endpoint\022\014\n\004ipv4\030\001 \002(\r"
-    "\022\020\n\010ipv4Port\030\002 \002(\r\"2\n\007TMPeers\022\'\n\005nodes\030\001"
-    " \003(\0132\030.protocol.TMIPv4Endpoint\"B\n\nTMEndp"
-    "oint\022&\n\004ipv4\030\001 \002(\0132\030.protocol.TMIPv4Endp"
-    "oint\022\014\n\004hops\030\002 \002(\r\"G\n\013TMEndpoints\022\017\n\007ver"
-    "sion\030\001 \002(\r\022\'\n\tendpoints\030\002 \003(\0132\024.protocol"
-    ".TMEndpoint\"_\n\017TMIndexedObject\022\014\n\004hash\030\001"
-    " \001(\014\022\016\n\006nodeID\030\002 \001(\014\022\r\n\005index\030\003 \001(\014\022\014\n\004d"
-    "ata\030\004 \001(\014\022\021\n\tledgerSeq\030\005 \001(\r\"\277\002\n\021TMGetOb"
-    "jectByHash\0224\n\004type\030\001 \002(\0162&.protocol.TMGe"
-    "tObjectByHash.ObjectType\022\r\n\005query\030\002 \002(\010\022"
-    "\013\n\003seq\030\003 \001(\r\022\022\n\nledgerHash\030\004 \001(\014\022\013\n\003fat\030"
-    "\005 \001(\010\022*\n\007objects\030\006 \003(\0132\031.protocol.TMInde"
-    "xedObject\"\212\001\n\nObjectType\022\r\n\totUNKNOWN\020\000\022"
-    "\014\n\010otLEDGER\020\001\022\021\n\rotTRANSACTION\020\002\022\026\n\022otTR"
-    "ANSACTION_NODE\020\003\022\020\n\014otSTATE_NODE\020\004\022\020\n\014ot"
-    "CAS_OBJECT\020\005\022\020\n\014otFETCH_PACK\020\006\"0\n\014TMLedg"
-    "erNode\022\020\n\010nodedata\030\001 \002(\014\022\016\n\006nodeid\030\002 \001(\014"
-    "\"\354\001\n\013TMGetLedger\022)\n\005itype\030\001 \002(\0162\032.protoc"
-    "ol.TMLedgerInfoType\022%\n\005ltype\030\002 \001(\0162\026.pro"
-    "tocol.TMLedgerType\022\022\n\nledgerHash\030\003 \001(\014\022\021"
-    "\n\tledgerSeq\030\004 \001(\r\022\017\n\007nodeIDs\030\005 \003(\014\022\025\n\rre"
-    "questCookie\030\006 \001(\004\022(\n\tqueryType\030\007 \001(\0162\025.p"
-    "rotocol.TMQueryType\022\022\n\nqueryDepth\030\010 \001(\r\""
-    "\304\001\n\014TMLedgerData\022\022\n\nledgerHash\030\001 \002(\014\022\021\n\t"
-    "ledgerSeq\030\002 \002(\r\022(\n\004type\030\003 \002(\0162\032.protocol"
-    ".TMLedgerInfoType\022%\n\005nodes\030\004 \003(\0132\026.proto"
-    "col.TMLedgerNode\022\025\n\rrequestCookie\030\005 \001(\r\022"
-    "%\n\005error\030\006 \001(\0162\026.protocol.TMReplyError\"\205"
-    "\001\n\006TMPing\022\'\n\004type\030\001 \002(\0162\031.protocol.TMPin"
-    "g.pingType\022\013\n\003seq\030\002 \001(\r\022\020\n\010pingTime\030\003 \001("
-    "\004\022\017\n\007netTime\030\004 \001(\004\"\"\n\010pingType\022\n\n\006ptPING"
-    "\020\000\022\n\n\006ptPONG\020\001*\217\002\n\013MessageType\022\013\n\007mtHELL"
-    "O\020\001\022\n\n\006mtPING\020\003\022\021\n\rmtPROOFOFWORK\020\004\022\r\n\tmt"
-    "CLUSTER\020\005\022\017\n\013mtGET_PEERS\020\014\022\013\n\007mtPEERS\020\r\022"
-    "\017\n\013mtENDPOINTS\020\017\022\021\n\rmtTRANSACTION\020\036\022\020\n\014m"
-    "tGET_LEDGER\020\037\022\021\n\rmtLEDGER_DATA\020 \022\024\n\020mtPR"
-    "OPOSE_LEDGER\020!\022\023\n\017mtSTATUS_CHANGE\020\"\022\016\n\nm"
-    "tHAVE_SET\020#\022\020\n\014mtVALIDATION\020)\022\021\n\rmtGET_O"
-    "BJECTS\020**\241\001\n\021TransactionStatus\022\t\n\005tsNEW\020"
-    "\001\022\r\n\ttsCURRENT\020\002\022\016\n\ntsCOMMITED\020\003\022\025\n\021tsRE"
-    "JECT_CONFLICT\020\004\022\024\n\020tsREJECT_INVALID\020\005\022\022\n"
-    "\016tsREJECT_FUNDS\020\006\022\016\n\ntsHELD_SEQ\020\007\022\021\n\rtsH"
-    "ELD_LEDGER\020\010*c\n\nNodeStatus\022\020\n\014nsCONNECTI"
-    "NG\020\001\022\017\n\013nsCONNECTED\020\002\022\020\n\014nsMONITORING\020\003\022"
-    "\020\n\014nsVALIDATING\020\004\022\016\n\nnsSHUTTING\020\005*`\n\tNod"
-    "eEvent\022\024\n\020neCLOSING_LEDGER\020\001\022\025\n\021neACCEPT"
-    "ED_LEDGER\020\002\022\025\n\021neSWITCHED_LEDGER\020\003\022\017\n\013ne"
-    "LOST_SYNC\020\004*4\n\013TxSetStatus\022\n\n\006tsHAVE\020\001\022\r"
-    "\n\ttsCAN_GET\020\002\022\n\n\006tsNEED\020\003*P\n\020TMLedgerInf"
-    "oType\022\n\n\006liBASE\020\000\022\r\n\tliTX_NODE\020\001\022\r\n\tliAS"
-    "_NODE\020\002\022\022\n\016liTS_CANDIDATE\020\003*;\n\014TMLedgerT"
-    "ype\022\016\n\nltACCEPTED\020\000\022\r\n\tltCURRENT\020\001\022\014\n\010lt"
-    "CLOSED\020\002*\035\n\013TMQueryType\022\016\n\nqtINDIRECT\020\000*"
-    ".\n\014TMReplyError\022\017\n\013reNO_LEDGER\020\001\022\r\n\treNO"
-    "_NODE\020\002", 3847);
+    "?\n\016TMTransactions\022-\n\014transactions\030\001 \003(\0132"
+    "\027.protocol.TMTransaction\"\333\001\n\016TMStatusCha"
+    "nge\022\'\n\tnewStatus\030\001 \001(\0162\024.protocol.NodeSt"
+    "atus\022%\n\010newEvent\030\002 \001(\0162\023.protocol.NodeEv"
+    "ent\022\021\n\tledgerSeq\030\003 \001(\r\022\022\n\nledgerHash\030\004 \001"
+    "(\014\022\032\n\022ledgerHashPrevious\030\005 \001(\014\022\023\n\013networ"
+    "kTime\030\006 \001(\004\022\020\n\010firstSeq\030\007 \001(\r\022\017\n\007lastSeq"
+    "\030\010 \001(\r\"\353\001\n\014TMProposeSet\022\022\n\nproposeSeq\030\001 "
+    "\002(\r\022\025\n\rcurrentTxHash\030\002 \002(\014\022\022\n\nnodePubKey"
+    "\030\003 \002(\014\022\021\n\tcloseTime\030\004 \002(\r\022\021\n\tsignature\030\005"
+    " \002(\014\022\026\n\016previousledger\030\006 \001(\014\022\030\n\020checkedS"
+    "ignature\030\007 \001(\010\022\031\n\021addedTransactions\030\n \003("
+    "\014\022\033\n\023removedTransactions\030\013 \003(\014\022\014\n\004hops\030\014"
+    " \001(\r\"K\n\024TMHaveTransactionSet\022%\n\006status\030\001"
+    " \002(\0162\025.protocol.TxSetStatus\022\014\n\004hash\030\002 \002("
+    "\014\"J\n\014TMValidation\022\022\n\nvalidation\030\001 \002(\014\022\030\n"
+    "\020checkedSignature\030\002 \001(\010\022\014\n\004hops\030\003 \001(\r\"\"\n"
+    "\nTMGetPeers\022\024\n\014doWeNeedThis\030\001 \002(\r\"0\n\016TMI"
+    "Pv4Endpoint\022\014\n\004ipv4\030\001 \002(\r\022\020\n\010ipv4Port\030\002 "
+    "\002(\r\"2\n\007TMPeers\022\'\n\005nodes\030\001 \003(\0132\030.protocol"
+    ".TMIPv4Endpoint\"B\n\nTMEndpoint\022&\n\004ipv4\030\001 "
+    "\002(\0132\030.protocol.TMIPv4Endpoint\022\014\n\004hops\030\002 "
+    "\002(\r\"G\n\013TMEndpoints\022\017\n\007version\030\001 \002(\r\022\'\n\te"
+    "ndpoints\030\002 \003(\0132\024.protocol.TMEndpoint\"_\n\017"
+    "TMIndexedObject\022\014\n\004hash\030\001 \001(\014\022\016\n\006nodeID\030"
+    "\002 \001(\014\022\r\n\005index\030\003 \001(\014\022\014\n\004data\030\004 \001(\014\022\021\n\tle"
+    "dgerSeq\030\005 \001(\r\"\277\002\n\021TMGetObjectByHash\0224\n\004t"
+    "ype\030\001 \002(\0162&.protocol.TMGetObjectByHash.O"
+    "bjectType\022\r\n\005query\030\002 \002(\010\022\013\n\003seq\030\003 \001(\r\022\022\n"
+    "\nledgerHash\030\004 \001(\014\022\013\n\003fat\030\005 \001(\010\022*\n\007object"
+    "s\030\006 \003(\0132\031.protocol.TMIndexedObject\"\212\001\n\nO"
+    "bjectType\022\r\n\totUNKNOWN\020\000\022\014\n\010otLEDGER\020\001\022\021"
+    "\n\rotTRANSACTION\020\002\022\026\n\022otTRANSACTION_NODE\020"
+    "\003\022\020\n\014otSTATE_NODE\020\004\022\020\n\014otCAS_OBJECT\020\005\022\020\n"
+    "\014otFETCH_PACK\020\006\"0\n\014TMLedgerNode\022\020\n\010noded"
+    "ata\030\001 \002(\014\022\016\n\006nodeid\030\002 \001(\014\"\354\001\n\013TMGetLedge"
+    "r\022)\n\005itype\030\001 \002(\0162\032.protocol.TMLedgerInfo"
+    "Type\022%\n\005ltype\030\002 \001(\0162\026.protocol.TMLedgerT"
+    "ype\022\022\n\nledgerHash\030\003 \001(\014\022\021\n\tledgerSeq\030\004 \001"
+    "(\r\022\017\n\007nodeIDs\030\005 \003(\014\022\025\n\rrequestCookie\030\006 \001"
+    "(\004\022(\n\tqueryType\030\007 \001(\0162\025.protocol.TMQuery"
+    "Type\022\022\n\nqueryDepth\030\010 \001(\r\"\304\001\n\014TMLedgerDat"
+    "a\022\022\n\nledgerHash\030\001 \002(\014\022\021\n\tledgerSeq\030\002 \002(\r"
+    "\022(\n\004type\030\003 \002(\0162\032.protocol.TMLedgerInfoTy"
+    "pe\022%\n\005nodes\030\004 \003(\0132\026.protocol.TMLedgerNod"
+    "e\022\025\n\rrequestCookie\030\005 \001(\r\022%\n\005error\030\006 \001(\0162"
+    "\026.protocol.TMReplyError\"\205\001\n\006TMPing\022\'\n\004ty"
+    "pe\030\001 \002(\0162\031.protocol.TMPing.pingType\022\013\n\003s"
+    "eq\030\002 \001(\r\022\020\n\010pingTime\030\003 \001(\004\022\017\n\007netTime\030\004 "
+    "\001(\004\"\"\n\010pingType\022\n\n\006ptPING\020\000\022\n\n\006ptPONG\020\001*"
+    "\243\002\n\013MessageType\022\013\n\007mtHELLO\020\001\022\n\n\006mtPING\020\003"
+    "\022\021\n\rmtPROOFOFWORK\020\004\022\r\n\tmtCLUSTER\020\005\022\017\n\013mt"
+    "GET_PEERS\020\014\022\013\n\007mtPEERS\020\r\022\017\n\013mtENDPOINTS\020"
+    "\017\022\021\n\rmtTRANSACTION\020\036\022\020\n\014mtGET_LEDGER\020\037\022\021"
+    "\n\rmtLEDGER_DATA\020 \022\024\n\020mtPROPOSE_LEDGER\020!\022"
+    "\023\n\017mtSTATUS_CHANGE\020\"\022\016\n\nmtHAVE_SET\020#\022\022\n\016"
+    "mtTRANSACTIONS\020$\022\020\n\014mtVALIDATION\020)\022\021\n\rmt"
+    "GET_OBJECTS\020**\241\001\n\021TransactionStatus\022\t\n\005t"
+    "sNEW\020\001\022\r\n\ttsCURRENT\020\002\022\016\n\ntsCOMMITED\020\003\022\025\n"
+    "\021tsREJECT_CONFLICT\020\004\022\024\n\020tsREJECT_INVALID"
+    "\020\005\022\022\n\016tsREJECT_FUNDS\020\006\022\016\n\ntsHELD_SEQ\020\007\022\021"
+    "\n\rtsHELD_LEDGER\020\010*c\n\nNodeStatus\022\020\n\014nsCON"
+    "NECTING\020\001\022\017\n\013nsCONNECTED\020\002\022\020\n\014nsMONITORI"
+    "NG\020\003\022\020\n\014nsVALIDATING\020\004\022\016\n\nnsSHUTTING\020\005*`"
+    "\n\tNodeEvent\022\024\n\020neCLOSING_LEDGER\020\001\022\025\n\021neA"
+    "CCEPTED_LEDGER\020\002\022\025\n\021neSWITCHED_LEDGER\020\003\022"
+    "\017\n\013neLOST_SYNC\020\004*4\n\013TxSetStatus\022\n\n\006tsHAV"
+    "E\020\001\022\r\n\ttsCAN_GET\020\002\022\n\n\006tsNEED\020\003*r\n\020TMLedg"
+    "erInfoType\022\n\n\006liBASE\020\000\022\r\n\tliTX_NODE\020\001\022\r\n"
+    "\tliAS_NODE\020\002\022\022\n\016liTS_CANDIDATE\020\003\022\017\n\013liTS"
+    "_SKETCH\020\004\022\017\n\013liAS_LEAVES\020\005*;\n\014TMLedgerTy"
+    "pe\022\016\n\nltACCEPTED\020\000\022\r\n\tltCURRENT\020\001\022\014\n\010ltC"
+    "LOSED\020\002*\035\n\013TMQueryType\022\016\n\nqtINDIRECT\020\000*."
+    "\n\014TMReplyError\022\017\n\013reNO_LEDGER\020\001\022\r\n\treNO_"
+    "NODE\020\002", 3966);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "truechain.proto", &protobuf_RegisterTypes);
   TMProofWork::default_instance_ = new TMProofWork();
@@ -721,6 +746,7 @@ void protobuf_AddDesc_truechain_2eproto() {
   TMLoadSource::default_instance_ = new TMLoadSource();
   TMCluster::default_instance_ = new TMCluster();
   TMTransaction::default_instance_ = new TMTransaction();
+  TMTransactions::default_instance_ = new TMTransactions();
   TMStatusChange::default_instance_ = new TMStatusChange();
   TMProposeSet::default_instance_ = new TMProposeSet();
   TMHaveTransactionSet::default_instance_ = new TMHaveTransactionSet();
@@ -742,6 +768,7 @@ void protobuf_AddDesc_truechain_2eproto() {
   TMLoadSource::default_instance_->InitAsDefaultInstance();
   TMCluster::default_instance_->InitAsDefaultInstance();
   TMTransaction::default_instance_->InitAsDefaultInstance();
+  TMTransactions::default_instance_->InitAsDefaultInstance();
   TMStatusChange::default_instance_->InitAsDefaultInstance();
   TMProposeSet::default_instance_->InitAsDefaultInstance();
   TMHaveTransactionSet::default_instance_->InitAsDefaultInstance();
@@ -785,6 +812,7 @@ bool MessageType_IsValid(int value) {
     case 33:
     case 34:
     case 35:
+    case 36:
     case 41:
     case 42:
       return true;
@@ -871,6 +899,8 @@ bool TMLedgerInfoType_IsValid(int value) {
     case 1:
     case 2:
     case 3:
+    case 4:
+    case 5:
       return true;
     default:
       return false;
@@ -3469,6 +3499,212 @@ void TMTransaction::Swap(TMTransaction* other) {
 }
 
 
+// ===================================================================
+
+#ifndef _MSC_VER
+const int TMTransactions::kTransactionsFieldNumber;
+#endif  // !_MSC_VER
+
+TMTransactions::TMTransactions()
+  : ::google::protobuf::Message() {
+  SharedCtor();
+}
+
+void TMTransactions::InitAsDefaultInstance() {
+}
+
+TMTransactions::TMTransactions(const TMTransactions& from)
+  : ::google::protobuf::Message() {
+  SharedCtor();
+  MergeFrom(from);
+}
+
+void TMTransactions::SharedCtor() {
+  _cached_size_ = 0;
+  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+}
+
+TMTransactions::~TMTransactions() {
+  SharedDtor();
+}
+
+void TMTransactions::SharedDtor() {
+  if (this != default_instance_) {
+  }
+}
+
+void TMTransactions::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* TMTransactions::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return TMTransactions_descriptor_;
+}
+
+const TMTransactions& TMTransactions::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_truechain_2eproto();
+  return *default_instance_;
+}
+
+TMTransactions* TMTransactions::default_instance_ = NULL;
+
+TMTransactions* TMTransactions::New() const {
+  return new TMTransactions;
+}
+
+void TMTransactions::Clear() {
+  transactions_.Clear();
+  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+  mutable_unknown_fields()->Clear();
+}
+
+bool TMTransactions::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!(EXPRESSION)) return false
+  ::google::protobuf::uint32 tag;
+  while ((tag = input->ReadTag()) != 0) {
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // repeated .protocol.TMTransaction transactions = 1;
+      case 1: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+         parse_transactions:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
+                input, add_transactions()));
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(10)) goto parse_transactions;
+        if (input->ExpectAtEnd()) return true;
+        break;
+      }
+
+      default: {
+      handle_uninterpreted:
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          return true;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+  return true;
+#undef DO_
+}
+
+void TMTransactions::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // repeated .protocol.TMTransaction transactions = 1;
+  for (int i = 0; i < this->transactions_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      1, this->transactions(i), output);
+  }
+
+  if (!unknown_fields().empty()) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        unknown_fields(), output);
+  }
+}
+
+::google::protobuf::uint8* TMTransactions::SerializeWithCachedSizesToArray(
+    ::google::protobuf::uint8* target) const {
+  // repeated .protocol.TMTransaction transactions = 1;
+  for (int i = 0; i < this->transactions_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteMessageNoVirtualToArray(
+        1, this->transactions(i), target);
+  }
+
+  if (!unknown_fields().empty()) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        unknown_fields(), target);
+  }
+  return target;
+}
+
+int TMTransactions::ByteSize() const {
+  int total_size = 0;
+
+  // repeated .protocol.TMTransaction transactions = 1;
+  total_size += 1 * this->transactions_size();
+  for (int i = 0; i < this->transactions_size(); i++) {
+    total_size +=
+      ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
+        this->transactions(i));
+  }
+
+  if (!unknown_fields().empty()) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        unknown_fields());
+  }
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void TMTransactions::MergeFrom(const ::google::protobuf::Message& from) {
+  GOOGLE_CHECK_NE(&from, this);
+  const TMTransactions* source =
+    ::google::protobuf::internal::dynamic_cast_if_available<const TMTransactions*>(
+      &from);
+  if (source == NULL) {
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+    MergeFrom(*source);
+  }
+}
+
+void TMTransactions::MergeFrom(const TMTransactions& from) {
+  GOOGLE_CHECK_NE(&from, this);
+  transactions_.MergeFrom(from.transactions_);
+  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
+}
+
+void TMTransactions::CopyFrom(const ::google::protobuf::Message& from) {
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void TMTransactions::CopyFrom(const TMTransactions& from) {
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool TMTransactions::IsInitialized() const {
+
+  for (int i = 0; i < transactions_size(); i++) {
+    if (!this->transactions(i).IsInitialized()) return false;
+  }
+  return true;
+}
+
+void TMTransactions::Swap(TMTransactions* other) {
+  if (other != this) {
+    transactions_.Swap(&other->transactions_);
+    std::swap(_has_bits_[0], other->_has_bits_[0]);
+    _unknown_fields_.Swap(&other->_unknown_fields_);
+    std::swap(_cached_size_, other->_cached_size_);
+  }
+}
+
+::google::protobuf::Metadata TMTransactions::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = TMTransactions_descriptor_;
+  metadata.reflection = TMTransactions_reflection_;
+  return metadata;
+}
+
+
 // ===================================================================
 
 #ifndef _MSC_VER
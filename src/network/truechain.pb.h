@@ -40,6 +40,7 @@ class TMClusterNode;
 class TMLoadSource;
 class TMCluster;
 class TMTransaction;
+class TMTransactions;
 class TMStatusChange;
 class TMProposeSet;
 class TMHaveTransactionSet;
@@ -136,6 +137,7 @@ enum MessageType {
   mtPROPOSE_LEDGER = 33,
   mtSTATUS_CHANGE = 34,
   mtHAVE_SET = 35,
+  mtTRANSACTIONS = 36,
   mtVALIDATION = 41,
   mtGET_OBJECTS = 42
 };
@@ -246,11 +248,13 @@ enum TMLedgerInfoType {
   liBASE = 0,
   liTX_NODE = 1,
   liAS_NODE = 2,
-  liTS_CANDIDATE = 3
+  liTS_CANDIDATE = 3,
+  liTS_SKETCH = 4,
+  liAS_LEAVES = 5
 };
 bool TMLedgerInfoType_IsValid(int value);
 const TMLedgerInfoType TMLedgerInfoType_MIN = liBASE;
-const TMLedgerInfoType TMLedgerInfoType_MAX = liTS_CANDIDATE;
+const TMLedgerInfoType TMLedgerInfoType_MAX = liAS_LEAVES;
 const int TMLedgerInfoType_ARRAYSIZE = TMLedgerInfoType_MAX + 1;
 
 const ::google::protobuf::EnumDescriptor* TMLedgerInfoType_descriptor();
@@ -1190,6 +1194,91 @@ class TMTransaction : public ::google::protobuf::Message {
 };
 // -------------------------------------------------------------------
 
+class TMTransactions : public ::google::protobuf::Message {
+ public:
+  TMTransactions();
+  virtual ~TMTransactions();
+
+  TMTransactions(const TMTransactions& from);
+
+  inline TMTransactions& operator=(const TMTransactions& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
+    return _unknown_fields_;
+  }
+
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
+    return &_unknown_fields_;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const TMTransactions& default_instance();
+
+  void Swap(TMTransactions* other);
+
+  // implements Message ----------------------------------------------
+
+  TMTransactions* New() const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const TMTransactions& from);
+  void MergeFrom(const TMTransactions& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const;
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // repeated .protocol.TMTransaction transactions = 1;
+  inline int transactions_size() const;
+  inline void clear_transactions();
+  static const int kTransactionsFieldNumber = 1;
+  inline const ::protocol::TMTransaction& transactions(int index) const;
+  inline ::protocol::TMTransaction* mutable_transactions(int index);
+  inline ::protocol::TMTransaction* add_transactions();
+  inline const ::google::protobuf::RepeatedPtrField< ::protocol::TMTransaction >&
+      transactions() const;
+  inline ::google::protobuf::RepeatedPtrField< ::protocol::TMTransaction >*
+      mutable_transactions();
+
+  // @@protoc_insertion_point(class_scope:protocol.TMTransactions)
+ private:
+
+  ::google::protobuf::UnknownFieldSet _unknown_fields_;
+
+  ::google::protobuf::RepeatedPtrField< ::protocol::TMTransaction > transactions_;
+
+  mutable int _cached_size_;
+  ::google::protobuf::uint32 _has_bits_[(1 + 31) / 32];
+
+  friend void  protobuf_AddDesc_truechain_2eproto();
+  friend void protobuf_AssignDesc_truechain_2eproto();
+  friend void protobuf_ShutdownFile_truechain_2eproto();
+
+  void InitAsDefaultInstance();
+  static TMTransactions* default_instance_;
+};
+// -------------------------------------------------------------------
+
 class TMStatusChange : public ::google::protobuf::Message {
  public:
   TMStatusChange();
@@ -4512,6 +4601,35 @@ inline void TMTransaction::set_deferred(bool value) {
 
 // -------------------------------------------------------------------
 
+// TMTransactions
+
+// repeated .protocol.TMTransaction transactions = 1;
+inline int TMTransactions::transactions_size() const {
+  return transactions_.size();
+}
+inline void TMTransactions::clear_transactions() {
+  transactions_.Clear();
+}
+inline const ::protocol::TMTransaction& TMTransactions::transactions(int index) const {
+  return transactions_.Get(index);
+}
+inline ::protocol::TMTransaction* TMTransactions::mutable_transactions(int index) {
+  return transactions_.Mutable(index);
+}
+inline ::protocol::TMTransaction* TMTransactions::add_transactions() {
+  return transactions_.Add();
+}
+inline const ::google::protobuf::RepeatedPtrField< ::protocol::TMTransaction >&
+TMTransactions::transactions() const {
+  return transactions_;
+}
+inline ::google::protobuf::RepeatedPtrField< ::protocol::TMTransaction >*
+TMTransactions::mutable_transactions() {
+  return &transactions_;
+}
+
+// -------------------------------------------------------------------
+
 // TMStatusChange
 
 // optional .protocol.NodeStatus newStatus = 1;
@@ -278,6 +278,9 @@ JSS ( port );                       // in: Connect
 JSS ( previous_ledger );            // out: LedgerPropose
 JSS ( proof );                      // in: BookOffers
 JSS ( propose_seq );                // out: LedgerPropose
+JSS ( proposed_pub_dropped );       // out: GetCounts
+JSS ( proposed_pub_published );     // out: GetCounts
+JSS ( proposed_pub_queue );         // out: GetCounts
 JSS ( proposers );                  // out: NetworkOPs, LedgerConsensus
 JSS ( protocol );                   // out: PeerImp
 JSS ( pubkey_node );                // out: NetworkOPs
@@ -339,6 +342,9 @@ JSS ( sub_index );                  // in: LedgerEntry
 JSS ( subcommand );                 // in: PathFind
 JSS ( success );                    // rpc
 JSS ( supported );                  // out: AmendmentTableImpl
+JSS ( suppression_hits );           // out: GetCounts
+JSS ( suppression_lookups );        // out: GetCounts
+JSS ( suppression_size );           // out: GetCounts
 JSS ( system_time_offset );         // out: NetworkOPs
 JSS ( taker );                      // in: Subscribe, BookOffers
 JSS ( taker_gets );                 // in: Subscribe, Unsubscribe, BookOffers
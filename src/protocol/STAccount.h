@@ -71,8 +71,8 @@ public:
     template <typename Tag>
     void setValueH160 (base_uint<160, Tag> const& v)
     {
-        peekValue () = Buffer (v.data (), v.size ());
-        assert (peekValue ().size () == (160 / 8));
+        setValue (v.data (), v.size ());
+        assert (size () == (160 / 8));
     }
 
     template <typename Tag>
@@ -80,7 +80,7 @@ public:
     {
         auto success = isValueH160 ();
         if (success)
-            memcpy (v.begin (), peekValue ().data (), (160 / 8));
+            memcpy (v.begin (), data (), (160 / 8));
         return success;
     }
 
@@ -38,8 +38,16 @@ public:
     STBlob () = default;
     STBlob (STBlob const& rhs)
         :STBase(rhs)
-        , value_ (rhs.data (), rhs.size ())
     {
+        assign (rhs.data (), rhs.size ());
+    }
+
+    STBlob (STBlob&& rhs)
+        : STBase (rhs)
+        , value_ (std::move (rhs.value_))
+        , inlineSize_ (rhs.inlineSize_)
+    {
+        std::memcpy (inline_, rhs.inline_, inlineSize_);
     }
 
     /** Construct with size and initializer.
@@ -49,20 +57,22 @@ public:
     template <class Init>
     STBlob (SField const& f, std::size_t size,
             Init&& init)
-        : STBase(f), value_ (size)
+        : STBase(f)
     {
-        init(value_.data(), value_.size());
+        init(allocate (size), size);
     }
 
     STBlob (SField const& f,
             void const* data, std::size_t size)
-        : STBase(f), value_ (data, size)
+        : STBase(f)
     {
+        assign (data, size);
     }
 
     STBlob (SField const& f, Buffer&& b)
-       : STBase(f), value_(std::move (b))
+       : STBase(f)
     {
+        setValue (std::move (b));
     }
 
     STBlob (SField const& n)
@@ -87,14 +97,13 @@ public:
     std::size_t
     size() const
     {
-        return value_.size();
+        return value_.empty () ? inlineSize_ : value_.size ();
     }
 
     std::uint8_t const*
     data() const
     {
-        return reinterpret_cast<
-            std::uint8_t const*>(value_.data());
+        return value_.empty () ? inline_ : value_.data ();
     }
 
     SerializedTypeID
@@ -112,38 +121,33 @@ public:
         assert (fName->isBinary ());
         assert ((fName->fieldType == STI_VL) ||
             (fName->fieldType == STI_ACCOUNT));
-        s.addVL (value_.data (), value_.size ());
-    }
-
-    Buffer const&
-    peekValue () const
-    {
-        return value_;
-    }
-
-    Buffer&
-    peekValue ()
-    {
-        return value_;
+        s.addVL (data (), size ());
     }
 
     Buffer
     getValue () const
     {
-        return Buffer(value_.data (), value_.size ());
+        return Buffer(data (), size ());
     }
 
     void
     setValue (Buffer&& b)
     {
-        value_ = std::move (b);
+        if (b.size () <= maximumInline)
+        {
+            assign (b.data (), b.size ());
+        }
+        else
+        {
+            value_ = std::move (b);
+            inlineSize_ = 0;
+        }
     }
 
     void
     setValue (void const* data, std::size_t size)
     {
-        value_.alloc (size);
-        std::memcpy(value_.data(), data, size);
+        assign (data, size);
     }
 
     bool
@@ -152,11 +156,46 @@ public:
     bool
     isDefault () const override
     {
-        return value_.empty ();
+        return size () == 0;
     }
 
 private:
+    enum
+    {
+        // Enough for account IDs, hashes and compressed public keys while
+        // keeping the object within the inline storage of an STVar.
+        maximumInline = 39
+    };
+
+    // Returns storage for size bytes, discarding the current value.
+    std::uint8_t*
+    allocate (std::size_t size)
+    {
+        if (size <= maximumInline)
+        {
+            value_.clear ();
+            inlineSize_ = static_cast<std::uint8_t> (size);
+            return inline_;
+        }
+
+        inlineSize_ = 0;
+        return value_.alloc (size);
+    }
+
+    void
+    assign (void const* data, std::size_t size)
+    {
+        if (size != 0)
+            std::memcpy (allocate (size), data, size);
+        else
+            allocate (0);
+    }
+
+    // Large values live in value_; small ones are kept in inline_ so
+    // that parsing and copying them needs no allocation.
     Buffer value_;
+    std::uint8_t inline_[maximumInline];
+    std::uint8_t inlineSize_ = 0;
 };
 
 } // truechain
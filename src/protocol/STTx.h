@@ -139,11 +139,9 @@ public:
             try
             {
                 STArray const& stArr = getFieldArray(sfOperations);
+                txs.reserve(txs.size() + stArr.size());
                 for (auto i : stArr)
-                {
-                    STTx::pointer stx = std::make_shared<STTx>(std::move(i));
-                    txs.push_back(*stx);
-                }
+                    txs.emplace_back(std::move(i));
             }
             catch (...)
             {
@@ -406,6 +406,13 @@ public:
     Buffer
     getVLBuffer();
 
+    /** Read a variable length field into storage from a BufferFactory.
+        The factory is called once with the size of the field.
+    */
+    template <class BufferFactory>
+    void
+    getVL (BufferFactory&& factory);
+
 private:
     int getVLDataLength ();
 
@@ -429,6 +436,21 @@ SerialIter::getBitString()
     return u;
 }
 
+template <class BufferFactory>
+void
+SerialIter::getVL (BufferFactory&& factory)
+{
+    std::size_t const n = getVLDataLength ();
+    if (remain_ < n)
+        throw std::runtime_error(
+            "invalid SerialIter getRaw");
+    if (n != 0)
+        std::memcpy (factory (n), p_, n);
+    p_ += n;
+    used_ += n;
+    remain_ -= n;
+}
+
 //------------------------------------------------------------------------------
 
 uint256
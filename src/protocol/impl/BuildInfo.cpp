@@ -58,7 +58,7 @@ getCurrentProtocol ()
     // The protocol version we speak and prefer (edit this if necessary)
     //
         1,  // major
-        2   // minor
+        3   // minor
     //
     //--------------------------------------------------------------------------
     );
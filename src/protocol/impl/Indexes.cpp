@@ -19,16 +19,121 @@
 
 #include <BeastConfig.h>
 #include <protocol/Indexes.h>
+#include <array>
+#include <cstring>
 
 namespace truechain {
 
+namespace {
+
+// The bytes hashed to form an index, gathered on the stack in the same
+// layout Serializer would produce.
+class IndexKey
+{
+public:
+    enum
+    {
+        // A trust state: the space, four 160 bit values and a type
+        maximumSize = 86
+    };
+
+    explicit
+    IndexKey (std::uint16_t space)
+        : size_ (0)
+    {
+        add16 (space);
+    }
+
+    void
+    add16 (std::uint16_t i)
+    {
+        assert (size_ + 2 <= maximumSize);
+        data_[size_++] = static_cast<unsigned char> (i >> 8);
+        data_[size_++] = static_cast<unsigned char> (i & 0xff);
+    }
+
+    void
+    add32 (std::uint32_t i)
+    {
+        add16 (static_cast<std::uint16_t> (i >> 16));
+        add16 (static_cast<std::uint16_t> (i & 0xffff));
+    }
+
+    void
+    add64 (std::uint64_t i)
+    {
+        add32 (static_cast<std::uint32_t> (i >> 32));
+        add32 (static_cast<std::uint32_t> (i & 0xffffffff));
+    }
+
+    template <std::size_t Bits, class Tag>
+    void
+    add (base_uint<Bits, Tag> const& value)
+    {
+        assert (size_ + value.bytes <= maximumSize);
+        std::memcpy (&data_[size_], value.data (), value.bytes);
+        size_ += value.bytes;
+    }
+
+    uint256
+    hash () const
+    {
+        return getSHA512Half (data_.data (), size_);
+    }
+
+    // Like hash(), but answered from a small per-thread table of recent
+    // keys when possible. Path finding and transactors ask for the same
+    // account roots, owner directories and trust lines over and over.
+    uint256
+    memoized () const
+    {
+        enum
+        {
+            memoSize = 256
+        };
+
+        struct Entry
+        {
+            std::size_t size = 0;
+            std::array <unsigned char, maximumSize> data;
+            uint256 index;
+        };
+
+        static thread_local std::array <Entry, memoSize> memo;
+
+        // Account and currency codes are hashes or fixed codes, so mixing
+        // the bytes cheaply spreads them well enough over the table.
+        std::size_t slot = size_;
+        for (std::size_t i = 0; i < size_; ++i)
+            slot = (slot * 31) + data_[i];
+
+        Entry& entry = memo[slot % memoSize];
+
+        if (entry.size == size_ &&
+            std::memcmp (entry.data.data (), data_.data (), size_) == 0)
+        {
+            return entry.index;
+        }
+
+        entry.index = hash ();
+        entry.size = size_;
+        std::memcpy (entry.data.data (), data_.data (), size_);
+        return entry.index;
+    }
+
+private:
+    std::array <unsigned char, maximumSize> data_;
+    std::size_t size_;
+};
+
+}
+
 // get the index of the node that holds the last 256 ledgers
 uint256
 getLedgerHashIndex ()
 {
-    Serializer s (2);
-    s.add16 (spaceSkipList);
-    return s.getSHA512Half ();
+    static uint256 const index = IndexKey (spaceSkipList).hash ();
+    return index;
 }
 
 // Get the index of the node that holds the set of 256 ledgers that includes
@@ -37,39 +142,33 @@ getLedgerHashIndex ()
 uint256
 getLedgerHashIndex (std::uint32_t desiredLedgerIndex)
 {
-    Serializer s (6);
-    s.add16 (spaceSkipList);
-    s.add32 (desiredLedgerIndex >> 16);
-    return s.getSHA512Half ();
+    IndexKey k (spaceSkipList);
+    k.add32 (desiredLedgerIndex >> 16);
+    return k.hash ();
 }
 
 // get the index of the node that holds the enabled amendments
 uint256
 getLedgerAmendmentIndex ()
 {
-    Serializer s (2);
-    s.add16 (spaceAmendment);
-    return s.getSHA512Half ();
+    static uint256 const index = IndexKey (spaceAmendment).hash ();
+    return index;
 }
 
 // get the index of the node that holds the fee schedule
 uint256
 getLedgerFeeIndex ()
 {
-    Serializer s (2);
-    s.add16 (spaceFee);
-    return s.getSHA512Half ();
+    static uint256 const index = IndexKey (spaceFee).hash ();
+    return index;
 }
 
 uint256
 getAccountRootIndex (Account const& account)
 {
-    Serializer  s (22);
-
-    s.add16 (spaceAccount);
-    s.add160 (account);
-
-    return s.getSHA512Half ();
+    IndexKey k (spaceAccount);
+    k.add (account);
+    return k.memoized ();
 }
 
 uint256
@@ -81,52 +180,41 @@ getAccountRootIndex (const SkywellAddress & account)
 uint256
 getGeneratorIndex (Account const& uGeneratorID)
 {
-    Serializer  s (22);
-
-    s.add16 (spaceGenerator);
-    s.add160 (uGeneratorID);
-
-    return s.getSHA512Half ();
+    IndexKey k (spaceGenerator);
+    k.add (uGeneratorID);
+    return k.hash ();
 }
 
 uint256
 getBookBase (Book const& book)
 {
-    Serializer  s (82);
-
     assert (isConsistent (book));
 
-    s.add16 (spaceBookDir);
-    s.add160 (book.in.currency);
-    s.add160 (book.out.currency);
-    s.add160 (book.in.account);
-    s.add160 (book.out.account);
+    IndexKey k (spaceBookDir);
+    k.add (book.in.currency);
+    k.add (book.out.currency);
+    k.add (book.in.account);
+    k.add (book.out.account);
 
     // Return with quality 0.
-    return getQualityIndex (s.getSHA512Half ());
+    return getQualityIndex (k.memoized ());
 }
 
 uint256
 getOfferIndex (Account const& account, std::uint32_t uSequence)
 {
-    Serializer  s (26);
-
-    s.add16 (spaceOffer);
-    s.add160 (account);
-    s.add32 (uSequence);
-
-    return s.getSHA512Half ();
+    IndexKey k (spaceOffer);
+    k.add (account);
+    k.add32 (uSequence);
+    return k.hash ();
 }
 
 uint256
 getOwnerDirIndex (Account const& account)
 {
-    Serializer  s (22);
-
-    s.add16 (spaceOwnerDir);
-    s.add160 (account);
-
-    return s.getSHA512Half ();
+    IndexKey k (spaceOwnerDir);
+    k.add (account);
+    return k.memoized ();
 }
 
 
@@ -135,13 +223,10 @@ getDirNodeIndex (uint256 const& uDirRoot, const std::uint64_t uNodeIndex)
 {
     if (uNodeIndex)
     {
-        Serializer  s (42);
-
-        s.add16 (spaceDirNode);
-        s.add256 (uDirRoot);
-        s.add64 (uNodeIndex);
-
-        return s.getSHA512Half ();
+        IndexKey k (spaceDirNode);
+        k.add (uDirRoot);
+        k.add64 (uNodeIndex);
+        return k.hash ();
     }
     else
     {
@@ -181,36 +266,31 @@ getQuality (uint256 const& uBase)
 uint256
 getTicketIndex (Account const& account, std::uint32_t uSequence)
 {
-    Serializer  s (26);
-
-    s.add16 (spaceTicket);
-    s.add160 (account);
-    s.add32 (uSequence);
-
-    return s.getSHA512Half ();
+    IndexKey k (spaceTicket);
+    k.add (account);
+    k.add32 (uSequence);
+    return k.hash ();
 }
 
 uint256
 getSkywellStateIndex (Account const& a, Account const& b, Currency const& currency)
 {
-    Serializer  s (62);
-
-    s.add16 (spaceSkywell);
+    IndexKey k (spaceSkywell);
 
     if (a < b)
     {
-        s.add160 (a);
-        s.add160 (b);
+        k.add (a);
+        k.add (b);
     }
     else
     {
-        s.add160 (b);
-        s.add160 (a);
+        k.add (b);
+        k.add (a);
     }
 
-    s.add160 (currency);
+    k.add (currency);
 
-    return s.getSHA512Half ();
+    return k.memoized ();
 }
 
 uint256
@@ -222,49 +302,39 @@ getSkywellStateIndex (Account const& a, Issue const& issue)
 
 uint256 getTrustStateIndex (Account const& a, Account const& b, std::uint32_t uType,Account const& issuer,Currency const& currency)
 {
-    Serializer  s (62);
-
-    s.add16 (spaceTrust);
+    IndexKey k (spaceTrust);
 
     if (a < b)
     {
-        s.add160 (a);
-        s.add160 (b);
+        k.add (a);
+        k.add (b);
     }
     else
     {
-        s.add160 (b);
-        s.add160 (a);
+        k.add (b);
+        k.add (a);
     }
-    s.add32 (uType);
+    k.add32 (uType);
 
-    s.add160 (issuer);
-    s.add160 (currency);
+    k.add (issuer);
+    k.add (currency);
 
-    return s.getSHA512Half ();
+    return k.hash ();
 }
 
 uint256 getSignStateIndex(Account const& a)
 {
-	Serializer  s(22);
-
-	s.add16(spaceSign);
-
-	s.add160(a);
-
-	return s.getSHA512Half();
+	IndexKey k (spaceSign);
+	k.add (a);
+	return k.memoized ();
 }
 
 uint256 getNickNameIndex(Account  const &a)
 {
 
-	Serializer  s(22);
-
-	s.add16(spaceNickname);
-
-	s.add160(a);
-
-	return s.getSHA512Half();
+	IndexKey k (spaceNickname);
+	k.add (a);
+	return k.hash ();
 }
 uint256
 getNickNameIndex(const SkywellAddress & account)
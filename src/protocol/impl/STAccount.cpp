@@ -23,7 +23,7 @@
 namespace truechain {
 
 STAccount::STAccount (SerialIter& sit, SField const& name)
-    : STAccount(name, sit.getVLBuffer())
+    : STBlob (sit, name)
 {
 }
 
@@ -42,7 +42,7 @@ std::string STAccount::getText () const
 STAccount*
 STAccount::construct (SerialIter& u, SField const& name)
 {
-    return new STAccount (name, u.getVLBuffer ());
+    return new STAccount (u, name);
 }
 
 STAccount::STAccount (SField const& n, Account const& v)
@@ -52,7 +52,7 @@ STAccount::STAccount (SField const& n, Account const& v)
 
 bool STAccount::isValueH160 () const
 {
-    return peekValue ().size () == (160 / 8);
+    return size () == (160 / 8);
 }
 
 SkywellAddress STAccount::getValueNCA () const
@@ -25,21 +25,25 @@ namespace truechain {
 
 STBlob::STBlob (SerialIter& st, SField const& name)
     : STBase (name)
-    , value_ (st.getVLBuffer ())
 {
+    st.getVL ([this](std::size_t size)
+    {
+        return allocate (size);
+    });
 }
 
 std::string
 STBlob::getText () const
 {
-    return strHex (value_.data (), value_.size ());
+    return strHex (data (), size ());
 }
 
 bool
 STBlob::isEquivalent (const STBase& t) const
 {
     const STBlob* v = dynamic_cast<const STBlob*> (&t);
-    return v && (value_ == v->value_);
+    return v && (size () == v->size ()) &&
+        (std::memcmp (data (), v->data (), size ()) == 0);
 }
 
 } // truechain
@@ -27,9 +27,69 @@
 #include <protocol/STObject.h>
 #include <protocol/STParsedJSON.h>
 #include <beast/cxx14/memory.h> // <memory>
+#include <deque>
 
 namespace truechain {
 
+namespace {
+
+// The fields of an object being parsed are gathered in a list kept per
+// thread, one for each level of nested objects, and then moved into the
+// object in one go. The lists keep their capacity, so parsing an object
+// allocates its field list once instead of growing it field by field.
+class ParseScratch
+{
+public:
+    using list_type = std::vector<detail::STVar>;
+
+    ParseScratch ()
+        : fields_ (level (depth ()++))
+    {
+        fields_.clear ();
+    }
+
+    ~ParseScratch ()
+    {
+        fields_.clear ();
+        --depth ();
+    }
+
+    ParseScratch (ParseScratch const&) = delete;
+    ParseScratch& operator= (ParseScratch const&) = delete;
+
+    list_type&
+    fields ()
+    {
+        return fields_;
+    }
+
+private:
+    static
+    std::size_t&
+    depth ()
+    {
+        static thread_local std::size_t depth = 0;
+        return depth;
+    }
+
+    static
+    list_type&
+    level (std::size_t n)
+    {
+        // A deque leaves the outer levels in place as inner ones are added
+        static thread_local std::deque<list_type> levels;
+
+        while (levels.size () <= n)
+            levels.emplace_back ();
+
+        return levels[n];
+    }
+
+    list_type& fields_;
+};
+
+}
+
 STObject::~STObject()
 {
 #if 0
@@ -105,7 +165,12 @@ bool STObject::setType (const SOTemplate& type)
 {
     bool valid = true;
     mType = &type;
-    decltype(v_) v;
+
+    // Reordering into a per thread list lets the object keep its own
+    // storage when it is already large enough.
+    static thread_local decltype(v_) scratch;
+    auto& v = scratch;
+    v.clear();
     v.reserve(type.peek().size());
     for (auto const& e : type.peek())
     {
@@ -147,9 +212,13 @@ bool STObject::setType (const SOTemplate& type)
             valid = false;
         }
     }
-    // Swap the template matching data in for the old data,
+    // Move the template matching data in for the old data,
     // freeing any leftover junk
-    v_.swap(v);
+    v_.clear();
+    v_.reserve(v.size());
+    for (auto& e : v)
+        v_.emplace_back(std::move(e));
+    v.clear();
     return valid;
 }
 
@@ -182,6 +251,9 @@ bool STObject::set (SerialIter& sit, int depth)
 
     v_.clear();
 
+    ParseScratch scratch;
+    auto& fields = scratch.fields();
+
     // Consume data in the pipe until we run out or reach the end
     //
     while (!reachedEndOfObject && !sit.empty ())
@@ -217,10 +289,14 @@ bool STObject::set (SerialIter& sit, int depth)
             }
 
             // Unflatten the field
-            v_.emplace_back(sit, fn);
+            fields.emplace_back(sit, fn);
         }
     }
 
+    v_.reserve(fields.size());
+    for (auto& e : fields)
+        v_.emplace_back(std::move(e));
+
     return reachedEndOfObject;
 }
 
@@ -84,6 +84,17 @@ TxFormats::TxFormats ()
         << SOElement (sfReserveIncrement,    SOE_REQUIRED)
         ;
 
+    add ("OfferCreate", ttOFFER_CREATE)
+        << SOElement (sfTakerPays,           SOE_REQUIRED)
+        << SOElement (sfTakerGets,           SOE_REQUIRED)
+        << SOElement (sfExpiration,          SOE_OPTIONAL)
+        << SOElement (sfOfferSequence,       SOE_OPTIONAL)
+        ;
+
+    add ("OfferCancel", ttOFFER_CANCEL)
+        << SOElement (sfOfferSequence,       SOE_REQUIRED)
+        ;
+
     add ("TicketCreate", ttTICKET_CREATE)
         << SOElement (sfTarget,              SOE_OPTIONAL)
         << SOElement (sfExpiration,          SOE_OPTIONAL)
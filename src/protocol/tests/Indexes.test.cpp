@@ -0,0 +1,368 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <protocol/Indexes.h>
+#include <beast/unit_test/suite.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace truechain {
+
+// The index helpers as they were, hashing through a Serializer
+namespace reference {
+
+uint256
+getAccountRootIndex (Account const& account)
+{
+    Serializer s (22);
+    s.add16 (spaceAccount);
+    s.add160 (account);
+    return s.getSHA512Half ();
+}
+
+uint256
+getOwnerDirIndex (Account const& account)
+{
+    Serializer s (22);
+    s.add16 (spaceOwnerDir);
+    s.add160 (account);
+    return s.getSHA512Half ();
+}
+
+uint256
+getSignStateIndex (Account const& account)
+{
+    Serializer s (22);
+    s.add16 (spaceSign);
+    s.add160 (account);
+    return s.getSHA512Half ();
+}
+
+uint256
+getGeneratorIndex (Account const& generator)
+{
+    Serializer s (22);
+    s.add16 (spaceGenerator);
+    s.add160 (generator);
+    return s.getSHA512Half ();
+}
+
+uint256
+getNickNameIndex (Account const& account)
+{
+    Serializer s (22);
+    s.add16 (spaceNickname);
+    s.add160 (account);
+    return s.getSHA512Half ();
+}
+
+uint256
+getBookBase (Book const& book)
+{
+    Serializer s (82);
+    s.add16 (spaceBookDir);
+    s.add160 (book.in.currency);
+    s.add160 (book.out.currency);
+    s.add160 (book.in.account);
+    s.add160 (book.out.account);
+    return getQualityIndex (s.getSHA512Half ());
+}
+
+uint256
+getOfferIndex (Account const& account, std::uint32_t sequence)
+{
+    Serializer s (26);
+    s.add16 (spaceOffer);
+    s.add160 (account);
+    s.add32 (sequence);
+    return s.getSHA512Half ();
+}
+
+uint256
+getTicketIndex (Account const& account, std::uint32_t sequence)
+{
+    Serializer s (26);
+    s.add16 (spaceTicket);
+    s.add160 (account);
+    s.add32 (sequence);
+    return s.getSHA512Half ();
+}
+
+uint256
+getDirNodeIndex (uint256 const& root, std::uint64_t node)
+{
+    if (! node)
+        return root;
+
+    Serializer s (42);
+    s.add16 (spaceDirNode);
+    s.add256 (root);
+    s.add64 (node);
+    return s.getSHA512Half ();
+}
+
+uint256
+getSkywellStateIndex (Account const& a, Account const& b,
+    Currency const& currency)
+{
+    Serializer s (62);
+    s.add16 (spaceSkywell);
+    s.add160 (std::min (a, b));
+    s.add160 (std::max (a, b));
+    s.add160 (currency);
+    return s.getSHA512Half ();
+}
+
+uint256
+getTrustStateIndex (Account const& a, Account const& b, std::uint32_t type,
+    Account const& issuer, Currency const& currency)
+{
+    Serializer s (86);
+    s.add16 (spaceTrust);
+    s.add160 (std::min (a, b));
+    s.add160 (std::max (a, b));
+    s.add32 (type);
+    s.add160 (issuer);
+    s.add160 (currency);
+    return s.getSHA512Half ();
+}
+
+uint256
+getLedgerHashIndex (std::uint32_t ledger)
+{
+    Serializer s (6);
+    s.add16 (spaceSkipList);
+    s.add32 (ledger >> 16);
+    return s.getSHA512Half ();
+}
+
+uint256
+getSpaceIndex (LedgerNameSpace space)
+{
+    Serializer s (2);
+    s.add16 (space);
+    return s.getSHA512Half ();
+}
+
+}
+
+// Checks the index helpers against hashing through a Serializer
+class Indexes_test : public beast::unit_test::suite
+{
+public:
+    enum
+    {
+        // Several times the per thread memo, so keys share its slots
+        accountCount = 2000
+    };
+
+    static std::vector <Account>
+    makeAccounts ()
+    {
+        std::vector <Account> accounts;
+
+        for (int i = 0; i < accountCount; ++i)
+        {
+            Account a;
+            for (int j = 0; j < 20; ++j)
+                a.begin ()[j] = static_cast<std::uint8_t> (i * (j + 1));
+
+            // Neighbours differ in the last byte only
+            a.begin ()[19] = static_cast<std::uint8_t> (i);
+            a.begin ()[18] = static_cast<std::uint8_t> (i >> 8);
+            accounts.push_back (a);
+        }
+
+        return accounts;
+    }
+
+    void
+    testAccounts (std::vector <Account> const& accounts, std::string const& pass)
+    {
+        bool ok = true;
+
+        for (auto const& a : accounts)
+        {
+            ok = ok &&
+                (getAccountRootIndex (a) == reference::getAccountRootIndex (a)) &&
+                (getOwnerDirIndex (a) == reference::getOwnerDirIndex (a)) &&
+                (getSignStateIndex (a) == reference::getSignStateIndex (a)) &&
+                (getGeneratorIndex (a) == reference::getGeneratorIndex (a)) &&
+                (getNickNameIndex (a) == reference::getNickNameIndex (a));
+        }
+
+        expect (ok, pass + ": account indexes differ");
+    }
+
+    void
+    testPairs (std::vector <Account> const& accounts, std::string const& pass)
+    {
+        Currency const usd = to_currency ("USD");
+        Currency const cny = to_currency ("CNY");
+        bool ok = true;
+
+        for (std::size_t i = 0; i + 1 < accounts.size (); ++i)
+        {
+            Account const& a = accounts[i];
+            Account const& b = accounts[accounts.size () - 1 - i];
+            Currency const& c = (i % 2) ? usd : cny;
+
+            ok = ok &&
+                (getSkywellStateIndex (a, b, c) ==
+                    reference::getSkywellStateIndex (a, b, c)) &&
+                (getSkywellStateIndex (b, a, c) ==
+                    reference::getSkywellStateIndex (a, b, c)) &&
+                (getSkywellStateIndex (a, Issue (c, b)) ==
+                    reference::getSkywellStateIndex (a, b, c)) &&
+                (getTrustStateIndex (a, b, i, b, c) ==
+                    reference::getTrustStateIndex (a, b, i, b, c)) &&
+                (getOfferIndex (a, i) == reference::getOfferIndex (a, i)) &&
+                (getTicketIndex (a, i) == reference::getTicketIndex (a, i));
+
+            Book const book (Issue (c, a), Issue (xrpCurrency (), xrpAccount ()));
+            Book const reverse (book.out, book.in);
+
+            ok = ok &&
+                (getBookBase (book) == reference::getBookBase (book)) &&
+                (getBookBase (reverse) == reference::getBookBase (reverse));
+
+            uint256 const root = getOwnerDirIndex (a);
+            ok = ok &&
+                (getDirNodeIndex (root, i) ==
+                    reference::getDirNodeIndex (root, i)) &&
+                (getDirNodeIndex (root, i << 40) ==
+                    reference::getDirNodeIndex (root, i << 40));
+        }
+
+        expect (ok, pass + ": pair indexes differ");
+    }
+
+    void
+    testFixed ()
+    {
+        expect (getLedgerHashIndex () ==
+            reference::getSpaceIndex (spaceSkipList));
+        expect (getLedgerAmendmentIndex () ==
+            reference::getSpaceIndex (spaceAmendment));
+        expect (getLedgerFeeIndex () == reference::getSpaceIndex (spaceFee));
+
+        for (std::uint32_t seq : {0u, 1u, 255u, 65535u, 65536u, 1000000u,
+                0xffffffffu})
+        {
+            expect (getLedgerHashIndex (seq) ==
+                reference::getLedgerHashIndex (seq));
+        }
+    }
+
+    void
+    run ()
+    {
+        std::vector <Account> accounts = makeAccounts ();
+
+        testcase ("fixed indexes");
+        testFixed ();
+
+        testcase ("accounts");
+        testAccounts (accounts, "first pass");
+
+        // Again, so some answers come from the memo and some slots were
+        // taken over by other keys meanwhile
+        testAccounts (accounts, "second pass");
+        std::reverse (accounts.begin (), accounts.end ());
+        testAccounts (accounts, "reversed");
+
+        // A few keys asked for over and over are answered from the memo
+        std::vector <Account> const few (accounts.begin (),
+            accounts.begin () + 8);
+        for (int i = 0; i < 4; ++i)
+            testAccounts (few, "repeated");
+
+        testcase ("pairs, books and directories");
+        testPairs (accounts, "first pass");
+        testPairs (accounts, "second pass");
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(Indexes,protocol,truechain);
+
+//------------------------------------------------------------------------------
+
+// Times the index helpers against hashing through a Serializer
+class IndexesSpeed_test : public beast::unit_test::suite
+{
+public:
+    typedef std::chrono::high_resolution_clock clock_type;
+
+    enum
+    {
+        iterations = 1000000,
+
+        // About the accounts one payment path touches
+        workingSet = 16
+    };
+
+    void
+    measure (std::string const& what,
+        std::function <uint256 (Account const&)> const& f)
+    {
+        std::vector <Account> const all = Indexes_test::makeAccounts ();
+        std::vector <Account> const accounts (all.begin (),
+            all.begin () + workingSet);
+
+        uint256 sum;
+        auto const start = clock_type::now ();
+
+        for (int i = 0; i < iterations; ++i)
+            sum ^= f (accounts[i % workingSet]);
+
+        auto const elapsed = clock_type::now () - start;
+
+        volatile bool const used = sum.isNonZero ();
+        (void) used;
+
+        log << what << " " << (std::chrono::duration <double, std::nano> (
+            elapsed).count () / iterations) << "ns";
+    }
+
+    void
+    run ()
+    {
+        Currency const usd = to_currency ("USD");
+        Account const issuer = Indexes_test::makeAccounts ().back ();
+
+        measure ("account root, serializer:",
+            &reference::getAccountRootIndex);
+        measure ("account root:            ",
+            [] (Account const& a) { return getAccountRootIndex (a); });
+        measure ("trust line, serializer:  ", [&] (Account const& a)
+            { return reference::getSkywellStateIndex (a, issuer, usd); });
+        measure ("trust line:              ", [&] (Account const& a)
+            { return getSkywellStateIndex (a, issuer, usd); });
+
+        pass ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(IndexesSpeed,protocol,truechain);
+
+} // truechain
@@ -0,0 +1,218 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <protocol/STAccount.h>
+#include <protocol/STArray.h>
+#include <protocol/STBlob.h>
+#include <protocol/STObject.h>
+#include <beast/unit_test/suite.h>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace truechain {
+
+// Checks blobs on both sides of the inline storage limit, and objects
+// nested deeper than the per thread parse lists have seen before
+class STBlob_test : public beast::unit_test::suite
+{
+public:
+    static Buffer
+    makeValue (std::size_t size, std::uint8_t seed)
+    {
+        Buffer b (size);
+        for (std::size_t i = 0; i < size; ++i)
+            b.data ()[i] = static_cast<std::uint8_t> (seed + i * 7);
+        return b;
+    }
+
+    static Blob
+    makeBlob (std::size_t size, std::uint8_t seed)
+    {
+        Buffer const b = makeValue (size, seed);
+        return Blob (b.data (), b.data () + b.size ());
+    }
+
+    static bool
+    same (STBlob const& blob, Buffer const& value)
+    {
+        return (blob.size () == value.size ()) && ((value.size () == 0) ||
+            (std::memcmp (blob.data (), value.data (), value.size ()) == 0));
+    }
+
+    static Serializer
+    serialize (STBase const& st)
+    {
+        Serializer s;
+        st.add (s);
+        return s;
+    }
+
+    template <class Field>
+    void
+    testValue (SField const& field, std::size_t size)
+    {
+        std::string const what = field.getName () + " of " +
+            std::to_string (size) + " bytes";
+        Buffer const value = makeValue (size, size & 0xff);
+
+        Field const blob (field, makeValue (size, size & 0xff));
+        expect (same (blob, value), what + ": construct");
+
+        Serializer const s = serialize (blob);
+        SerialIter sit (s);
+        Field const parsed (sit, field);
+        expect (sit.empty (), what + ": left over");
+        expect (same (parsed, value), what + ": parse");
+        expect (parsed.isEquivalent (blob), what + ": isEquivalent");
+        expect (serialize (parsed).peekData () == s.peekData (),
+            what + ": serialize");
+
+        Field copied (parsed);
+        expect (same (copied, value), what + ": copy");
+        expect (same (parsed, value), what + ": copy source");
+
+        Field const moved (std::move (copied));
+        expect (same (moved, value), what + ": move");
+
+        // Through the inline storage of an STObject field
+        STObject object (sfGeneric);
+        object.emplace_back (moved);
+        STObject const objectCopy (object);
+        STObject const objectMoved (std::move (object));
+        expect (objectCopy.getCount () == 1, what + ": object copy");
+        expect (objectMoved.getCount () == 1, what + ": object move");
+        expect (objectCopy.peekAtIndex (0).isEquivalent (blob),
+            what + ": object copy value");
+        expect (objectMoved.peekAtIndex (0).isEquivalent (blob),
+            what + ": object move value");
+
+        // Replacing a value of one size with one of another
+        Field replaced (field, makeValue (100 - (size % 100), 3));
+        replaced.setValue (makeValue (size, size & 0xff));
+        expect (same (replaced, value), what + ": setValue");
+        replaced.setValue (value.data (), value.size ());
+        expect (same (replaced, value), what + ": setValue data");
+    }
+
+    template <class Field>
+    void
+    testValues (SField const& field)
+    {
+        for (std::size_t size : {0, 1, 20, 33, 38, 39, 40, 41, 64, 255,
+                256, 4096, 70000})
+            testValue <Field> (field, size);
+    }
+
+    // An object with a memo array, each memo holding the next level
+    static STObject
+    makeNested (SField const& name, int depth, int width)
+    {
+        STObject object (name);
+        object.setFieldVL (sfMemoType, makeBlob (depth * 10, depth));
+
+        if (depth > 0)
+        {
+            STArray memos (sfMemos);
+
+            for (int i = 0; i < width; ++i)
+            {
+                // Siblings differ so a reused list must start out empty
+                STObject memo = makeNested (sfMemo, depth - 1, width);
+                if (i % 2)
+                    memo.setFieldVL (sfMemoData, makeBlob (50 + i, i));
+                memos.push_back (std::move (memo));
+            }
+
+            object.setFieldArray (sfMemos, memos);
+        }
+
+        return object;
+    }
+
+    void
+    testNested ()
+    {
+        // Deep first, then shallow, then deeper than before
+        for (int depth : {6, 1, 0, 9, 3})
+        {
+            std::string const what = "depth " + std::to_string (depth);
+            STObject const object = makeNested (sfGeneric, depth, 2);
+            Serializer const s = serialize (object);
+
+            SerialIter sit (s);
+            STObject const parsed (sit, sfGeneric);
+            expect (sit.empty (), what + ": left over");
+            expect (parsed == object, what + ": parse");
+            expect (serialize (parsed).peekData () == s.peekData (),
+                what + ": serialize");
+
+            // The nesting matches, level by level
+            STObject const* level = &parsed;
+            for (int i = depth; i > 0; --i)
+            {
+                STArray const& memos = level->getFieldArray (sfMemos);
+                expect (memos.size () == 2, what + ": width");
+                if (memos.size () != 2)
+                    break;
+                expect (! memos[0].isFieldPresent (sfMemoData));
+                expect (memos[1].isFieldPresent (sfMemoData));
+                level = &memos[0];
+            }
+            expect (! level->isFieldPresent (sfMemos), what + ": depth");
+
+            // A parse that throws part way must not leave the lists in use
+            if (s.getDataLength () > 8)
+            {
+                Serializer truncated (s.peekData ().begin (),
+                    s.peekData ().end () - 8);
+                try
+                {
+                    SerialIter it (truncated);
+                    STObject const bad (it, sfGeneric);
+                }
+                catch (std::exception const&)
+                {
+                }
+
+                SerialIter again (s);
+                expect (STObject (again, sfGeneric) == object,
+                    what + ": parse after a failed parse");
+            }
+        }
+    }
+
+    void
+    run ()
+    {
+        testcase ("STBlob");
+        testValues <STBlob> (sfMemoData);
+
+        testcase ("STAccount");
+        testValues <STAccount> (sfAccount);
+
+        testcase ("nested objects");
+        testNested ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(STBlob,protocol,truechain);
+
+} // truechain
@@ -0,0 +1,193 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <protocol/Indexes.h>
+#include <protocol/STArray.h>
+#include <protocol/STLedgerEntry.h>
+#include <protocol/STTx.h>
+#include <beast/unit_test/suite.h>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <string>
+
+namespace truechain {
+namespace {
+
+// Heap allocations made by this thread
+thread_local std::size_t allocations = 0;
+
+}
+}
+
+// Counts every allocation in the process. Linking a suite links this
+// file, so these replace the global operators; they only add a thread
+// local increment to the allocation path.
+void*
+operator new (std::size_t size)
+{
+    ++truechain::allocations;
+
+    for (;;)
+    {
+        if (void* p = std::malloc (size ? size : 1))
+            return p;
+
+        std::new_handler const handler = std::set_new_handler (nullptr);
+        std::set_new_handler (handler);
+
+        if (! handler)
+            throw std::bad_alloc ();
+
+        handler ();
+    }
+}
+
+void
+operator delete (void* p) noexcept
+{
+    std::free (p);
+}
+
+namespace truechain {
+
+// Reports the heap allocations made parsing and copying typical objects
+class STObjectAllocations_test : public beast::unit_test::suite
+{
+public:
+    typedef std::chrono::high_resolution_clock clock_type;
+
+    enum
+    {
+        iterations = 100000
+    };
+
+    static Account
+    makeAccount (std::uint8_t seed)
+    {
+        Account a;
+        for (int i = 0; i < 20; ++i)
+            a.begin ()[i] = static_cast<std::uint8_t> (seed + i * 13);
+        return a;
+    }
+
+    // A signed payment carrying three memos
+    static Serializer
+    makePayment ()
+    {
+        STTx tx (ttPAYMENT);
+        tx.setFieldAccount (sfAccount, makeAccount (1));
+        tx.setFieldAccount (sfDestination, makeAccount (2));
+        tx.setFieldAmount (sfAmount, STAmount (1000000));
+        tx.setFieldAmount (sfFee, STAmount (10000));
+        tx.setFieldU32 (sfSequence, 7);
+        tx.setFieldVL (sfSigningPubKey, Blob (33, 2));
+        tx.setFieldVL (sfTxnSignature, Blob (71, 9));
+
+        STArray memos (sfMemos);
+        for (int i = 0; i < 3; ++i)
+        {
+            STObject memo (sfMemo);
+            memo.setFieldVL (sfMemoType, Blob (8, i));
+            memo.setFieldVL (sfMemoData, Blob (5 + i * 30, i));
+            memos.push_back (std::move (memo));
+        }
+        tx.setFieldArray (sfMemos, memos);
+
+        Serializer s;
+        tx.add (s);
+        return s;
+    }
+
+    static Serializer
+    makeAccountRoot ()
+    {
+        Account const account = makeAccount (3);
+        STLedgerEntry sle (ltACCOUNT_ROOT, getAccountRootIndex (account));
+        sle.setFieldAccount (sfAccount, account);
+        sle.setFieldAmount (sfBalance, STAmount (50000000));
+        sle.setFieldU32 (sfSequence, 12);
+        sle.setFieldU32 (sfOwnerCount, 2);
+        sle.setFieldH256 (sfPreviousTxnID, uint256 (5));
+        sle.setFieldU32 (sfPreviousTxnLgrSeq, 100);
+
+        Serializer s;
+        sle.add (s);
+        return s;
+    }
+
+    template <class Function>
+    void
+    measure (std::string const& what, Function&& f)
+    {
+        // Once first, so per thread storage is in place
+        f ();
+
+        std::size_t const before = allocations;
+        auto const start = clock_type::now ();
+
+        for (int i = 0; i < iterations; ++i)
+            f ();
+
+        auto const elapsed = clock_type::now () - start;
+        std::size_t const count = allocations - before;
+
+        log << std::setw (24) << what << " " << std::fixed <<
+            std::setprecision (1) <<
+            (static_cast<double> (count) / iterations) << " allocations, " <<
+            (std::chrono::duration<double, std::nano> (elapsed).count () /
+                iterations) << "ns";
+    }
+
+    void
+    run ()
+    {
+        Serializer const payment = makePayment ();
+        Serializer const accountRoot = makeAccountRoot ();
+        uint256 const index = getAccountRootIndex (makeAccount (3));
+
+        measure ("parse payment", [&]
+        {
+            SerialIter sit (payment);
+            STTx const tx (sit);
+        });
+
+        SerialIter sit (payment);
+        STTx const tx (sit);
+
+        measure ("copy payment", [&]
+        {
+            STTx const copy (tx);
+        });
+
+        measure ("parse account root", [&]
+        {
+            SerialIter sit (accountRoot);
+            STLedgerEntry const sle (sit, index);
+        });
+
+        pass ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(STObjectAllocations,protocol,truechain);
+
+} // truechain
@@ -25,6 +25,7 @@
 #include <protocol/SkywellAddress.h>
 #include <protocol/Book.h>
 #include <network/resource/Consumer.h>
+#include <services/rpc/WireFormat.h>
 #include <beast/threads/Stoppable.h>
 #include <mutex>
 
@@ -119,6 +120,16 @@ public:
     virtual void send (
         Json::Value const& jvObj, std::string const& sObj, bool broadcast);
 
+    /** The format this subscriber wants stream messages in. */
+    virtual RPC::WireFormat getWireFormat () const;
+
+    /** Send a message already encoded in getWireFormat().
+
+        Publishers use this to encode a message once for every subscriber
+        that shares a binary format.
+    */
+    virtual void sendEncoded (std::string const& message, bool broadcast);
+
     std::uint64_t getSeq ();
 
     void onSendEmpty ();
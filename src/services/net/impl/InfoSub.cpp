@@ -64,7 +64,7 @@ InfoSub::~InfoSub ()
         m_source.unsubAccountInternal
             (mSeq, mSubAccountInfo_t, true);
 
-    if (! mSubAccountInfo_t.empty ())
+    if (! mSubAccountInfo_f.empty ())
         m_source.unsubAccountInternal
             (mSeq, mSubAccountInfo_f, false);
 }
@@ -80,6 +80,19 @@ void InfoSub::send (
     send (jvObj, broadcast);
 }
 
+RPC::WireFormat InfoSub::getWireFormat () const
+{
+    return RPC::WireFormat::json;
+}
+
+void InfoSub::sendEncoded (std::string const& message, bool broadcast)
+{
+    // Only subscribers that report a binary format are handed these.
+    Json::Value jvObj;
+    if (RPC::parseRequest (message, getWireFormat (), jvObj))
+        send (jvObj, broadcast);
+}
+
 std::uint64_t InfoSub::getSeq ()
 {
     return mSeq;
@@ -39,6 +39,11 @@ Status doCommand (RPC::Context&, Json::Value&, YieldStrategy const& s = {});
 /** Execute an RPC command and store the results in an std::string. */
 void executeRPC (RPC::Context&, std::string&, YieldStrategy const& s = {});
 
+/** Execute an RPC command and write the results to an Output as they are
+    produced. */
+void executeRPC (
+    RPC::Context&, Json::Output const&, YieldStrategy const& s = {});
+
 Role roleRequired (std::string const& method );
 
 // class Transaction;
@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_RPC_WIREFORMAT_H_INCLUDED
+#define SKYWELL_RPC_WIREFORMAT_H_INCLUDED
+
+#include <common/json/json_value.h>
+#include <common/json/Output.h>
+#include <string>
+
+namespace truechain {
+namespace RPC {
+
+/** How requests, responses and stream messages are encoded on a connection.
+
+    JSON is the default.  A client selects CBOR (RFC 7049) by sending
+    "Accept: application/cbor" with a JSON-RPC request, or by asking for the
+    "truechain-cbor" WebSocket subprotocol.  The CBOR document has the same
+    shape as the JSON one, except that transactions, metadata and ledger
+    headers are carried as byte strings holding their canonical serialization
+    instead of being expanded field by field.
+*/
+enum class WireFormat
+{
+    json,
+    cbor
+};
+
+/** The media type of CBOR requests and responses. */
+extern char const* const cborMediaType;
+
+/** The WebSocket subprotocol that selects CBOR. */
+extern char const* const cborSubprotocol;
+
+/** Return the format named by an HTTP Accept or Content-Type header. */
+WireFormat formatFromMediaType (std::string const& mediaType);
+
+/** Decode a request in the given format.
+    @return false if it is malformed or is not an object.
+*/
+bool parseRequest (
+    std::string const& request, WireFormat, Json::Value& jvRequest);
+
+/** Ask for binary output unless the request says otherwise.
+
+    In CBOR this lets tx, account_tx and ledger skip rendering each
+    transaction and its metadata as JSON.
+*/
+void preferBinary (Json::Value& params);
+
+/** Write a response in the given format.
+
+    In CBOR, the hex blobs that binary requests produce (tx, tx_blob, meta
+    and ledger_data) are sent as byte strings.
+*/
+void outputResponse (Json::Value const&, WireFormat, Json::Output const&);
+
+/** Return a response in the given format. */
+std::string encodeResponse (Json::Value const&, WireFormat);
+
+} // RPC
+} // truechain
+
+#endif
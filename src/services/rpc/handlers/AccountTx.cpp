@@ -18,6 +18,8 @@
 //==============================================================================
 
 #include <BeastConfig.h>
+#include <services/rpc/handlers/AccountTx.h>
+#include <services/rpc/handlers/Handlers.h>
 #include <services/server/Role.h>
 #include <protocol/STAccount.h>
 #include <transaction/tx/Transaction.h>
@@ -117,173 +119,149 @@ namespace truechain {
         tx->getSTransaction()->setFieldArray(sfOperations, newOperations);        
     }
 
-    // {
-    //   account: account,
-    //   ledger_index_min: ledger_index  // optional, defaults to earliest
-    //   ledger_index_max: ledger_index, // optional, defaults to latest
-    //   binary: boolean,                // optional, defaults to false
-    //   forward: boolean,               // optional, defaults to false
-    //   limit: integer,                 // optional
-    //   marker: opaque                  // optional, resume previous query
-    // }
-    Json::Value doAccountTx(RPC::Context& context)
+namespace RPC {
+
+AccountTxHandler::AccountTxHandler (Context& context) : context_ (context)
+{
+}
+
+bool AccountTxHandler::isValidated (std::uint32_t ledgerIndex) const
+{
+    return validated_ &&
+        validatedMin_ <= ledgerIndex &&
+        validatedMax_ >= ledgerIndex;
+}
+
+Status AccountTxHandler::check ()
+{
+    auto& params = context_.params;
+
+    // Temporary switching code until the old account_tx is removed
+    if (params.isMember(jss::offset) ||
+        params.isMember(jss::count) ||
+        params.isMember(jss::descending) ||
+        params.isMember(jss::ledger_max) ||
+        params.isMember(jss::ledger_min))
     {
-        auto& params = context.params;
-
-        SkywellAddress   raAccount;
-        int limit = params.isMember(jss::limit) ?
-            params[jss::limit].asUInt() : -1;
-        bool bBinary = params.isMember(jss::binary) && params[jss::binary].asBool();
-        bool bForward = params.isMember(jss::forward) && params[jss::forward].asBool();
-        std::uint32_t   uLedgerMin;
-        std::uint32_t   uLedgerMax;
-        std::uint32_t   uValidatedMin;
-        std::uint32_t   uValidatedMax;
-        bool bValidated = context.netOps.getValidatedRange(
-            uValidatedMin, uValidatedMax);
-
-        if (!bValidated)
-        {
-            // Don't have a validated ledger range.
-            return rpcError(rpcLGR_IDXS_INVALID);
-        }
+        result_ = doAccountTxOld (context_);
+        old_ = true;
+        return Status::OK;
+    }
 
-        if (!params.isMember(jss::account))
-            return rpcError(rpcINVALID_PARAMS);
+    limit_ = params.isMember(jss::limit) ?
+        params[jss::limit].asUInt() : -1;
+    binary_ = params.isMember(jss::binary) && params[jss::binary].asBool();
+    bool bForward = params.isMember(jss::forward) && params[jss::forward].asBool();
 
-        if (!raAccount.setAccountID(params[jss::account].asString()))
-            return rpcError(rpcACT_MALFORMED);
+    validated_ = context_.netOps.getValidatedRange(
+        validatedMin_, validatedMax_);
 
-        context.loadType = Resource::feeMediumBurdenRPC;
+    if (!validated_)
+    {
+        // Don't have a validated ledger range.
+        return rpcLGR_IDXS_INVALID;
+    }
 
-        if (params.isMember(jss::ledger_index_min) ||
-            params.isMember(jss::ledger_index_max))
-        {
-            std::int64_t iLedgerMin = params.isMember(jss::ledger_index_min)
-                ? params[jss::ledger_index_min].asInt() : -1;
-            std::int64_t iLedgerMax = params.isMember(jss::ledger_index_max)
-                ? params[jss::ledger_index_max].asInt() : -1;
-
-            uLedgerMin = iLedgerMin == -1 ? uValidatedMin :
-                ((iLedgerMin >= uValidatedMin) ? iLedgerMin : uValidatedMin);
-            uLedgerMax = iLedgerMax == -1 ? uValidatedMax :
-                ((iLedgerMax <= uValidatedMax) ? iLedgerMax : uValidatedMax);
-
-            if (uLedgerMax < uLedgerMin)
-                return rpcError(rpcLGR_IDXS_INVALID);
-        }
-        else
-        {
-            Ledger::pointer l;
-            Json::Value ret = RPC::lookupLedger(params, l, context.netOps);
+    if (!params.isMember(jss::account))
+        return rpcINVALID_PARAMS;
 
-            if (!l)
-                return ret;
+    if (!account_.setAccountID(params[jss::account].asString()))
+        return rpcACT_MALFORMED;
 
-            uLedgerMin = uLedgerMax = l->getLedgerSeq();
-        }
+    context_.loadType = Resource::feeMediumBurdenRPC;
 
-        Json::Value resumeToken;
+    if (params.isMember(jss::ledger_index_min) ||
+        params.isMember(jss::ledger_index_max))
+    {
+        std::int64_t iLedgerMin = params.isMember(jss::ledger_index_min)
+            ? params[jss::ledger_index_min].asInt() : -1;
+        std::int64_t iLedgerMax = params.isMember(jss::ledger_index_max)
+            ? params[jss::ledger_index_max].asInt() : -1;
+
+        ledgerMin_ = iLedgerMin == -1 ? validatedMin_ :
+            ((iLedgerMin >= validatedMin_) ? iLedgerMin : validatedMin_);
+        ledgerMax_ = iLedgerMax == -1 ? validatedMax_ :
+            ((iLedgerMax <= validatedMax_) ? iLedgerMax : validatedMax_);
+
+        if (ledgerMax_ < ledgerMin_)
+            return rpcLGR_IDXS_INVALID;
+    }
+    else
+    {
+        Ledger::pointer l;
+        Json::Value ret;
+
+        if (auto s = RPC::lookupLedger(params, l, context_.netOps, ret))
+            return s;
 
-        if (params.isMember(jss::marker))
-            resumeToken = params[jss::marker];
+        ledgerMin_ = ledgerMax_ = l->getLedgerSeq();
+    }
+
+    if (params.isMember(jss::marker))
+        resumeToken_ = params[jss::marker];
 
 #ifndef BEAST_DEBUG
 
-        try
-        {
+    try
+    {
 #endif
-            Json::Value ret(Json::objectValue);
-
-            ret[jss::account] = raAccount.humanAccountID();
-            Json::Value& jvTxns = (ret[jss::transactions] = Json::arrayValue);
+        if (binary_)
+        {
+            binaryTxns_ = context_.netOps.getTxsAccountB(
+                account_, ledgerMin_, ledgerMax_, bForward, resumeToken_,
+                limit_, context_.role == Role::ADMIN);
+        }
+        else
+        {
+            txns_ = context_.netOps.getTxsAccount(
+                account_, ledgerMin_, ledgerMax_, bForward, resumeToken_,
+                limit_, context_.role == Role::ADMIN);
 
-            if (bBinary)
+            Ledger::pointer lpLedger = context_.netOps.getCurrentLedger();
+            if (lpLedger)
             {
-                auto txns = context.netOps.getTxsAccountB(
-                    raAccount, uLedgerMin, uLedgerMax, bForward, resumeToken, limit,
-                    context.role == Role::ADMIN);
-
-                for (auto& it : txns)
-                {
-                    Json::Value& jvObj = jvTxns.append(Json::objectValue);
-
-                    jvObj[jss::tx_blob] = std::get<0>(it);
-                    jvObj[jss::meta] = std::get<1>(it);
-
-                    std::uint32_t uLedgerIndex = std::get<2>(it);
-
-                    jvObj[jss::ledger_index] = uLedgerIndex;
-                    jvObj[jss::validated] = bValidated &&
-                        uValidatedMin <= uLedgerIndex &&
-                        uValidatedMax >= uLedgerIndex;
-                }
+                feeAccount_ = lpLedger->getFeeAccountID();
+                haveFeeAccount_ = true;
             }
-            else
-            {
-                //		uLedgerMin = 120;
-                auto txns = context.netOps.getTxsAccount(
-                    raAccount, uLedgerMin, uLedgerMax, bForward, resumeToken, limit,
-                    context.role == Role::ADMIN);
-
-                Ledger::pointer lpLedger = context.netOps.getCurrentLedger();
-                if (!lpLedger)
-                    return ret;
-
-                bool isFeeAccount = false;
-                Account const& feeAccount = lpLedger->getFeeAccountID();
-                if (feeAccount == raAccount.getAccountID())
-                    isFeeAccount = true;
-
-                for (auto& it : txns)
-                {
-                    Json::Value& jvObj = jvTxns.append(Json::objectValue);
-
-                    if (it.first)
-                    {
-                        if (!isFeeAccount
-                            && it.first->getSTransaction()->getOperationAccount() != raAccount
-                            && it.first->getTransactionType() == ttOPERATION)
-                        {
-                            if (it.second)
-                                split(it.first, it.second, raAccount, feeAccount);
-                        }
-                        jvObj[jss::tx] = it.first->getJson(1);
-                    }
-
-                    if (it.second)
-                    {
-                        auto meta = it.second->getJson(1);
-                        // addPaymentDeliveredAmount(meta, context, it.first, it.second);
-                        jvObj[jss::meta] = meta;
+        }
+#ifndef BEAST_DEBUG
+    }
+    catch (...)
+    {
+        return rpcINTERNAL;
+    }
 
-                        std::uint32_t uLedgerIndex = it.second->getLgrSeq();
+#endif
 
-                        jvObj[jss::validated] = bValidated &&
-                            uValidatedMin <= uLedgerIndex &&
-                            uValidatedMax >= uLedgerIndex;
-                    }
-                }
-            }
-           
+    return Status::OK;
+}
 
-            //Add information about the original query
-            ret[jss::ledger_index_min] = uLedgerMin;
-            ret[jss::ledger_index_max] = uLedgerMax;
-            if (params.isMember(jss::limit))
-                ret[jss::limit] = limit;
-            if (!resumeToken.isNull())
-                ret[jss::marker] = resumeToken;
+Json::Value AccountTxHandler::getJson (NetworkOPs::AccountTx& it) const
+{
+    Json::Value jvObj (Json::objectValue);
 
-            return ret;
-#ifndef BEAST_DEBUG
-        }
-        catch (...)
+    if (it.first)
+    {
+        if (feeAccount_ != account_.getAccountID()
+            && it.first->getSTransaction()->getOperationAccount() != account_
+            && it.first->getTransactionType() == ttOPERATION)
         {
-            return rpcError(rpcINTERNAL);
+            if (it.second)
+                split(it.first, it.second, account_, feeAccount_);
         }
+        jvObj[jss::tx] = it.first->getJson(1);
+    }
 
-#endif
+    if (it.second)
+    {
+        auto meta = it.second->getJson(1);
+        // addPaymentDeliveredAmount(meta, context, it.first, it.second);
+        jvObj[jss::meta] = meta;
+        jvObj[jss::validated] = isValidated (it.second->getLgrSeq());
     }
 
+    return jvObj;
+}
+
+} // RPC
 } // truechain
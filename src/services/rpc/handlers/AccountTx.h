@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_RPC_HANDLERS_ACCOUNTTX_H_INCLUDED
+#define SKYWELL_RPC_HANDLERS_ACCOUNTTX_H_INCLUDED
+
+#include <common/json/Object.h>
+#include <common/misc/NetworkOPs.h>
+#include <protocol/JsonFields.h>
+#include <services/server/Role.h>
+#include <services/rpc/Context.h>
+#include <services/rpc/impl/Handler.h>
+
+namespace truechain {
+namespace RPC {
+
+// {
+//   account: account,
+//   ledger_index_min: ledger_index  // optional, defaults to earliest
+//   ledger_index_max: ledger_index, // optional, defaults to latest
+//   binary: boolean,                // optional, defaults to false
+//   forward: boolean,               // optional, defaults to false
+//   limit: integer,                 // optional
+//   marker: opaque                  // optional, resume previous query
+// }
+//
+// Requests with the parameters of the old account_tx are passed to
+// doAccountTxOld.
+
+class AccountTxHandler {
+public:
+    explicit AccountTxHandler (Context&);
+
+    Status check ();
+
+    template <class Object>
+    void writeResult (Object&);
+
+    static const char* const name()
+    {
+        return "account_tx";
+    }
+
+    static Role role()
+    {
+        return Role::USER;
+    }
+
+    static Condition condition()
+    {
+        return NO_CONDITION;
+    }
+
+private:
+    bool isValidated (std::uint32_t ledgerIndex) const;
+
+    // The JSON for one transaction of txns_
+    Json::Value getJson (NetworkOPs::AccountTx& tx) const;
+
+    Context& context_;
+    Json::Value result_;
+    bool old_ = false;
+
+    SkywellAddress account_;
+    Account feeAccount_;
+    bool haveFeeAccount_ = false;
+    int limit_ = -1;
+    bool binary_ = false;
+
+    bool validated_ = false;
+    std::uint32_t validatedMin_ = 0;
+    std::uint32_t validatedMax_ = 0;
+    std::uint32_t ledgerMin_ = 0;
+    std::uint32_t ledgerMax_ = 0;
+
+    Json::Value resumeToken_;
+    NetworkOPs::AccountTxs txns_;
+    NetworkOPs::MetaTxsList binaryTxns_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation.
+
+template <class Object>
+void AccountTxHandler::writeResult (Object& value)
+{
+    if (old_)
+    {
+        Json::copyFrom (value, result_);
+        return;
+    }
+
+    value[jss::account] = account_.humanAccountID();
+
+    {
+        // Each transaction is written out as soon as it is converted
+        auto&& txns = Json::setArray (value, jss::transactions);
+
+        if (binary_)
+        {
+            for (auto const& it : binaryTxns_)
+            {
+                auto&& obj = Json::appendObject (txns);
+                std::uint32_t uLedgerIndex = std::get<2>(it);
+
+                obj[jss::tx_blob] = std::get<0>(it);
+                obj[jss::meta] = std::get<1>(it);
+                obj[jss::ledger_index] = uLedgerIndex;
+                obj[jss::validated] = isValidated (uLedgerIndex);
+            }
+        }
+        else if (haveFeeAccount_)
+        {
+            for (auto& it : txns_)
+                txns.append (getJson (it));
+        }
+        else
+        {
+            // No current ledger: return no transactions and nothing else
+            return;
+        }
+    }
+
+    //Add information about the original query
+    value[jss::ledger_index_min] = ledgerMin_;
+    value[jss::ledger_index_max] = ledgerMax_;
+    if (context_.params.isMember(jss::limit))
+        value[jss::limit] = limit_;
+    if (!resumeToken_.isNull())
+        value[jss::marker] = resumeToken_;
+}
+
+} // RPC
+} // truechain
+
+#endif
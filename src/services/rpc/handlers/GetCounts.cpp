@@ -25,6 +25,7 @@
 #include <ledger/LedgerMaster.h>
 #include <common/base/UptimeTimer.h>
 #include <common/json/json_value.h>
+#include <common/misc/IHashRouter.h>
 #include <common/misc/NetworkOPs.h>
 #include <common/misc/AmendmentTable.h>
 #include <services/rpc/Context.h>
@@ -129,6 +130,14 @@ Json::Value doGetCounts (RPC::Context& context)
             ret[jss::local_txs] = static_cast<Json::UInt> (c);
     }
 
+    {
+        auto const stats = app.getOPs ().getProposedPublishStats ();
+        ret[jss::proposed_pub_queue] = static_cast<Json::UInt> (stats.queued);
+        ret[jss::proposed_pub_published] =
+            static_cast<Json::UInt> (stats.published);
+        ret[jss::proposed_pub_dropped] = static_cast<Json::UInt> (stats.dropped);
+    }
+
     ret[jss::write_load] = app.getNodeStore ().getWriteLoad ();
 
     ret[jss::historical_perminute] = static_cast<int>(
@@ -138,6 +147,13 @@ Json::Value doGetCounts (RPC::Context& context)
     ret[jss::ledger_hit_rate] = app.getLedgerMaster ().getCacheHitRate ();
     ret[jss::AL_hit_rate] = AcceptedLedger::getCacheHitRate ();
 
+    {
+        auto const stats = app.getHashRouter ().getStats ();
+        ret[jss::suppression_size] = static_cast<Json::UInt> (stats.size);
+        ret[jss::suppression_lookups] = stats.lookupsPerSecond;
+        ret[jss::suppression_hits] = stats.hitsPerSecond;
+    }
+
     ret[jss::fullbelow_size] = static_cast<int>(app.family().fullbelow().size());
     ret[jss::treenode_cache_size] = app.family().treecache().getCacheSize();
     ret[jss::treenode_track_size] = app.family().treecache().getTrackSize();
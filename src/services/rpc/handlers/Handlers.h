@@ -27,10 +27,8 @@ Json::Value doAccountInfo           (RPC::Context&);
 Json::Value doAccountLines          (RPC::Context&);
 Json::Value doAccountObjects        (RPC::Context&);
 Json::Value doAccountOffers         (RPC::Context&);
-Json::Value doAccountTx             (RPC::Context&);
 Json::Value doAccountTrust          (RPC::Context&);
 Json::Value doAccountTrustcp          (RPC::Context&);
-Json::Value doAccountTxSwitch       (RPC::Context&);
 Json::Value doAccountTxOld          (RPC::Context&);
 Json::Value doBookOffers            (RPC::Context&);
 Json::Value doBlackList             (RPC::Context&);
@@ -45,7 +43,6 @@ Json::Value doLedgerAccept          (RPC::Context&);
 Json::Value doLedgerCleaner         (RPC::Context&);
 Json::Value doLedgerClosed          (RPC::Context&);
 Json::Value doLedgerCurrent         (RPC::Context&);
-Json::Value doLedgerData            (RPC::Context&);
 Json::Value doLedgerEntry           (RPC::Context&);
 Json::Value doLedgerHeader          (RPC::Context&);
 Json::Value doLedgerRequest         (RPC::Context&);
@@ -1,7 +1,7 @@
 //------------------------------------------------------------------------------
 /*
-    This file is part of skywelld: https://github.com/skywell/skywelld
-    Copyright (c) 2012-2014 Skywell Labs Inc.
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
 
     Permission to use, copy, modify, and/or distribute this software for any
     purpose  with  or without fee is hereby granted, provided that the above
@@ -18,100 +18,62 @@
 //==============================================================================
 
 #include <BeastConfig.h>
-#include <services/server/Role.h>
-#include <services/rpc/Context.h>
-#include <protocol/JsonFields.h>
+#include <services/rpc/handlers/LedgerData.h>
+#include <protocol/ErrorCodes.h>
 #include <services/rpc/impl/LookupLedger.h>
-#include <common/shamap/SHAMap.h>
-#include <protocol/STLedgerEntry.h>
 
 namespace truechain {
+namespace RPC {
 
-// Get state nodes from a ledger
-//   Inputs:
-//     limit:        integer, maximum number of entries
-//     marker:       opaque, resume point
-//     binary:       boolean, format
-//   Outputs:
-//     ledger_hash:  chosen ledger's hash
-//     ledger_index: chosen ledger's index
-//     state:        array of state nodes
-//     marker:       resume point, if any
-Json::Value doLedgerData (RPC::Context& context)
+LedgerDataHandler::LedgerDataHandler (Context& context) : context_ (context)
+{
+}
+
+Status LedgerDataHandler::check ()
 {
     int const BINARY_PAGE_LENGTH = 2048;
     int const JSON_PAGE_LENGTH = 256;
 
-    Ledger::pointer lpLedger;
-    auto const& params = context.params;
+    auto const& params = context_.params;
 
-    Json::Value jvResult = RPC::lookupLedger (params, lpLedger, context.netOps);
-    if (!lpLedger)
-        return jvResult;
+    if (auto s = RPC::lookupLedger (params, ledger_, context_.netOps, result_))
+        return s;
+
+    // Written by writeResult, as strings
+    result_.removeMember (jss::ledger_hash);
+    result_.removeMember (jss::ledger_index);
 
-    uint256 resumePoint;
     if (params.isMember (jss::marker))
     {
         Json::Value const& jMarker = params[jss::marker];
-        if (!jMarker.isString ())
-            return RPC::expected_field_error (jss::marker, "valid");
-        if (!resumePoint.SetHex (jMarker.asString ()))
-            return RPC::expected_field_error (jss::marker, "valid");
+        if (!jMarker.isString () || !resumePoint_.SetHex (jMarker.asString ()))
+        {
+            return {rpcINVALID_PARAMS,
+                expected_field_message (jss::marker, "valid")};
+        }
     }
 
-    bool isBinary = params[jss::binary].asBool();
+    binary_ = params[jss::binary].asBool();
 
-    int limit = -1;
-    int maxLimit = isBinary ? BINARY_PAGE_LENGTH : JSON_PAGE_LENGTH;
+    int maxLimit = binary_ ? BINARY_PAGE_LENGTH : JSON_PAGE_LENGTH;
 
     if (params.isMember (jss::limit))
     {
         Json::Value const& jLimit = params[jss::limit];
         if (!jLimit.isIntegral ())
-            return RPC::expected_field_error (jss::limit, "integer");
+        {
+            return {rpcINVALID_PARAMS,
+                expected_field_message (jss::limit, "integer")};
+        }
 
-        limit = jLimit.asInt ();
+        limit_ = jLimit.asInt ();
     }
 
-    if ((limit < 0) || ((limit > maxLimit) && (context.role != Role::ADMIN)))
-        limit = maxLimit;
-
-    jvResult[jss::ledger_hash] = to_string (lpLedger->getHash());
-    jvResult[jss::ledger_index] = std::to_string( lpLedger->getLedgerSeq ());
-
-    Json::Value& nodes = (jvResult[jss::state] = Json::arrayValue);
-    SHAMap& map = *(lpLedger->peekAccountStateMap ());
-
-    for (;;)
-    {
-       std::shared_ptr<SHAMapItem> item = map.peekNextItem (resumePoint);
-       if (!item)
-           break;
-       resumePoint = item->getTag();
-
-       if (limit-- <= 0)
-       {
-           --resumePoint;
-           jvResult[jss::marker] = to_string (resumePoint);
-           break;
-       }
-
-       if (isBinary)
-       {
-           Json::Value& entry = nodes.append (Json::objectValue);
-           entry[jss::data] = strHex (
-               item->peekData().begin(), item->peekData().size());
-           entry[jss::index] = to_string (item->getTag ());
-       }
-       else
-       {
-           SLE sle (item->peekSerializer(), item->getTag ());
-           Json::Value& entry = nodes.append (sle.getJson (0));
-           entry[jss::index] = to_string (item->getTag ());
-       }
-    }
+    if ((limit_ < 0) || ((limit_ > maxLimit) && (context_.role != Role::ADMIN)))
+        limit_ = maxLimit;
 
-    return jvResult;
+    return Status::OK;
 }
 
+} // RPC
 } // truechain
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_RPC_HANDLERS_LEDGERDATA_H_INCLUDED
+#define SKYWELL_RPC_HANDLERS_LEDGERDATA_H_INCLUDED
+
+#include <ledger/Ledger.h>
+#include <common/json/Object.h>
+#include <common/shamap/SHAMap.h>
+#include <protocol/JsonFields.h>
+#include <protocol/STLedgerEntry.h>
+#include <services/server/Role.h>
+#include <services/rpc/Context.h>
+#include <services/rpc/impl/Handler.h>
+
+namespace truechain {
+namespace RPC {
+
+// Get state nodes from a ledger
+//   Inputs:
+//     limit:        integer, maximum number of entries
+//     marker:       opaque, resume point
+//     binary:       boolean, format
+//   Outputs:
+//     ledger_hash:  chosen ledger's hash
+//     ledger_index: chosen ledger's index
+//     state:        array of state nodes
+//     marker:       resume point, if any
+//
+// The state nodes are written out one at a time as they are read from the
+// map, so a page is never held in memory as a whole.
+
+class LedgerDataHandler {
+public:
+    explicit LedgerDataHandler (Context&);
+
+    Status check ();
+
+    template <class Object>
+    void writeResult (Object&);
+
+    static const char* const name()
+    {
+        return "ledger_data";
+    }
+
+    static Role role()
+    {
+        return Role::USER;
+    }
+
+    static Condition condition()
+    {
+        return NO_CONDITION;
+    }
+
+private:
+    Context& context_;
+    Ledger::pointer ledger_;
+    Json::Value result_;
+    uint256 resumePoint_;
+    int limit_ = -1;
+    bool binary_ = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation.
+
+template <class Object>
+void LedgerDataHandler::writeResult (Object& value)
+{
+    Json::copyFrom (value, result_);
+    value[jss::ledger_hash] = to_string (ledger_->getHash());
+    value[jss::ledger_index] = std::to_string (ledger_->getLedgerSeq ());
+
+    uint256 resumePoint = resumePoint_;
+    bool more = false;
+
+    {
+        auto&& nodes = Json::setArray (value, jss::state);
+        SHAMap& map = *(ledger_->peekAccountStateMap ());
+
+        for (int limit = limit_;;)
+        {
+            std::shared_ptr<SHAMapItem> item = map.peekNextItem (resumePoint);
+            if (!item)
+                break;
+            resumePoint = item->getTag();
+
+            if (limit-- <= 0)
+            {
+                --resumePoint;
+                more = true;
+                break;
+            }
+
+            if (binary_)
+            {
+                auto&& entry = Json::appendObject (nodes);
+                entry[jss::data] = strHex (
+                    item->peekData().begin(), item->peekData().size());
+                entry[jss::index] = to_string (item->getTag ());
+            }
+            else
+            {
+                SLE sle (item->peekSerializer(), item->getTag ());
+                Json::Value json = sle.getJson (0);
+                json[jss::index] = to_string (item->getTag ());
+                nodes.append (json);
+            }
+        }
+    }
+
+    if (more)
+        value[jss::marker] = to_string (resumePoint);
+}
+
+} // RPC
+} // truechain
+
+#endif
@@ -33,6 +33,7 @@
 #include <services/net/RPCErr.h>
 #include <network/resource/Fees.h>
 #include <transaction/paths/PathRequests.h>
+#include <transaction/paths/PathQuoteCache.h>
 
 #include <boost/format.hpp>
 #include <common/json/to_string.h>
@@ -253,113 +254,167 @@ truechainPathFind(SkywellLineCache::pointer const& cache,
             return std::make_pair(false, rpcError(rpcSRC_ISR_MALFORMED));
         }
 
-        STPathSet spsComputed;
-        if (contextPaths)
-        {
-            Json::Value pathSet = Json::objectValue;
-            pathSet[jss::Paths] = contextPaths.get();
-            STParsedJSONObject paths("pathSet", pathSet);
-            if (! paths.object)
-                return std::make_pair(false, paths.error);
-            else
-            {
-                spsComputed = paths.object->getFieldPathSet(sfPaths);
-                WriteLog(lsTRACE, RPCHandler) << "truechain_path_find: Paths: " << to_string(spsComputed.getJson(0));
-            }
-        }
+        // Quotes along caller supplied paths are not kept
+        auto const quotes = contextPaths ? nullptr :
+            &getApp().getPathRequests().getQuoteCache();
 
-        STPath fullLiquidityPath;
-        auto valid = fp.findPathsForIssue(
+        PathQuoteCache::Request const request {
+            raSrc.getAccountID(),
+            raDst.getAccountID(),
+            saDstAmount,
             { uSrcCurrencyID, uSrcIssuerID },
-            spsComputed,
-            fullLiquidityPath);
-        if (!valid)
+            level };
+
+        Json::Value jvQuote;
+        if (quotes && quotes->getQuote(lpLedger, request, jvQuote))
         {
-            WriteLog(lsWARNING, RPCHandler)
-                << "truechain_path_find: No paths found.";
+            if (!jvQuote.isNull())
+                jvArray.append(jvQuote);
+            continue;
         }
-        else
+
+        // Returns the alternative for these paths, or null if there is none
+        auto calculate = [&](bool valid, STPathSet& spsComputed,
+            STPath const& fullLiquidityPath) -> Json::Value
         {
-            auto& issuer =
-                isSWT(uSrcIssuerID) ?
-                isSWT(uSrcCurrencyID) ? // Default to source account.
-                xrpAccount() :
-                Account(raSrc.getAccountID())
-                : uSrcIssuerID;            // Use specifed issuer.
-
-            STAmount saMaxAmount({ uSrcCurrencyID, issuer }, 1);
-            saMaxAmount.negate();
-
-            LedgerEntrySet lesSandbox(lpLedger, tapNONE);
-
-            auto rc = path::SkywellCalc::truechainCalculate(
-                lesSandbox,
-                saMaxAmount,            // --> Amount to send is unlimited
-                //     to get an estimate.
-                saDstAmount,            // --> Amount to deliver.
-                raDst.getAccountID(),  // --> Account to deliver to.
-                raSrc.getAccountID(),  // --> Account sending from.
-                spsComputed);           // --> Path set.
-
-            WriteLog(lsWARNING, RPCHandler)
-                << "truechain_path_find:"
-                << " saMaxAmount=" << saMaxAmount
-                << " saDstAmount=" << saDstAmount
-                << " saMaxAmountAct=" << rc.actualAmountIn
-                << " saDstAmountAct=" << rc.actualAmountOut;
-
-            if (fullLiquidityPath.size() > 0 &&
-                (rc.result() == terNO_LINE || rc.result() == tecPATH_PARTIAL))
+            if (!valid)
+            {
+                WriteLog(lsWARNING, RPCHandler)
+                    << "truechain_path_find: No paths found.";
+            }
+            else
             {
-                WriteLog(lsDEBUG, PathRequest)
-                    << "Trying with an extra path element";
+                auto& issuer =
+                    isSWT(uSrcIssuerID) ?
+                    isSWT(uSrcCurrencyID) ? // Default to source account.
+                    xrpAccount() :
+                    Account(raSrc.getAccountID())
+                    : uSrcIssuerID;            // Use specifed issuer.
+
+                STAmount saMaxAmount({ uSrcCurrencyID, issuer }, 1);
+                saMaxAmount.negate();
+
+                LedgerEntrySet lesSandbox(lpLedger, tapNONE);
 
-                spsComputed.push_back(fullLiquidityPath);
-                lesSandbox.clear();
-                rc = path::SkywellCalc::truechainCalculate(
+                auto rc = path::SkywellCalc::truechainCalculate(
                     lesSandbox,
                     saMaxAmount,            // --> Amount to send is unlimited
                     //     to get an estimate.
                     saDstAmount,            // --> Amount to deliver.
                     raDst.getAccountID(),  // --> Account to deliver to.
                     raSrc.getAccountID(),  // --> Account sending from.
-                    spsComputed);         // --> Path set.
-                WriteLog(lsDEBUG, PathRequest)
-                    << "Extra path element gives "
-                    << transHuman(rc.result());
+                    spsComputed);           // --> Path set.
+
+                WriteLog(lsWARNING, RPCHandler)
+                    << "truechain_path_find:"
+                    << " saMaxAmount=" << saMaxAmount
+                    << " saDstAmount=" << saDstAmount
+                    << " saMaxAmountAct=" << rc.actualAmountIn
+                    << " saDstAmountAct=" << rc.actualAmountOut;
+
+                if (fullLiquidityPath.size() > 0 &&
+                    (rc.result() == terNO_LINE || rc.result() == tecPATH_PARTIAL))
+                {
+                    WriteLog(lsDEBUG, PathRequest)
+                        << "Trying with an extra path element";
+
+                    spsComputed.push_back(fullLiquidityPath);
+                    lesSandbox.clear();
+                    rc = path::SkywellCalc::truechainCalculate(
+                        lesSandbox,
+                        saMaxAmount,            // --> Amount to send is unlimited
+                        //     to get an estimate.
+                        saDstAmount,            // --> Amount to deliver.
+                        raDst.getAccountID(),  // --> Account to deliver to.
+                        raSrc.getAccountID(),  // --> Account sending from.
+                        spsComputed);         // --> Path set.
+                    WriteLog(lsDEBUG, PathRequest)
+                        << "Extra path element gives "
+                        << transHuman(rc.result());
+                }
+
+                if (rc.result() == tesSUCCESS)
+                {
+                    Json::Value jvEntry(Json::objectValue);
+
+                    STPathSet   spsCanonical;
+
+                    // Reuse the expanded as it would need to be calcuated
+                    // anyway to produce the canonical.  (At least unless we
+                    // make a direct canonical.)
+
+                    jvEntry[jss::source_amount] = rc.actualAmountIn.getJson(0);
+                    jvEntry[jss::paths_canonical] = Json::arrayValue;
+                    jvEntry[jss::paths_computed] = spsComputed.getJson(0);
+
+                    return jvEntry;
+                }
+                else
+                {
+                    std::string strToken;
+                    std::string strHuman;
+
+                    transResultInfo(rc.result(), strToken, strHuman);
+/*
+                    WriteLog(lsDEBUG, RPCHandler)
+                        << "truechain_path_find: "
+                        << strToken << " "
+                        << strHuman << " "
+                        << spsComputed.getJson(0);
+*/
+                }
             }
+            return Json::Value();
+        };
 
-            if (rc.result() == tesSUCCESS)
+        STPathSet spsComputed;
+        if (contextPaths)
+        {
+            Json::Value pathSet = Json::objectValue;
+            pathSet[jss::Paths] = contextPaths.get();
+            STParsedJSONObject paths("pathSet", pathSet);
+            if (! paths.object)
+                return std::make_pair(false, paths.error);
+            else
             {
-                Json::Value jvEntry(Json::objectValue);
-
-                STPathSet   spsCanonical;
+                spsComputed = paths.object->getFieldPathSet(sfPaths);
+                WriteLog(lsTRACE, RPCHandler) << "truechain_path_find: Paths: " << to_string(spsComputed.getJson(0));
+            }
+        }
 
-                // Reuse the expanded as it would need to be calcuated
-                // anyway to produce the canonical.  (At least unless we
-                // make a direct canonical.)
+        PathQuoteCache::Paths found;
+        bool const reused = quotes && quotes->getPaths(lpLedger, request, found);
 
-                jvEntry[jss::source_amount] = rc.actualAmountIn.getJson(0);
-                jvEntry[jss::paths_canonical] = Json::arrayValue;
-                jvEntry[jss::paths_computed] = spsComputed.getJson(0);
+        if (!reused)
+        {
+            found.valid = fp.findPathsForIssue(
+                { uSrcCurrencyID, uSrcIssuerID },
+                spsComputed,
+                found.fullLiquidityPath);
+            found.paths = spsComputed;
+
+            if (quotes)
+                quotes->putPaths(lpLedger, request, found);
+        }
 
-                jvArray.append(jvEntry);
-            }
-            else
-            {
-                std::string strToken;
-                std::string strHuman;
+        jvQuote = calculate(found.valid, found.paths, found.fullLiquidityPath);
 
-                transResultInfo(rc.result(), strToken, strHuman);
-/*
-                WriteLog(lsDEBUG, RPCHandler)
-                    << "truechain_path_find: "
-                    << strToken << " "
-                    << strHuman << " "
-                    << spsComputed.getJson(0);
-*/
-            }
+        if (jvQuote.isNull() && reused)
+        {
+            // The paths found for a nearby amount don't work for this one
+            STPath fullLiquidityPath;
+            bool const valid = fp.findPathsForIssue(
+                { uSrcCurrencyID, uSrcIssuerID },
+                spsComputed,
+                fullLiquidityPath);
+            jvQuote = calculate(valid, spsComputed, fullLiquidityPath);
         }
+
+        if (quotes)
+            quotes->putQuote(lpLedger, request, jvQuote);
+
+        if (!jvQuote.isNull())
+            jvArray.append(jvQuote);
     }
 
     return std::make_pair(true, jvArray);
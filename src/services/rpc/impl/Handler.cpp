@@ -20,7 +20,9 @@
 #include <BeastConfig.h>
 #include <services/rpc/impl/Handler.h>
 #include <services/rpc/handlers/Handlers.h>
+#include <services/rpc/handlers/AccountTx.h>
 #include <services/rpc/handlers/Ledger.h>
+#include <services/rpc/handlers/LedgerData.h>
 #include <services/rpc/handlers/Version.h>
 
 namespace truechain {
@@ -67,7 +69,9 @@ class HandlerTable {
         }
 
         // This is where the new-style handlers are added.
+        addHandler<AccountTxHandler>();
         addHandler<LedgerHandler>();
+        addHandler<LedgerDataHandler>();
         addHandler<VersionHandler>();
     }
 
@@ -103,7 +107,6 @@ HandlerTable HANDLERS({
     {   "account_lines",        byRef (&doAccountLines),        Role::USER,  NO_CONDITION  },
     {   "account_objects",      byRef (&doAccountObjects),      Role::USER,  NO_CONDITION  },
   
-    {   "account_tx",           byRef (&doAccountTxSwitch),     Role::USER,  NO_CONDITION  },
     {   "account_relation",        byRef (&doAccountTrust),        Role::USER,  NO_CONDITION  },
     {   "account_relcp",        byRef (&doAccountTrustcp),        Role::USER,  NO_CONDITION  },
    
@@ -118,7 +121,6 @@ HandlerTable HANDLERS({
     {   "ledger_cleaner",       byRef (&doLedgerCleaner),       Role::ADMIN,   NEEDS_NETWORK_CONNECTION  },
     {   "ledger_closed",        byRef (&doLedgerClosed),        Role::USER,  NO_CONDITION   },
     {   "ledger_current",       byRef (&doLedgerCurrent),       Role::USER,  NEEDS_CURRENT_LEDGER  },
-    {   "ledger_data",          byRef (&doLedgerData),          Role::USER,  NO_CONDITION  },
     {   "ledger_entry",         byRef (&doLedgerEntry),         Role::USER,  NO_CONDITION  },
     {   "ledger_header",        byRef (&doLedgerHeader),        Role::USER,  NO_CONDITION  },
     {   "ledger_request",       byRef (&doLedgerRequest),       Role::ADMIN,   NO_CONDITION     },
@@ -238,17 +238,24 @@ Status doCommand (
 /** Execute an RPC command and store the results in a string. */
 void executeRPC (
     RPC::Context& context, std::string& output, YieldStrategy const& strategy)
+{
+    executeRPC (context, Json::stringOutput (output), strategy);
+}
+
+void executeRPC (
+    RPC::Context& context, Json::Output const& output,
+    YieldStrategy const& strategy)
 {
     boost::optional <Handler const&> handler;
     if (auto error = fillHandler (context, handler))
     {
-        auto wo = Json::stringWriterObject (output);
+        Json::WriterObject wo (output);
         auto&& sub = Json::addObject (*wo, jss::result);
         inject_error (error, sub);
     }
     else if (auto method = handler->objectMethod_)
     {
-        auto wo = Json::stringWriterObject (output);
+        Json::WriterObject wo (output);
         getResult (context, method, *wo, handler->name_);
     }
     else if (auto method = handler->valueMethod_)
@@ -256,9 +263,9 @@ void executeRPC (
         auto object = Json::Value (Json::objectValue);
         getResult (context, method, object, handler->name_);
         if (strategy.streaming == YieldStrategy::Streaming::yes)
-            output = jsonAsString (object);
+            Json::outputJson (object, output);
         else
-            output = to_string (object);
+            output (to_string (object));
     }
     else
     {
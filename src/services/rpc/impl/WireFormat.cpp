@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <services/rpc/WireFormat.h>
+#include <common/base/StringUtilities.h>
+#include <common/json/Cbor.h>
+#include <common/json/json_reader.h>
+#include <common/json/to_string.h>
+#include <protocol/JsonFields.h>
+#include <cstring>
+
+namespace truechain {
+namespace RPC {
+
+char const* const cborMediaType = "application/cbor";
+char const* const cborSubprotocol = "truechain-cbor";
+
+namespace {
+
+bool isBlobField (char const* name)
+{
+    static char const* const fields[] = {
+        "tx", "tx_blob", "meta", "ledger_data" };
+
+    for (auto const f : fields)
+        if (std::strcmp (name, f) == 0)
+            return true;
+    return false;
+}
+
+void writeBlob (Json::CborWriter& w, Json::Value const& value)
+{
+    std::string blob;
+    auto const hex = value.asString ();
+
+    if ((hex.size () & 1) == 0 && strUnHex (blob, hex) >= 0)
+        w.bytes (blob.data (), blob.size ());
+    else
+        w.value (value);
+}
+
+void writeResponse (Json::CborWriter& w, Json::Value const& value)
+{
+    if (value.isArray ())
+    {
+        w.startArray (value.size ());
+        for (auto const& i: value)
+            writeResponse (w, i);
+    }
+    else if (value.isObject ())
+    {
+        w.startMap (value.size ());
+        for (auto it = value.begin (); it != value.end (); ++it)
+        {
+            auto const name = it.memberName ();
+            w.text (boost::string_ref (name, std::strlen (name)));
+
+            if ((*it).isString () && isBlobField (name))
+                writeBlob (w, *it);
+            else
+                writeResponse (w, *it);
+        }
+    }
+    else
+    {
+        w.value (value);
+    }
+}
+
+} // namespace
+
+WireFormat formatFromMediaType (std::string const& mediaType)
+{
+    // Only an explicit request for CBOR changes the format; anything else,
+    // including a missing header or "*/*", gets JSON.
+    if (mediaType.find (cborMediaType) != std::string::npos)
+        return WireFormat::cbor;
+    return WireFormat::json;
+}
+
+bool parseRequest (
+    std::string const& request, WireFormat format, Json::Value& jvRequest)
+{
+    if (format == WireFormat::cbor)
+    {
+        if (! Json::parseCbor (request, jvRequest))
+            return false;
+    }
+    else
+    {
+        Json::Reader reader;
+        if (! reader.parse (request, jvRequest))
+            return false;
+    }
+
+    return jvRequest.isObject ();
+}
+
+void preferBinary (Json::Value& params)
+{
+    if (params.isMember (jss::binary))
+        return;
+
+    auto const& command = params[jss::command];
+    if (! command.isString ())
+        return;
+
+    auto const name = command.asString ();
+    if (name == "tx" || name == "account_tx" || name == "ledger")
+        params[jss::binary] = true;
+}
+
+void outputResponse (
+    Json::Value const& value, WireFormat format, Json::Output const& output)
+{
+    if (format == WireFormat::cbor)
+    {
+        Json::CborWriter w (output);
+        writeResponse (w, value);
+    }
+    else
+    {
+        Json::outputJson (value, output);
+    }
+}
+
+std::string encodeResponse (Json::Value const& value, WireFormat format)
+{
+    if (format == WireFormat::json)
+        return to_string (value);
+
+    std::string s;
+    outputResponse (value, format, Json::stringOutput (s));
+    return s;
+}
+
+} // RPC
+} // truechain
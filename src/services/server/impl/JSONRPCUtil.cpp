@@ -25,6 +25,7 @@
 #include <protocol/BuildInfo.h>
 #include <protocol/SystemParameters.h>
 #include <boost/algorithm/string.hpp>
+#include <cstdio>
 
 namespace truechain {
 
@@ -47,6 +48,20 @@ std::string getHTTPHeaderTimestamp ()
     return std::string (buffer);
 }
 
+static void writeStatusLine (int nStatus, Json::Output const& output)
+{
+    switch (nStatus)
+    {
+    case 200: output ("HTTP/1.1 200 OK\r\n"); break;
+    case 400: output ("HTTP/1.1 400 Bad Request\r\n"); break;
+    case 403: output ("HTTP/1.1 403 Forbidden\r\n"); break;
+    case 404: output ("HTTP/1.1 404 Not Found\r\n"); break;
+    case 500: output ("HTTP/1.1 500 Internal Server Error\r\n"); break;
+    }
+
+    output (getHTTPHeaderTimestamp ());
+}
+
 void HTTPReply (
     int nStatus, std::string const& content, Json::Output const& output)
 {
@@ -88,16 +103,7 @@ void HTTPReply (
         return;
     }
 
-    switch (nStatus)
-    {
-    case 200: output ("HTTP/1.1 200 OK\r\n"); break;
-    case 400: output ("HTTP/1.1 400 Bad Request\r\n"); break;
-    case 403: output ("HTTP/1.1 403 Forbidden\r\n"); break;
-    case 404: output ("HTTP/1.1 404 Not Found\r\n"); break;
-    case 500: output ("HTTP/1.1 500 Internal Server Error\r\n"); break;
-    }
-
-    output (getHTTPHeaderTimestamp ());
+    writeStatusLine (nStatus, output);
 
     output ("Connection: Keep-Alive\r\n"
             "Content-Length: ");
@@ -118,4 +124,81 @@ void HTTPReply (
     output ("\r\n");
 }
 
+void HTTPReply (int nStatus, std::string const& content,
+    std::string const& contentType, Json::Output const& output)
+{
+    if (ShouldLog (lsTRACE, RPC))
+    {
+        WriteLog (lsTRACE, RPC) << "HTTP Reply " << nStatus << " "
+            << content.size () << " bytes of " << contentType;
+    }
+
+    writeStatusLine (nStatus, output);
+
+    // The body is sent exactly as given, without the trailing line break
+    // that JSON replies carry.
+    output ("Connection: Keep-Alive\r\n"
+            "Content-Length: ");
+    output (std::to_string (content.size ()));
+    output ("\r\n"
+            "Content-Type: ");
+    output (contentType);
+    output ("\r\n");
+
+    output ("Server: " + systemName () + "-json-rpc/");
+    output (BuildInfo::getFullVersionString ());
+    output ("\r\n"
+            "\r\n");
+    output (content);
+}
+
+//------------------------------------------------------------------------------
+
+HTTPChunkedReply::HTTPChunkedReply (int nStatus, Json::Output const& output)
+    : output_ (output)
+    , body_ ([this] (boost::string_ref const& b) { write (b); })
+{
+    writeStatusLine (nStatus, output_);
+
+    output_ ("Connection: Keep-Alive\r\n"
+             "Transfer-Encoding: chunked\r\n"
+             "Content-Type: application/json; charset=UTF-8\r\n");
+
+    output_ ("Server: " + systemName () + "-json-rpc/");
+    output_ (BuildInfo::getFullVersionString ());
+    output_ ("\r\n"
+             "\r\n");
+
+    buffer_.reserve (chunkSize);
+}
+
+void HTTPChunkedReply::write (boost::string_ref const& b)
+{
+    size_ += b.size ();
+    buffer_.append (b.data (), b.size ());
+
+    if (buffer_.size () >= chunkSize)
+        flush ();
+}
+
+void HTTPChunkedReply::flush ()
+{
+    if (buffer_.empty ())
+        return;
+
+    char size[16];
+    std::snprintf (size, sizeof (size), "%zx\r\n", buffer_.size ());
+
+    output_ (size);
+    buffer_ += "\r\n";
+    output_ (buffer_);
+    buffer_.clear ();
+}
+
+void HTTPChunkedReply::finish ()
+{
+    flush ();
+    output_ ("0\r\n\r\n");
+}
+
 } // truechain
@@ -27,6 +27,54 @@ namespace truechain {
 
 void HTTPReply (int nStatus, std::string const& strMsg, Json::Output const&);
 
+/** Send a reply whose body is not JSON, such as a CBOR encoded result. */
+void HTTPReply (int nStatus, std::string const& content,
+    std::string const& contentType, Json::Output const&);
+
+/** A reply whose body is sent as it is produced, with chunked transfer
+    encoding, instead of being collected into a string first.
+
+    The status line and headers are written on construction.  Body data is
+    gathered into chunks of about chunkSize bytes; finish() sends the last
+    one and ends the body.
+*/
+class HTTPChunkedReply
+{
+public:
+    enum
+    {
+        chunkSize = 16 * 1024
+    };
+
+    HTTPChunkedReply (int nStatus, Json::Output const& output);
+
+    HTTPChunkedReply (HTTPChunkedReply const&) = delete;
+    HTTPChunkedReply& operator= (HTTPChunkedReply const&) = delete;
+
+    /** The Output to write the body to. */
+    Json::Output const& body () const
+    {
+        return body_;
+    }
+
+    void finish ();
+
+    /** The number of body bytes written so far. */
+    std::size_t size () const
+    {
+        return size_;
+    }
+
+private:
+    void write (boost::string_ref const&);
+    void flush ();
+
+    Json::Output output_;
+    Json::Output body_;
+    std::string buffer_;
+    std::size_t size_ = 0;
+};
+
 } // truechain
 
 #endif
@@ -37,6 +37,7 @@
 
 #include <beast/crypto/base64.h>
 #include <services/rpc/RPCHandler.h>
+#include <services/rpc/WireFormat.h>
 #include <beast/cxx14/algorithm.h> // <algorithm>
 #include <beast/http/rfc2616.h>
 #include <boost/algorithm/string.hpp>
@@ -241,12 +242,16 @@ ServerHandlerImp::processSession (
     if (auto byteYieldCount = setup_.yieldStrategy.byteYieldCount)
         output = RPC::chunkedYieldingOutput (output, yield, byteYieldCount);
 
+    auto const& headers = session->request().headers;
+
     processRequest (
         session->port(),
         to_string (session->body()),
         session->remoteAddress().at_port (0),
         output,
-        yield);
+        yield,
+        RPC::formatFromMediaType (headers["Content-Type"]),
+        RPC::formatFromMediaType (headers["Accept"]));
 
     if (session->request().keep_alive())
         session->complete();
@@ -260,15 +265,14 @@ ServerHandlerImp::processRequest (
     std::string const& request,
     beast::IP::Endpoint const& remoteIPAddress,
     Output output,
-    Yield yield)
+    Yield yield,
+    RPC::WireFormat requestFormat,
+    RPC::WireFormat replyFormat)
 {
     Json::Value jsonRPC;
     {
-        Json::Reader reader;
         if ((request.size () > 1000000) ||
-            ! reader.parse (request, jsonRPC) ||
-            jsonRPC.isNull () ||
-            ! jsonRPC.isObject ())
+            ! RPC::parseRequest (request, requestFormat, jsonRPC))
         {
             HTTPReply (400, "Unable to parse request", output);
             return;
@@ -373,6 +377,9 @@ ServerHandlerImp::processRequest (
 
     // Provide the JSON-RPC method as the field "command" in the request.
     params[jss::command] = strMethod;
+
+    if (replyFormat == RPC::WireFormat::cbor)
+        RPC::preferBinary (params);
     //WriteLog (lsWARNING, RPCErr) <<"----RPC---CMD: "<<params;
     WriteLog (lsTRACE, RPCHandler)
         << "doRpcCommand:" << strMethod << ":" << params.toStyledString();
@@ -381,13 +388,39 @@ ServerHandlerImp::processRequest (
     RPC::Context context {params, loadType, m_networkOPs, role, nullptr, yield};
     //RPC::RPCInfo::updateCmd(context.params,true);
     
-    std::string response;
+    auto const notify = [&] (std::size_t size)
+    {
+        rpc_time_.notify (static_cast <beast::insight::Event::value_type> (
+            std::chrono::duration_cast <std::chrono::milliseconds> (
+                std::chrono::high_resolution_clock::now () - start)));
+        ++rpc_requests_;
+        rpc_io_.notify (static_cast <beast::insight::Event::value_type> (
+            context.metrics.fetches));
+        rpc_size_.notify (static_cast <beast::insight::Event::value_type> (
+            size));
+    };
 
-    if (setup_.yieldStrategy.streaming == RPC::YieldStrategy::Streaming::yes)
+    if (setup_.yieldStrategy.streaming == RPC::YieldStrategy::Streaming::yes &&
+        replyFormat == RPC::WireFormat::json)
     {
-        executeRPC (context, response, setup_.yieldStrategy);
+        // Send the result as the handler writes it instead of collecting
+        // the whole response first
+        HTTPChunkedReply reply (200, output);
+        executeRPC (context, reply.body (), setup_.yieldStrategy);
+
+        auto const size = reply.size ();
+        reply.body () ("\n");
+        reply.finish ();
+
+        notify (size);
+        usage.charge (loadType);
+
+        m_journal.debug << "Reply: " << size << " bytes streamed";
+        return;
     }
-    else
+
+    std::string response;
+
     {
         Json::Value result;
         RPC::doCommand (context, result, setup_.yieldStrategy);
@@ -409,20 +442,20 @@ ServerHandlerImp::processRequest (
 
         Json::Value reply (Json::objectValue);
         reply[jss::result] = std::move (result);
-        response = to_string (reply);
+        response = RPC::encodeResponse (reply, replyFormat);
     }
 
-    rpc_time_.notify (static_cast <beast::insight::Event::value_type> (
-        std::chrono::duration_cast <std::chrono::milliseconds> (
-            std::chrono::high_resolution_clock::now () - start)));
-    ++rpc_requests_;
-    rpc_io_.notify (static_cast <beast::insight::Event::value_type> (
-        context.metrics.fetches));
-    rpc_size_.notify (static_cast <beast::insight::Event::value_type> (
-        response.size ()));
+    notify (response.size ());
+    usage.charge (loadType);
+
+    if (replyFormat == RPC::WireFormat::cbor)
+    {
+        m_journal.debug << "Reply: " << response.size () << " bytes of CBOR";
+        HTTPReply (200, response, RPC::cborMediaType, output);
+        return;
+    }
 
     response += '\n';
-    usage.charge (loadType);
 
     if (m_journal.debug.active())
     {
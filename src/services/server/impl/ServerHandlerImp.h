@@ -25,6 +25,7 @@
 #include <services/server/ServerHandler.h>
 #include <services/server/Session.h>
 #include <services/rpc/RPCHandler.h>
+#include <services/rpc/WireFormat.h>
 #include <services/server/Handler.h>
 #include <services/rpc/handlers/RPCInfo.h>
 #include <main/CollectorManager.h>
@@ -113,7 +114,9 @@ private:
 
     void
     processRequest (HTTP::Port const& port, std::string const& request,
-        beast::IP::Endpoint const& remoteIPAddress, Output, Yield);
+        beast::IP::Endpoint const& remoteIPAddress, Output, Yield,
+        RPC::WireFormat requestFormat = RPC::WireFormat::json,
+        RPC::WireFormat replyFormat = RPC::WireFormat::json);
 
     //
     // PropertyStream
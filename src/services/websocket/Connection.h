@@ -36,6 +36,7 @@
 #include <services/rpc/RPCHandler.h>
 #include <services/server/Port.h>
 #include <services/rpc/RPCHandler.h>
+#include <services/rpc/WireFormat.h>
 #include <services/server/Role.h>
 #include <services/websocket/WebSocket.h>
 
@@ -81,6 +82,14 @@ public:
     }
 
     void send (Json::Value const& jvObj, bool broadcast);
+    void send (Json::Value const& jvObj, std::string const& sObj,
+        bool broadcast) override;
+    void sendEncoded (std::string const& message, bool broadcast) override;
+
+    RPC::WireFormat getWireFormat () const override
+    {
+        return m_format;
+    }
 
     void disconnect ();
     static void handle_disconnect(weak_connection_ptr c);
@@ -104,6 +113,7 @@ private:
     Resource::Consumer m_usage;
     bool const m_isPublic;
     beast::IP::Endpoint const m_remoteAddress;
+    RPC::WireFormat const m_format;
     std::mutex m_receiveQueueMutex;
     std::deque <message_ptr> m_receiveQueue;
     NetworkOPs& m_netOPs;
@@ -132,6 +142,7 @@ ConnectionImpl <WebSocket>::ConnectionImpl (
         , m_resourceManager (resourceManager)
         , m_isPublic (handler.getPublic ())
         , m_remoteAddress (remoteAddress)
+        , m_format (WebSocket::getWireFormat (*cpConnection))
         , m_netOPs (getApp ().getOPs ())
         , m_io_service (io_service)
         , m_pingTimer (io_service)
@@ -329,8 +340,47 @@ void ConnectionImpl <WebSocket>::send (Json::Value const& jvObj, bool broadcast)
             << "WebSocket: sending '" << to_string (jvObj);
     connection_ptr ptr = m_connection.lock ();
 
-    if (ptr)
+    if (! ptr)
+        return;
+
+    if (m_format == RPC::WireFormat::json)
         m_handler.send (ptr, jvObj, broadcast);
+    else
+        m_handler.sendBinary (
+            ptr, RPC::encodeResponse (jvObj, m_format), broadcast);
+}
+
+// Stream messages come already rendered; send the text as is instead of
+// rendering it again for every connection.
+template <class WebSocket>
+void ConnectionImpl <WebSocket>::send (
+    Json::Value const& jvObj, std::string const& sObj, bool broadcast)
+{
+    if (m_format != RPC::WireFormat::json)
+    {
+        send (jvObj, broadcast);
+        return;
+    }
+
+    connection_ptr ptr = m_connection.lock ();
+
+    if (ptr)
+        m_handler.send (ptr, sObj, broadcast);
+}
+
+template <class WebSocket>
+void ConnectionImpl <WebSocket>::sendEncoded (
+    std::string const& message, bool broadcast)
+{
+    connection_ptr ptr = m_connection.lock ();
+
+    if (! ptr)
+        return;
+
+    if (m_format == RPC::WireFormat::json)
+        m_handler.send (ptr, message, broadcast);
+    else
+        m_handler.sendBinary (ptr, message, broadcast);
 }
 
 template <class WebSocket>
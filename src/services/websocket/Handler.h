@@ -148,6 +148,22 @@ public:
         send (cpClient, to_string (jvObj), broadcast);
     }
 
+    void sendBinary (connection_ptr const& cpClient,
+                     std::string const& message, bool broadcast)
+    {
+        try
+        {
+            WriteLog (broadcast ? lsTRACE : lsDEBUG, HandlerLog)
+                    << "Ws:: Sending " << message.size () << " bytes";
+
+            WebSocket::sendBinary (*cpClient, message);
+        }
+        catch (...)
+        {
+            WebSocket::closeTooSlowClient (*cpClient, crTooSlow);
+        }
+    }
+
     void pingTimer (connection_ptr const& cpClient)
     {
         wsc_ptr ptr;
@@ -382,7 +398,6 @@ public:
                      const wsc_ptr& conn, const message_ptr& mpMessage)
     {
         Json::Value     jvRequest;
-        Json::Reader    jrReader;
 
         try
         {
@@ -395,26 +410,30 @@ public:
         {
         }
 
-        if (!WebSocket::isTextMessage (*mpMessage))
+        auto const format = conn->getWireFormat ();
+        bool const isText = WebSocket::isTextMessage (*mpMessage);
+
+        if (!isText && format == RPC::WireFormat::json)
         {
             Json::Value jvResult (Json::objectValue);
 
             jvResult[jss::type]    = jss::error;
             jvResult[jss::error]   = "wsTextRequired";
-            // We only accept text messages.
+            // We only accept text messages unless the client asked for CBOR.
 
             send (cpClient, jvResult, false);
         }
-        else if (!jrReader.parse (mpMessage->get_payload (), jvRequest) ||
-                 jvRequest.isNull () || !jvRequest.isObject ())
+        else if (!RPC::parseRequest (mpMessage->get_payload (),
+                    isText ? RPC::WireFormat::json : format, jvRequest))
         {
             Json::Value jvResult (Json::objectValue);
 
             jvResult[jss::type]    = jss::error;
             jvResult[jss::error]   = "jsonInvalid";    // Received invalid json.
-            jvResult[jss::value]   = mpMessage->get_payload ();
+            if (isText)
+                jvResult[jss::value]   = mpMessage->get_payload ();
 
-            send (cpClient, jvResult, false);
+            conn->send (jvResult, false);
         }
         else
         {
@@ -426,17 +445,23 @@ public:
             } 
             RPC::RPCInfo::updateCmd(jvRequest,false);
 
+            if (format != RPC::WireFormat::json)
+                RPC::preferBinary (jvRequest);
+
             auto const start (std::chrono::high_resolution_clock::now ());
             Json::Value const jvObj (conn->invokeCommand (jvRequest));
             RPC::RPCInfo::updateError(jvRequest,jvObj,false);
-            std::string const buffer (to_string (jvObj));
+            std::string const buffer (RPC::encodeResponse (jvObj, format));
             rpc_time_.notify (static_cast <beast::insight::Event::value_type> (
                 std::chrono::duration_cast <std::chrono::milliseconds> (
                     std::chrono::high_resolution_clock::now () - start)));
             ++rpc_requests_;
             rpc_size_.notify (static_cast <beast::insight::Event::value_type>
                 (buffer.size ()));
-            send (cpClient, buffer, false);
+            if (format == RPC::WireFormat::json)
+                send (cpClient, buffer, false);
+            else
+                sendBinary (cpClient, buffer, false);
         }
 
         return true;
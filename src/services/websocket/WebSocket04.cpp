@@ -58,6 +58,18 @@ bool WebSocket04::isTextMessage (Message const& message)
     return message.get_opcode () == websocketpp::frame::opcode::text;
 }
 
+RPC::WireFormat WebSocket04::getWireFormat (Connection& connection)
+{
+    if (connection.get_subprotocol () == RPC::cborSubprotocol)
+        return RPC::WireFormat::cbor;
+    return RPC::WireFormat::json;
+}
+
+void WebSocket04::sendBinary (Connection& connection, std::string const& data)
+{
+    connection.send (data, websocketpp::frame::opcode::binary);
+}
+
 using HandlerPtr04 = WebSocket04::HandlerPtr;
 using EndpointPtr04 = WebSocket04::EndpointPtr;
 
@@ -100,6 +112,24 @@ EndpointPtr04  WebSocket04::makeEndpoint (HandlerPtr&& handler)
                 endpoint->handler()->http (conn);
         });
 
+    // Agree to CBOR if the client offers it; any other subprotocol is
+    // ignored and the connection stays on JSON.
+    endpoint->set_validate_handler (
+        [endpoint] (websocketpp::connection_hdl hdl) {
+            if (auto conn = endpoint->get_con_from_hdl(hdl))
+            {
+                for (auto const& p : conn->get_requested_subprotocols ())
+                {
+                    if (p == RPC::cborSubprotocol)
+                    {
+                        conn->select_subprotocol (p);
+                        break;
+                    }
+                }
+            }
+            return true;
+        });
+
     endpoint->set_message_handler (
         [endpoint] (websocketpp::connection_hdl hdl,
                     MessagePtr msg) {
@@ -22,6 +22,7 @@
 
 #include <services/websocket/Config04.h>
 #include <services/websocket/WebSocket.h>
+#include <services/rpc/WireFormat.h>
 
 #include <boost/make_shared.hpp>
 #include <beast/weak_fn.h>
@@ -90,6 +91,14 @@ struct WebSocket04
     static
     bool isTextMessage (Message const&);
 
+    /** Return the format the client chose with its subprotocol. */
+    static
+    RPC::WireFormat getWireFormat (Connection&);
+
+    /** Send a BINARY message. */
+    static
+    void sendBinary (Connection&, std::string const&);
+
     /** Create a new Handler. */
     static
     HandlerPtr makeHandler (ServerDescription const&);
@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_APP_BOOK_BOOKINDEX_H_INCLUDED
+#define SKYWELL_APP_BOOK_BOOKINDEX_H_INCLUDED
+
+#include <transaction/book/Types.h>
+#include <ledger/Ledger.h>
+#include <common/base/UnorderedContainers.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace truechain {
+namespace core {
+
+/** The offers of order books in a closed ledger, best quality first.
+
+    A book is read from the ledger the first time it is asked for. It is
+    then kept as a flat array together with what each of its owners can pay.
+    When a newer closed ledger is asked about, the metadata of the ledgers
+    in between is used to decide what to keep. A book is kept if none of
+    its offers, owners or issuers changed. Everything else is dropped and
+    read again on demand.
+
+    Books with no offers are not kept, and past a limit the book used
+    least recently is dropped, so requests for made up books can't grow
+    the index.
+*/
+class BookIndex
+{
+public:
+    struct Offer
+    {
+        SLE::pointer entry;
+        Account owner;
+
+        // The quality of the directory holding the offer
+        STAmount rate;
+    };
+
+    /** One book in one ledger. Never changes once built. */
+    struct Offers
+    {
+        typedef std::shared_ptr <Offers const> pointer;
+
+        std::vector <Offer> offers;
+
+        // False if the book had more offers than were read
+        bool complete;
+
+        bool globalFreeze;
+        std::uint32_t transferRate;
+
+        // What each owner holds of the currency its offers give, before
+        // any of them are taken. Owners issuing the currency are left out.
+        hash_map <Account, STAmount> funds;
+    };
+
+    /** @param maximumBooks The most books kept at once. */
+    explicit BookIndex (std::size_t maximumBooks = 1000);
+
+    /** Return the offers of the book, or null if the ledger is not one
+        the index can keep.
+    */
+    Offers::pointer getOffers (Ledger::ref ledger, Book const& book);
+
+    /** Return the number of books kept. */
+    std::size_t size ();
+
+private:
+    // Move the index to the ledger if it is newer.
+    // Returns false if the index can't be used for it.
+    bool useLedger (Ledger::ref ledger);
+
+    static Offers::pointer build (Ledger::ref ledger, Book const& book);
+
+    // Make room for one more book
+    void evict ();
+
+    struct Entry
+    {
+        Offers::pointer offers;
+
+        // When the book was last asked for
+        std::uint64_t lastUse;
+    };
+
+    typedef std::mutex LockType;
+    typedef std::lock_guard <LockType> ScopedLockType;
+    LockType mLock;
+
+    std::size_t const mMaximumBooks;
+
+    LedgerIndex mSeq;
+    uint256 mHash;
+
+    // Counts requests, to order the books by use
+    std::uint64_t mUses;
+
+    hash_map <Book, Entry> mBooks;
+};
+
+} // core
+} // truechain
+
+#endif
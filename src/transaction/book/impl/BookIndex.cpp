@@ -0,0 +1,261 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/book/BookIndex.h>
+#include <transaction/paths/LiquidityChanges.h>
+#include <ledger/LedgerMaster.h>
+#include <main/Application.h>
+#include <protocol/Indexes.h>
+
+namespace truechain {
+namespace core {
+
+namespace {
+
+enum
+{
+    // The most offers read into one book
+    maximumOffers = 2000,
+
+    // The most ledgers the index is carried forward across at once
+    maximumCarriedLedgers = 10
+};
+
+}
+
+BookIndex::BookIndex (std::size_t maximumBooks)
+    : mMaximumBooks (maximumBooks)
+    , mSeq (0)
+    , mUses (0)
+{
+}
+
+BookIndex::Offers::pointer
+BookIndex::getOffers (Ledger::ref ledger, Book const& book)
+{
+    {
+        ScopedLockType sl (mLock);
+
+        if (!useLedger (ledger))
+            return nullptr;
+
+        auto const it = mBooks.find (book);
+        if (it != mBooks.end ())
+        {
+            it->second.lastUse = ++mUses;
+            return it->second.offers;
+        }
+    }
+
+    // Read the book without holding the lock
+    auto offers = build (ledger, book);
+
+    ScopedLockType sl (mLock);
+
+    // Only keep it if the index did not move on meanwhile. An empty book
+    // costs little to read again.
+    if (!offers->offers.empty () &&
+        (mSeq == ledger->getLedgerSeq ()) && (mHash == ledger->getHash ()) &&
+        (mBooks.find (book) == mBooks.end ()))
+    {
+        if (mBooks.size () >= mMaximumBooks)
+            evict ();
+
+        mBooks.emplace (book, Entry {offers, ++mUses});
+    }
+
+    return offers;
+}
+
+std::size_t
+BookIndex::size ()
+{
+    ScopedLockType sl (mLock);
+    return mBooks.size ();
+}
+
+void
+BookIndex::evict ()
+{
+    auto oldest = mBooks.begin ();
+
+    for (auto it = mBooks.begin (); it != mBooks.end (); ++it)
+    {
+        if (it->second.lastUse < oldest->second.lastUse)
+            oldest = it;
+    }
+
+    if (oldest != mBooks.end ())
+        mBooks.erase (oldest);
+}
+
+bool
+BookIndex::useLedger (Ledger::ref ledger)
+{
+    // Only a closed ledger stays the same while it is indexed
+    if (!ledger->isClosed ())
+        return false;
+
+    LedgerIndex const seq = ledger->getLedgerSeq ();
+    uint256 const& hash = ledger->getHash ();
+
+    if (seq < mSeq)
+        return false;
+
+    if (seq == mSeq)
+    {
+        if (hash != mHash)
+            mBooks.clear ();
+    }
+    else if (mBooks.empty () || ((seq - mSeq) > maximumCarriedLedgers))
+    {
+        mBooks.clear ();
+    }
+    else
+    {
+        // Collect what the ledgers since the indexed one changed, making
+        // sure they follow on from it
+        LiquidityChanges changes;
+        uint256 parent = mHash;
+        bool follows = true;
+
+        for (auto i = mSeq + 1; follows && (i <= seq); ++i)
+        {
+            auto const next = (i == seq) ? ledger :
+                getApp().getLedgerMaster ().getLedgerBySeq (i);
+
+            if (!next || (next->getParentHash () != parent))
+                follows = false;
+            else
+            {
+                changes.addLedger (next);
+                parent = next->getHash ();
+            }
+        }
+
+        if (!follows)
+        {
+            mBooks.clear ();
+        }
+        else
+        {
+            auto const unchanged = [&changes] (
+                Book const& book, Offers const& offers)
+            {
+                if (changes.hasChangedBook (book) ||
+                    changes.hasChangedAccount (book.in.account) ||
+                    changes.hasChangedAccount (book.out.account))
+                    return false;
+
+                for (auto const& owner : offers.funds)
+                {
+                    if (changes.hasChangedAccount (owner.first))
+                        return false;
+                }
+
+                return true;
+            };
+
+            for (auto it = mBooks.begin (); it != mBooks.end ();)
+            {
+                if (unchanged (it->first, *it->second.offers))
+                    ++it;
+                else
+                    it = mBooks.erase (it);
+            }
+        }
+    }
+
+    mSeq = seq;
+    mHash = hash;
+    return true;
+}
+
+BookIndex::Offers::pointer
+BookIndex::build (Ledger::ref ledger, Book const& book)
+{
+    auto offers = std::make_shared <Offers> ();
+    offers->complete = true;
+
+    LedgerEntrySet les (ledger, tapNONE, true);
+
+    offers->globalFreeze = les.isGlobalFrozen (book.out.account) ||
+        les.isGlobalFrozen (book.in.account);
+    offers->transferRate = truechainTransferRate (les, book.out.account);
+
+    uint256 const bookBase = getBookBase (book);
+    uint256 const bookEnd = getQualityNext (bookBase);
+    uint256 tip = bookBase;
+
+    while (offers->complete)
+    {
+        SLE::pointer dir = les.entryCache (ltDIR_NODE,
+            ledger->getNextLedgerIndex (tip, bookEnd));
+
+        if (!dir)
+            break;
+
+        tip = dir->getIndex ();
+        STAmount const rate = amountFromQuality (getQuality (tip));
+
+        unsigned int entry;
+        uint256 offerIndex;
+
+        for (bool more = les.dirFirst (tip, dir, entry, offerIndex); more;
+            more = les.dirNext (tip, dir, entry, offerIndex))
+        {
+            if (offers->offers.size () >= maximumOffers)
+            {
+                offers->complete = false;
+                break;
+            }
+
+            auto sleOffer = les.entryCache (ltOFFER, offerIndex);
+
+            if (!sleOffer)
+            {
+                WriteLog (lsWARNING, BookIndex) << "Missing offer";
+                continue;
+            }
+
+            Account const owner = sleOffer->getFieldAccount160 (sfAccount);
+
+            if (!offers->globalFreeze && (owner != book.out.account) &&
+                (offers->funds.find (owner) == offers->funds.end ()))
+            {
+                STAmount funds = les.accountHolds (owner, book.out.currency,
+                    book.out.account, fhZERO_IF_FROZEN);
+
+                // Treat negative funds as zero
+                if (funds < zero)
+                    funds.clear ();
+
+                offers->funds.emplace (owner, funds);
+            }
+
+            offers->offers.push_back ({sleOffer, owner, rate});
+        }
+    }
+
+    return offers;
+}
+
+} // core
+} // truechain
@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/book/BookIndex.h>
+#include <protocol/Indexes.h>
+#include <protocol/SystemParameters.h>
+#include <beast/unit_test/suite.h>
+#include <functional>
+#include <vector>
+
+namespace truechain {
+namespace core {
+
+// Checks that the books the index keeps stay bounded
+class BookIndex_test : public beast::unit_test::suite
+{
+public:
+    enum
+    {
+        maximumBooks = 4,
+
+        // Enough to drop every book but the one used again
+        bookCount = maximumBooks + 3
+    };
+
+    static Book
+    makeBook (std::uint64_t i)
+    {
+        Account const issuer (i + 1);
+        return Book (Issue (to_currency ("USD"), issuer),
+            Issue (to_currency ("EUR"), issuer));
+    }
+
+    // Place one offer in the book, without its owner directory
+    static void
+    addOffer (LedgerEntrySet& les, Account const& owner,
+        std::uint32_t sequence, Book const& book)
+    {
+        STAmount const pays (book.in, 100);
+        STAmount const gets (book.out, 100);
+        std::uint64_t const rate = getRate (gets, pays);
+        uint256 const offerIndex = getOfferIndex (owner, sequence);
+        uint256 const directory = getQualityIndex (getBookBase (book), rate);
+
+        std::uint64_t bookNode;
+        les.dirAdd (bookNode, directory, offerIndex, std::bind (
+            &Ledger::qualityDirDescriber, std::placeholders::_1,
+            std::placeholders::_2, pays.getCurrency (), pays.getIssuer (),
+            gets.getCurrency (), gets.getIssuer (), rate));
+
+        SLE::pointer offer = les.entryCreate (ltOFFER, offerIndex);
+        offer->setFieldAccount (sfAccount, owner);
+        offer->setFieldU32 (sfSequence, sequence);
+        offer->setFieldH256 (sfBookDirectory, directory);
+        offer->setFieldAmount (sfTakerPays, pays);
+        offer->setFieldAmount (sfTakerGets, gets);
+        offer->setFieldU64 (sfOwnerNode, 0);
+        offer->setFieldU64 (sfBookNode, bookNode);
+    }
+
+    void
+    run ()
+    {
+        SkywellAddress const master = SkywellAddress::createAccountPublic (
+            SkywellAddress::createGeneratorPublic (
+                SkywellAddress::createSeedGeneric ("masterpassphrase")), 0);
+
+        Ledger::pointer genesis =
+            std::make_shared<Ledger> (master, SYSTEM_CURRENCY_START);
+        genesis->updateHash ();
+        genesis->setClosed ();
+        genesis->setAccepted ();
+        genesis->setImmutable ();
+
+        // A closed ledger with one offer in each book
+        Ledger::pointer ledger =
+            std::make_shared<Ledger> (true, std::ref (*genesis));
+        {
+            LedgerEntrySet les (ledger, tapNONE);
+            Account const owner = master.getAccountID ();
+
+            for (int i = 0; i < bookCount; ++i)
+                addOffer (les, owner, i + 1, makeBook (i));
+
+            for (auto const& it : les)
+            {
+                if (it.second.mAction == taaCREATE)
+                    ledger->writeBack (lepCREATE, it.second.mEntry);
+                else if (it.second.mAction == taaMODIFY)
+                    ledger->writeBack (lepNONE, it.second.mEntry);
+            }
+        }
+        ledger->updateHash ();
+        ledger->setClosed ();
+        ledger->setAccepted ();
+        ledger->setImmutable ();
+
+        BookIndex index (maximumBooks);
+
+        testcase ("empty books");
+
+        for (int i = bookCount; i < bookCount + 1000; ++i)
+        {
+            auto const offers = index.getOffers (ledger, makeBook (i));
+            expect (offers && offers->offers.empty () && offers->complete);
+        }
+
+        expect (index.size () == 0, "empty books were kept");
+
+        testcase ("least recently used");
+
+        std::vector <BookIndex::Offers::pointer> first;
+
+        for (int i = 0; i < maximumBooks; ++i)
+        {
+            first.push_back (index.getOffers (ledger, makeBook (i)));
+            expect (first.back () && (first.back ()->offers.size () == 1));
+        }
+
+        expect (index.size () == maximumBooks);
+
+        // Use book 0 again, so book 1 is now the oldest
+        expect (index.getOffers (ledger, makeBook (0)) == first[0]);
+
+        for (int i = maximumBooks; i < bookCount; ++i)
+        {
+            expect (index.getOffers (ledger, makeBook (i)) != nullptr);
+            expect (index.size () == maximumBooks, "too many books kept");
+        }
+
+        // Only book 0 and the newest books survived
+        expect (index.getOffers (ledger, makeBook (0)) == first[0],
+            "book 0 was dropped");
+        expect (index.getOffers (ledger, makeBook (1)) != first[1],
+            "book 1 was kept");
+        expect (index.getOffers (ledger, makeBook (2)) != first[2],
+            "book 2 was kept");
+        expect (index.size () == maximumBooks);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(BookIndex,book,truechain);
+
+} // core
+} // truechain
@@ -36,24 +36,11 @@ CurrencySet accountSourceCurrencies (
     // List of truechain lines.
     auto& truechainLines (lrCache->getSkywellLines (raAccountID.getAccountID ()));
 
-    for (auto const& item : truechainLines)
+    for (auto const& line : truechainLines)
     {
-        auto rspEntry = (SkywellState*) item.get ();
-        assert (rspEntry);
-        if (!rspEntry)
-            continue;
-
-        auto& saBalance = rspEntry->getBalance ();
-
-        // Filter out non
-        if (saBalance > zero
-            // Have IOUs to send.
-            || (rspEntry->getLimitPeer ()
-                // Peer extends credit.
-                && ((-saBalance) < rspEntry->getLimitPeer ()))) // Credit left.
-        {
-            currencies.insert (saBalance.getCurrency ());
-        }
+        // Have IOUs to send, or the peer extends credit with some left
+        if (line.canSend ())
+            currencies.insert (line.getCurrency ());
     }
 
     currencies.erase (badCurrency());
@@ -74,17 +61,10 @@ CurrencySet accountDestCurrencies (
     // List of truechain lines.
     auto& truechainLines (lrCache->getSkywellLines (raAccountID.getAccountID ()));
 
-    for (auto const& item : truechainLines)
+    for (auto const& line : truechainLines)
     {
-        auto rspEntry = (SkywellState*) item.get ();
-        assert (rspEntry);
-        if (!rspEntry)
-            continue;
-
-        auto& saBalance  = rspEntry->getBalance ();
-
-        if (saBalance < rspEntry->getLimit ())                  // Can take more
-            currencies.insert (saBalance.getCurrency ());
+        if (line.canReceive ())                                 // Can take more
+            currencies.insert (line.getCurrency ());
     }
 
     currencies.erase (badCurrency());
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/paths/LiquidityChanges.h>
+#include <ledger/AcceptedLedger.h>
+
+namespace truechain {
+
+void LiquidityChanges::addLedger (Ledger::ref ledger)
+{
+    auto const accepted = AcceptedLedger::makeAcceptedLedger (ledger);
+
+    for (auto const& item : accepted->getMap ())
+    {
+        if (auto const& meta = item.second->getMeta ())
+        {
+            for (auto const& node : meta->getNodes ())
+                addNode (node);
+        }
+    }
+}
+
+void LiquidityChanges::addNode (STObject const& node)
+{
+    bool const created = node.getFName () == sfCreatedNode;
+    bool const deleted = node.getFName () == sfDeletedNode;
+
+    auto const fields = dynamic_cast<const STObject*> (
+        node.peekAtPField (created ? sfNewFields : sfFinalFields));
+
+    if (!fields)
+        return;
+
+    switch (node.getFieldU16 (sfLedgerEntryType))
+    {
+    case ltACCOUNT_ROOT:
+        if (fields->isFieldPresent (sfAccount))
+            mRoots.insert (fields->getFieldAccount160 (sfAccount));
+        break;
+
+    case ltSKYWELL_STATE:
+    {
+        if (!fields->isFieldPresent (sfLowLimit) ||
+            !fields->isFieldPresent (sfHighLimit))
+            break;
+
+        auto const low = fields->getFieldAmount (sfLowLimit).getIssuer ();
+        auto const high = fields->getFieldAmount (sfHighLimit).getIssuer ();
+
+        mLinePeers[low].push_back (high);
+        mLinePeers[high].push_back (low);
+
+        if (created || deleted)
+        {
+            mNewLines.insert (low);
+            mNewLines.insert (high);
+        }
+        break;
+    }
+
+    case ltOFFER:
+        if (fields->isFieldPresent (sfTakerPays) &&
+            fields->isFieldPresent (sfTakerGets))
+        {
+            mBooks.emplace (
+                fields->getFieldAmount (sfTakerPays).getCurrency (),
+                fields->getFieldAmount (sfTakerGets).getCurrency ());
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+bool LiquidityChanges::affects (hash_set<Account> const& accounts,
+    std::set<Currency> const& currencies) const
+{
+    for (auto const& account : accounts)
+    {
+        if (mRoots.count (account) || mNewLines.count (account))
+            return true;
+
+        auto const it = mLinePeers.find (account);
+        if (it == mLinePeers.end ())
+            continue;
+
+        for (auto const& peer : it->second)
+        {
+            if (accounts.count (peer))
+                return true;
+        }
+    }
+
+    for (auto const& book : mBooks)
+    {
+        if (currencies.count (book.first) && currencies.count (book.second))
+            return true;
+    }
+
+    return false;
+}
+
+} // truechain
@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_APP_PATHS_LIQUIDITYCHANGES_H_INCLUDED
+#define SKYWELL_APP_PATHS_LIQUIDITYCHANGES_H_INCLUDED
+
+#include <ledger/Ledger.h>
+#include <protocol/Book.h>
+#include <protocol/UintTypes.h>
+#include <common/base/UnorderedContainers.h>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace truechain {
+
+/** The parts of the path finding graph that a run of ledgers changed.
+
+    Trust lines, account roots and order books are collected from the
+    metadata of each ledger's transactions.  Path finding uses this to keep
+    the trust lines of untouched accounts from one ledger to the next, and
+    to leave alone path requests whose paths were not affected.
+*/
+class LiquidityChanges
+{
+public:
+    typedef std::shared_ptr <LiquidityChanges const> pointer;
+
+    /** Add the changes one ledger made to its parent. */
+    void addLedger (Ledger::ref ledger);
+
+    /** Return true if any trust line of the account changed. */
+    bool hasChangedLines (Account const& account) const
+    {
+        return mLinePeers.count (account) != 0;
+    }
+
+    /** Return true if the account's root or any of its trust lines
+        changed.
+    */
+    bool hasChangedAccount (Account const& account) const
+    {
+        return mRoots.count (account) || mLinePeers.count (account);
+    }
+
+    /** Return true if an offer between the currencies of the book changed. */
+    bool hasChangedBook (Book const& book) const
+    {
+        return mBooks.count (std::make_pair (
+            book.in.currency, book.out.currency)) != 0;
+    }
+
+    /** Return true if a search over these accounts and currencies could
+        come out differently.
+
+        That is the case if one of the accounts changed, gained or lost a
+        trust line, if a trust line between two of the accounts changed, or
+        if an order book between two of the currencies changed.
+    */
+    bool affects (hash_set<Account> const& accounts,
+        std::set<Currency> const& currencies) const;
+
+private:
+    void addNode (STObject const& node);
+
+    // Account roots that changed
+    hash_set<Account> mRoots;
+
+    // Accounts that gained or lost a trust line
+    hash_set<Account> mNewLines;
+
+    // Both ends of every trust line that changed
+    hash_map<Account, std::vector<Account>> mLinePeers;
+
+    // The currencies of every order book that changed, as (in, out)
+    std::set<std::pair<Currency, Currency>> mBooks;
+};
+
+} // truechain
+
+#endif
@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/paths/PathQuoteCache.h>
+#include <transaction/paths/Tuning.h>
+#include <protocol/Serializer.h>
+
+namespace truechain {
+
+PathQuoteCache::PathQuoteCache ()
+    : mLedgerSeq (0)
+{
+}
+
+uint256 PathQuoteCache::makeKey (Request const& request, bool bucket) const
+{
+    Serializer s (128);
+
+    s.add8 (bucket ? 1 : 0);
+    s.add160 (request.srcAccount);
+    s.add160 (request.dstAccount);
+    s.add160 (request.srcIssue.currency);
+    s.add160 (request.srcIssue.account);
+    s.add32 (request.searchLevel);
+
+    STAmount const& amount = request.dstAmount;
+    s.add160 (amount.getCurrency ());
+    s.add160 (amount.getIssuer ());
+
+    if (!bucket)
+    {
+        s.add64 (amount.mantissa ());
+        s.add32 (amount.exponent ());
+        s.add8 (amount.negative () ? 1 : 0);
+    }
+    else
+    {
+        // Keep only the power of ten and the leading digit
+        std::uint64_t mantissa = amount.mantissa ();
+        int magnitude = amount.exponent ();
+
+        while (mantissa >= 10)
+        {
+            mantissa /= 10;
+            ++magnitude;
+        }
+
+        s.add32 (magnitude);
+        s.add8 (static_cast<unsigned char> (mantissa));
+    }
+
+    return s.getSHA512Half ();
+}
+
+bool PathQuoteCache::useLedger (Ledger::ref ledger)
+{
+    // Only a closed ledger stays the same while it is cached
+    if (!ledger->isClosed ())
+        return false;
+
+    LedgerIndex const seq = ledger->getLedgerSeq ();
+
+    if (seq < mLedgerSeq)
+        return false;
+
+    uint256 const& hash = ledger->getHash ();
+
+    if ((seq > mLedgerSeq) || (hash != mLedgerHash))
+    {
+        mLedgerSeq = seq;
+        mLedgerHash = hash;
+        mPaths.clear ();
+        mQuotes.clear ();
+    }
+
+    return true;
+}
+
+bool PathQuoteCache::getPaths (
+    Ledger::ref ledger, Request const& request, Paths& paths)
+{
+    auto const key = makeKey (request, true);
+
+    ScopedLockType sl (mLock);
+
+    if (!useLedger (ledger))
+        return false;
+
+    auto it = mPaths.find (key);
+    if (it == mPaths.end ())
+        return false;
+
+    paths = it->second;
+    return true;
+}
+
+void PathQuoteCache::putPaths (
+    Ledger::ref ledger, Request const& request, Paths const& paths)
+{
+    auto const key = makeKey (request, true);
+
+    ScopedLockType sl (mLock);
+
+    if (useLedger (ledger) && (mPaths.size () < PATHFINDER_MAX_CACHED_QUOTES))
+        mPaths.emplace (key, paths);
+}
+
+bool PathQuoteCache::getQuote (
+    Ledger::ref ledger, Request const& request, Json::Value& quote)
+{
+    auto const key = makeKey (request, false);
+
+    ScopedLockType sl (mLock);
+
+    if (!useLedger (ledger))
+        return false;
+
+    auto it = mQuotes.find (key);
+    if (it == mQuotes.end ())
+        return false;
+
+    quote = it->second;
+    return true;
+}
+
+void PathQuoteCache::putQuote (
+    Ledger::ref ledger, Request const& request, Json::Value const& quote)
+{
+    auto const key = makeKey (request, false);
+
+    ScopedLockType sl (mLock);
+
+    if (useLedger (ledger) && (mQuotes.size () < PATHFINDER_MAX_CACHED_QUOTES))
+        mQuotes.emplace (key, quote);
+}
+
+} // truechain
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_APP_PATHS_PATHQUOTECACHE_H_INCLUDED
+#define SKYWELL_APP_PATHS_PATHQUOTECACHE_H_INCLUDED
+
+#include <ledger/Ledger.h>
+#include <protocol/STAmount.h>
+#include <protocol/STPathSet.h>
+#include <common/base/UnorderedContainers.h>
+#include <common/json/json_value.h>
+#include <mutex>
+
+namespace truechain {
+
+/** Results of one-shot path finding, kept for the ledger they were made on.
+
+    Exchanges often ask for the same quote many times while a ledger is
+    current. Two kinds of result are kept:
+    - Paths are found once for each order of magnitude of the amount. Any
+      nearby amount can try them before searching again.
+    - The finished quote for one exact amount is kept as it was returned.
+
+    Only closed ledgers are cached, and only the newest one seen. When a
+    newer ledger comes along, everything is dropped.
+*/
+class PathQuoteCache
+{
+public:
+    /** What was asked for, with the source issue already resolved. */
+    struct Request
+    {
+        Account srcAccount;
+        Account dstAccount;
+        STAmount dstAmount;
+        Issue srcIssue;
+        int searchLevel;
+    };
+
+    /** What the path search came up with. */
+    struct Paths
+    {
+        bool valid;
+        STPathSet paths;
+        STPath fullLiquidityPath;
+    };
+
+    PathQuoteCache ();
+
+    /** Look up the paths found for a similar amount. */
+    bool getPaths (Ledger::ref ledger, Request const& request, Paths& paths);
+
+    void putPaths (Ledger::ref ledger, Request const& request,
+        Paths const& paths);
+
+    /** Look up the quote given for exactly this request.
+        A null quote means no way to pay was found.
+    */
+    bool getQuote (Ledger::ref ledger, Request const& request,
+        Json::Value& quote);
+
+    void putQuote (Ledger::ref ledger, Request const& request,
+        Json::Value const& quote);
+
+private:
+    uint256 makeKey (Request const& request, bool bucket) const;
+
+    // Make the ledger the one being cached if it is newer.
+    // Returns false if results for it can't be kept.
+    bool useLedger (Ledger::ref ledger);
+
+    typedef SkywellMutex LockType;
+    typedef std::lock_guard <LockType> ScopedLockType;
+    LockType mLock;
+
+    LedgerIndex mLedgerSeq;
+    uint256 mLedgerHash;
+
+    hash_map <uint256, Paths> mPaths;
+    hash_map <uint256, Json::Value> mQuotes;
+};
+
+} // truechain
+
+#endif
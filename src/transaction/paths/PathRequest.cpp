@@ -23,6 +23,7 @@
 #include <transaction/paths/SkywellCalc.h>
 #include <transaction/paths/PathRequest.h>
 #include <transaction/paths/PathRequests.h>
+#include <transaction/paths/Tuning.h>
 #include <main/Application.h>
 #include <common/misc/NetworkOPs.h>
 #include <common/base/Log.h>
@@ -47,7 +48,9 @@ PathRequest::PathRequest (
         , jvStatus (Json::objectValue)
         , bValid (false)
         , mLastIndex (0)
+        , mUpdateIndex (0)
         , mInProgress (false)
+        , mDepIndex (0)
         , iLastLevel (0)
         , bLastSuccess (false)
         , iIdentifier (id)
@@ -128,6 +131,7 @@ bool PathRequest::needsUpdate (bool newOnly, LedgerIndex index)
     }
 
     mInProgress = true;
+    mUpdateIndex = index;
     return true;
 }
 
@@ -137,6 +141,72 @@ void PathRequest::updateComplete ()
 
     assert (mInProgress);
     mInProgress = false;
+    mLastIndex = mUpdateIndex;
+}
+
+bool PathRequest::isUnaffected (
+    LiquidityChanges const& changes, LedgerIndex from, LedgerIndex index)
+{
+    ScopedLockType sl (mLock);
+
+    {
+        ScopedLockType il (mIndexLock);
+
+        // The changes must start where the last reply left off
+        if ((mLastIndex == 0) || (mLastIndex != from))
+            return false;
+    }
+
+    // Only a full update records what it depended on
+    if ((mDepIndex == 0) || (index > mDepIndex + PATHFINDER_MAX_REUSED_LEDGERS))
+        return false;
+
+    // A search that is still changing its level has to run again
+    bool const settled = bLastSuccess
+        ? iLastLevel <= getConfig().PATH_SEARCH
+        : iLastLevel >= getConfig().PATH_SEARCH_MAX;
+
+    if (!settled)
+        return false;
+
+    return !changes.affects (mDepAccounts, mDepCurrencies);
+}
+
+void PathRequest::setDependencies (
+    std::set<Issue> const& sourceIssues, LedgerIndex index)
+{
+    mDepAccounts.clear ();
+    mDepCurrencies.clear ();
+
+    mDepAccounts.insert (raSrcAccount.getAccountID ());
+    mDepAccounts.insert (raDstAccount.getAccountID ());
+    mDepCurrencies.insert (saDstAmount.getCurrency ());
+
+    // Auto-bridged paths go through SWT even when no path names it
+    mDepCurrencies.insert (xrpCurrency ());
+
+    for (auto const& issue : sourceIssues)
+        mDepCurrencies.insert (issue.currency);
+
+    for (auto const& context : mContext)
+    {
+        for (auto const& path : context.second)
+        {
+            for (auto const& element : path)
+            {
+                if (element.isAccount ())
+                    mDepAccounts.insert (element.getAccountID ());
+
+                if (element.getNodeType () & STPathElement::typeCurrency)
+                    mDepCurrencies.insert (element.getCurrency ());
+
+                if (element.getNodeType () & STPathElement::typeIssuer)
+                    mDepAccounts.insert (element.getIssuerID ());
+            }
+        }
+    }
+
+    mDepIndex = index;
 }
 
 bool PathRequest::isValid (SkywellLineCache::ref crCache)
@@ -380,7 +450,10 @@ Json::Value PathRequest::doUpdate (SkywellLineCache::ref cache, bool fast)
     ScopedLockType sl (mLock);
 
     if (!isValid (cache))
+    {
+        mDepIndex = 0;
         return jvStatus;
+    }
     jvStatus = Json::objectValue;
 
     auto sourceCurrencies = sciSourceCurrencies;
@@ -546,6 +619,11 @@ Json::Value PathRequest::doUpdate (SkywellLineCache::ref cache, bool fast)
     iLastLevel = iLevel;
     bLastSuccess = found;
 
+    if (fast)
+        mDepIndex = 0;
+    else
+        setDependencies (sourceCurrencies, cache->getLedger ()->getLedgerSeq ());
+
     if (fast && ptQuickReply.is_not_a_date_time())
     {
         ptQuickReply = boost::posix_time::microsec_clock::universal_time();
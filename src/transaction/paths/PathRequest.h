@@ -21,6 +21,7 @@
 #define SKYWELL_APP_PATHS_PATHREQUEST_H_INCLUDED
 
 #include <transaction/paths/SkywellLineCache.h>
+#include <transaction/paths/LiquidityChanges.h>
 #include <common/json/json_value.h>
 #include <services/net/InfoSub.h>
 
@@ -63,6 +64,12 @@ public:
     bool        isNew ();
     bool        needsUpdate (bool newOnly, LedgerIndex index);
     void        updateComplete ();
+
+    /** Return true if the last reply still holds for the ledger at index,
+        given what changed since the ledger after from.
+    */
+    bool        isUnaffected (LiquidityChanges const& changes,
+                    LedgerIndex from, LedgerIndex index);
     Json::Value getStatus ();
 
     Json::Value doCreate (
@@ -81,6 +88,8 @@ private:
     bool isValid (SkywellLineCache::ref crCache);
     void setValid ();
     void resetLevel (int level);
+    void setDependencies (
+        std::set<Issue> const& sourceIssues, LedgerIndex index);
     int parseJson (Json::Value const&, bool complete);
 
     beast::Journal m_journal;
@@ -108,8 +117,15 @@ private:
 
     LockType mIndexLock;
     LedgerIndex mLastIndex;
+    LedgerIndex mUpdateIndex;
     bool mInProgress;
 
+    // The accounts and currencies the paths of the last full update went
+    // through, and the ledger it used
+    hash_set<Account> mDepAccounts;
+    std::set<Currency> mDepCurrencies;
+    LedgerIndex mDepIndex;
+
     int iLastLevel;
     bool bLastSuccess;
 
@@ -22,8 +22,10 @@
 #include <ledger/LedgerMaster.h>
 #include <main/Application.h>
 #include <common/core/JobQueue.h>
+#include <common/core/WorkerPool.h>
 #include <protocol/JsonFields.h>
 #include <network/resource/Fees.h>
+#include <algorithm>
 
 namespace truechain {
 
@@ -38,12 +40,27 @@ SkywellLineCache::pointer PathRequests::getLineCache (Ledger::pointer& ledger, b
     std::uint32_t lgrSeq = ledger->getLedgerSeq();
 
     if ( (lineSeq == 0) ||                                 // no ledger
-         (authoritative && (lgrSeq > lineSeq)) ||          // newer authoritative ledger
          (authoritative && ((lgrSeq + 8)  < lineSeq)) ||   // we jumped way back for some reason
          (lgrSeq > (lineSeq + 8)))                         // we jumped way forward for some reason
     {
         ledger = std::make_shared<Ledger>(*ledger, false); // Take a snapshot of the ledger
         mLineCache = std::make_shared<SkywellLineCache> (ledger);
+        mChanges.reset ();
+    }
+    else if (authoritative && (lgrSeq > lineSeq))          // newer authoritative ledger
+    {
+        // Carry over the lines that the ledgers in between left alone
+        auto changes = getChanges (ledger, lineSeq);
+        ledger = std::make_shared<Ledger>(*ledger, false);
+
+        if (changes)
+            mLineCache = std::make_shared<SkywellLineCache> (
+                ledger, *mLineCache, *changes);
+        else
+            mLineCache = std::make_shared<SkywellLineCache> (ledger);
+
+        mChanges = std::move (changes);
+        mChangesFrom = lineSeq;
     }
     else
     {
@@ -52,6 +69,30 @@ SkywellLineCache::pointer PathRequests::getLineCache (Ledger::pointer& ledger, b
     return mLineCache;
 }
 
+/** Collect what the ledgers after from, up to and including ledger, changed.
+    Returns null if one of them is not available.
+*/
+LiquidityChanges::pointer PathRequests::getChanges (
+    Ledger::ref ledger, LedgerIndex from)
+{
+    // An open ledger has no metadata to learn from
+    if (!ledger->isClosed ())
+        return nullptr;
+
+    auto changes = std::make_shared<LiquidityChanges> ();
+
+    for (auto seq = from + 1; seq < ledger->getLedgerSeq (); ++seq)
+    {
+        auto const between = getApp().getLedgerMaster().getLedgerBySeq (seq);
+        if (!between)
+            return nullptr;
+        changes->addLedger (between);
+    }
+
+    changes->addLedger (ledger);
+    return changes;
+}
+
 void PathRequests::updateAll (Ledger::ref inLedger,
                               Job::CancelCallback shouldCancel)
 {
@@ -62,82 +103,107 @@ void PathRequests::updateAll (Ledger::ref inLedger,
     // Get the ledger and cache we should be using
     Ledger::pointer ledger = inLedger;
     SkywellLineCache::pointer cache;
+    LiquidityChanges::pointer changes;
+    LedgerIndex changesFrom;
     {
         ScopedLockType sl (mLock);
         requests = mRequests;
         cache = getLineCache (ledger, true);
+        changes = mChanges;
+        changesFrom = mChangesFrom;
     }
 
     bool newRequests = getApp().getLedgerMaster().isNewPathRequest();
-    bool mustBreak = false;
+    std::atomic<bool> mustBreak (false);
 
     mJournal.trace << "updateAll seq=" << ledger->getLedgerSeq() << ", " <<
         requests.size() << " requests";
-    int processed = 0, removed = 0;
+    std::atomic<int> processed (0), removed (0), unaffected (0);
 
     do
     {
-        for (auto& wRequest : requests)
+        // Requests still waiting for their first full reply sit at the front
+        // of the list, so the workers reach them before the ones that are
+        // only being refreshed. Each worker takes the next request as soon as
+        // it is free, so one slow search holds up only its own client.
+        std::atomic<std::size_t> next (0);
+
+        auto update = [&] ()
         {
-            if (shouldCancel())
-                break;
+            for (std::size_t i; !mustBreak && ((i = next++) < requests.size ());)
+            {
+                if (shouldCancel())
+                    break;
 
-            bool remove = true;
-            PathRequest::pointer pRequest = wRequest.lock ();
+                auto& wRequest = requests[i];
+                bool remove = true;
+                PathRequest::pointer pRequest = wRequest.lock ();
 
-            if (pRequest)
-            {
-                if (!pRequest->needsUpdate (newRequests, ledger->getLedgerSeq ()))
-                    remove = false;
-                else
+                if (pRequest)
                 {
-                    InfoSub::pointer ipSub = pRequest->getSubscriber ();
-                    if (ipSub)
+                    if (!pRequest->needsUpdate (newRequests, ledger->getLedgerSeq ()))
+                        remove = false;
+                    else if (changes && pRequest->isUnaffected (
+                        *changes, changesFrom, ledger->getLedgerSeq ()))
                     {
-                        ipSub->getConsumer ().charge (Resource::feePathFindUpdate);
-                        if (!ipSub->getConsumer ().warn ())
+                        // Nothing its paths depend on changed; the last reply
+                        // still stands
+                        pRequest->updateComplete ();
+                        remove = false;
+                        ++unaffected;
+                    }
+                    else
+                    {
+                        InfoSub::pointer ipSub = pRequest->getSubscriber ();
+                        if (ipSub)
                         {
-                            Json::Value update = pRequest->doUpdate (cache, false);
-                            pRequest->updateComplete ();
-                            update[jss::type] = "path_find";
-                            ipSub->send (update, false);
-                            remove = false;
-                            ++processed;
+                            ipSub->getConsumer ().charge (Resource::feePathFindUpdate);
+                            if (!ipSub->getConsumer ().warn ())
+                            {
+                                Json::Value update = pRequest->doUpdate (cache, false);
+                                pRequest->updateComplete ();
+                                update[jss::type] = "path_find";
+                                ipSub->send (update, false);
+                                remove = false;
+                                ++processed;
+                            }
                         }
                     }
                 }
-            }
-
-            if (remove)
-            {
-                PathRequest::pointer pRequest = wRequest.lock ();
-
-                ScopedLockType sl (mLock);
 
-                // Remove any dangling weak pointers or weak pointers that refer to this path request.
-                std::vector<PathRequest::wptr>::iterator it = mRequests.begin();
-                while (it != mRequests.end())
+                if (remove)
                 {
-                    PathRequest::pointer itRequest = it->lock ();
-                    if (!itRequest || (itRequest == pRequest))
+                    ScopedLockType sl (mLock);
+
+                    // Remove any dangling weak pointers or weak pointers that refer to this path request.
+                    std::vector<PathRequest::wptr>::iterator it = mRequests.begin();
+                    while (it != mRequests.end())
                     {
-                        ++removed;
-                        it = mRequests.erase (it);
+                        PathRequest::pointer itRequest = it->lock ();
+                        if (!itRequest || (itRequest == pRequest))
+                        {
+                            ++removed;
+                            it = mRequests.erase (it);
+                        }
+                        else
+                            ++it;
                     }
-                    else
-                        ++it;
                 }
-            }
 
-            mustBreak = !newRequests && getApp().getLedgerMaster().isNewPathRequest();
-            if (mustBreak) // We weren't handling new requests and then there was a new request
-                break;
+                // We weren't handling new requests and then there was a new request
+                if (!newRequests && getApp().getLedgerMaster().isNewPathRequest())
+                    mustBreak = true;
+            }
+        };
 
-        }
+        // The workers share the ledger snapshot and the line cache, neither
+        // of which changes during a pass
+        runParallel (parallelThreadCount (requests.size ()), update);
 
         if (mustBreak)
         { // a new request came in while we were working
             newRequests = true;
+            mustBreak = false;
         }
         else if (newRequests)
         { // we only did new requests, so we always need a last pass
@@ -147,7 +213,7 @@ void PathRequests::updateAll (Ledger::ref inLedger,
         { // check if there are any new requests, otherwise we are done
             newRequests = getApp().getLedgerMaster().isNewPathRequest();
             if (!newRequests) // We did a full pass and there are no new requests
-                return;
+                break;
         }
 
         {
@@ -159,13 +225,15 @@ void PathRequests::updateAll (Ledger::ref inLedger,
             requests = mRequests;
 
             cache = getLineCache (ledger, false);
+            changes = mChanges;
+            changesFrom = mChangesFrom;
         }
 
     }
     while (!shouldCancel ());
 
-    mJournal.debug << "updateAll complete " << processed << " process and " <<
-        removed << " removed";
+    mJournal.debug << "updateAll complete " << processed << " process, " <<
+        unaffected << " unaffected and " << removed << " removed";
 }
 
 Json::Value PathRequests::makePathRequest(
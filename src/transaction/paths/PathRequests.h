@@ -21,6 +21,7 @@
 #define SKYWELL_APP_PATHS_PATHREQUESTS_H_INCLUDED
 
 #include <transaction/paths/PathRequest.h>
+#include <transaction/paths/PathQuoteCache.h>
 #include <transaction/paths/SkywellLineCache.h>
 #include <common/core/Job.h>
 #include <atomic>
@@ -32,6 +33,7 @@ class PathRequests
 public:
     PathRequests (beast::Journal journal, beast::insight::Collector::ptr const& collector)
         : mJournal (journal)
+        , mChangesFrom (0)
         , mLastIdentifier (0)
     {
         mFast = collector->make_event ("pathfind_fast");
@@ -49,6 +51,11 @@ public:
         const std::shared_ptr<Ledger>& ledger,
         Json::Value const& request);
 
+    PathQuoteCache& getQuoteCache ()
+    {
+        return mQuotes;
+    }
+
     void reportFast (int milliseconds)
     {
         mFast.notify (static_cast < beast::insight::Event::value_type> (milliseconds));
@@ -60,6 +67,9 @@ public:
     }
 
 private:
+    LiquidityChanges::pointer getChanges (
+        Ledger::ref ledger, LedgerIndex from);
+
     beast::Journal                   mJournal;
 
     beast::insight::Event            mFast;
@@ -71,6 +81,14 @@ private:
     // Use a SkywellLineCache
     SkywellLineCache::pointer         mLineCache;
 
+    // What changed between the ledger of the previous cache and the current
+    // one, or null if the cache was built from scratch
+    LiquidityChanges::pointer        mChanges;
+    LedgerIndex                      mChangesFrom;
+
+    // Answers to one-shot path finding for the newest closed ledger
+    PathQuoteCache                   mQuotes;
+
     std::atomic<int>                 mLastIdentifier;
 
     typedef SkywellRecursiveMutex     LockType;
@@ -718,29 +718,26 @@ int Pathfinder::getPathsOut (
     {
         count = getApp ().getOrderBookDB ().getBookSize (issue);
 
-        for (auto const& item : mRLCache->getSkywellLines (account))
+        for (auto const& line : mRLCache->getSkywellLines (account))
         {
-            SkywellState* rspEntry = (SkywellState*) item.get ();
-
-            if (currency != rspEntry->getLimit ().getCurrency ())
+            if (currency != line.getCurrency ())
             {
             }
-            else if (rspEntry->getBalance () <= zero &&
-                     (!rspEntry->getLimitPeer ()
-                      || -rspEntry->getBalance () >= rspEntry->getLimitPeer ()
-                      ||  (bAuthRequired && !rspEntry->getAuth ())))
+            else if (!line.hasPositiveBalance () &&
+                     (!line.canSend ()
+                      ||  (bAuthRequired && !line.getAuth ())))
             {
             }
             else if (isDstCurrency &&
-                     dstAccount == rspEntry->getAccountIDPeer ())
+                     dstAccount == line.getAccountIDPeer ())
             {
                 count += 10000; // count a path to the destination extra
             }
-            else if (rspEntry->getNoSkywellPeer ())
+            else if (line.getNoSkywellPeer ())
             {
                 // This probably isn't a useful path out
             }
-            else if (rspEntry->getFreezePeer ())
+            else if (line.getFreezePeer ())
             {
                 // Not a useful path out
             }
@@ -936,16 +933,9 @@ void Pathfinder::addLink (
                 AccountCandidates candidates;
                 candidates.reserve (truechainLines.size ());
 
-                for (auto const& item : truechainLines)
+                for (auto const& line : truechainLines)
                 {
-                    auto* rs = dynamic_cast<SkywellState const *> (item.get ());
-                    if (!rs)
-                    {
-                        WriteLog (lsERROR, Pathfinder)
-                                << "Couldn't decipher SkywellState";
-                        continue;
-                    }
-                    auto const& acct = rs->getAccountIDPeer ();
+                    auto const& acct = line.getAccountIDPeer ();
 
                     if (hasEffectiveDestination && (acct == mDstAccount))
                     {
@@ -960,18 +950,17 @@ void Pathfinder::addLink (
                         continue;
                     }
 
-                    if ((uEndCurrency == rs->getLimit ().getCurrency ()) &&
+                    if ((uEndCurrency == line.getCurrency ()) &&
                         !currentPath.hasSeen (acct, uEndCurrency, acct))
                     {
                         // path is for correct currency and has not been seen
-                        if (rs->getBalance () <= zero
-                            && (!rs->getLimitPeer ()
-                                || -rs->getBalance () >= rs->getLimitPeer ()
-                                || (bRequireAuth && !rs->getAuth ())))
+                        if (!line.hasPositiveBalance ()
+                            && (!line.canSend ()
+                                || (bRequireAuth && !line.getAuth ())))
                         {
                             // path has no credit
                         }
-                        else if (bIsNoSkywellOut && rs->getNoSkywell ())
+                        else if (bIsNoSkywellOut && line.getNoSkywell ())
                         {
                             // Can't leave on this path
                         }
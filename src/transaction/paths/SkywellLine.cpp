@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/paths/SkywellLine.h>
+
+namespace truechain {
+
+SkywellLine::SkywellLine (Account const& accountID, STLedgerEntry const& sle)
+    : mAccount (accountID)
+{
+    STAmount const& lowLimit = sle.getFieldAmount (sfLowLimit);
+    STAmount const& highLimit = sle.getFieldAmount (sfHighLimit);
+
+    bool const viewLowest = (lowLimit.getIssuer () == accountID);
+
+    STAmount balance = sle.getFieldAmount (sfBalance);
+    if (!viewLowest)
+        balance.negate ();
+
+    STAmount const& limit = viewLowest ? lowLimit : highLimit;
+    STAmount const& limitPeer = viewLowest ? highLimit : lowLimit;
+
+    mPeer = limitPeer.getIssuer ();
+    mCurrency = limit.getCurrency ();
+
+    mBalanceMantissa = balance.mantissa ();
+    mBalanceExponent = balance.exponent ();
+    mLimitMantissa = limit.mantissa ();
+    mLimitExponent = limit.exponent ();
+    mLimitPeerMantissa = limitPeer.mantissa ();
+    mLimitPeerExponent = limitPeer.exponent ();
+
+    std::uint32_t const flags = sle.getFieldU32 (sfFlags);
+    auto const side = [&] (LedgerSpecificFlags low, LedgerSpecificFlags high,
+        bool ours)
+    {
+        return (flags & ((viewLowest == ours) ? low : high)) != 0;
+    };
+
+    mFlags = 0;
+    if (side (lsfLowAuth, lsfHighAuth, true))
+        mFlags |= lfAuth;
+    if (side (lsfLowAuth, lsfHighAuth, false))
+        mFlags |= lfAuthPeer;
+    if (side (lsfLowNoSkywell, lsfHighNoSkywell, true))
+        mFlags |= lfNoSkywell;
+    if (side (lsfLowNoSkywell, lsfHighNoSkywell, false))
+        mFlags |= lfNoSkywellPeer;
+    if (side (lsfLowFreeze, lsfHighFreeze, true))
+        mFlags |= lfFreeze;
+    if (side (lsfLowFreeze, lsfHighFreeze, false))
+        mFlags |= lfFreezePeer;
+
+    if (balance > zero)
+        mFlags |= lfPositive;
+    if ((balance > zero) || (limitPeer && ((-balance) < limitPeer)))
+        mFlags |= lfCanSend;
+    if (balance < limit)
+        mFlags |= lfCanReceive;
+
+    if (balance.negative ())
+        mFlags |= lfBalanceNegative;
+    if (limit.negative ())
+        mFlags |= lfLimitNegative;
+    if (limitPeer.negative ())
+        mFlags |= lfLimitPeerNegative;
+
+    if (viewLowest)
+    {
+        mQualityIn = sle.getFieldU32 (sfLowQualityIn);
+        mQualityOut = sle.getFieldU32 (sfLowQualityOut);
+    }
+    else
+    {
+        mQualityIn = sle.getFieldU32 (sfHighQualityIn);
+        mQualityOut = sle.getFieldU32 (sfHighQualityOut);
+    }
+}
+
+STAmount SkywellLine::makeAmount (Account const& issuer,
+    std::uint64_t mantissa, std::int8_t exponent, bool negative) const
+{
+    return STAmount (sfGeneric, Issue (mCurrency, issuer),
+        mantissa, exponent, false, negative, STAmount::unchecked ());
+}
+
+STAmount SkywellLine::getBalance () const
+{
+    return makeAmount (noAccount (), mBalanceMantissa, mBalanceExponent,
+        mFlags & lfBalanceNegative);
+}
+
+STAmount SkywellLine::getLimit () const
+{
+    return makeAmount (mAccount, mLimitMantissa, mLimitExponent,
+        mFlags & lfLimitNegative);
+}
+
+STAmount SkywellLine::getLimitPeer () const
+{
+    return makeAmount (mPeer, mLimitPeerMantissa, mLimitPeerExponent,
+        mFlags & lfLimitPeerNegative);
+}
+
+} // truechain
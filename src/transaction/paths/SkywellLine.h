@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_APP_PATHS_SKYWELLLINE_H_INCLUDED
+#define SKYWELL_APP_PATHS_SKYWELLLINE_H_INCLUDED
+
+#include <protocol/STAmount.h>
+#include <protocol/STLedgerEntry.h>
+#include <cstdint>
+
+namespace truechain {
+
+/** A trust line as seen from one of its two accounts.
+
+    Unlike SkywellState this is a plain value: it copies out the handful of
+    fields path finding looks at instead of holding on to the ledger entry,
+    so an account's lines can sit next to each other in one array.
+*/
+class SkywellLine
+{
+public:
+    SkywellLine (Account const& accountID, STLedgerEntry const& sle);
+
+    Account const& getAccountID () const
+    {
+        return mAccount;
+    }
+
+    Account const& getAccountIDPeer () const
+    {
+        return mPeer;
+    }
+
+    Currency const& getCurrency () const
+    {
+        return mCurrency;
+    }
+
+    bool getAuth () const
+    {
+        return mFlags & lfAuth;
+    }
+
+    bool getAuthPeer () const
+    {
+        return mFlags & lfAuthPeer;
+    }
+
+    bool getNoSkywell () const
+    {
+        return mFlags & lfNoSkywell;
+    }
+
+    bool getNoSkywellPeer () const
+    {
+        return mFlags & lfNoSkywellPeer;
+    }
+
+    /** Have we set the freeze flag on our peer */
+    bool getFreeze () const
+    {
+        return mFlags & lfFreeze;
+    }
+
+    /** Has the peer set the freeze flag on us */
+    bool getFreezePeer () const
+    {
+        return mFlags & lfFreezePeer;
+    }
+
+    /** The peer owes us. */
+    bool hasPositiveBalance () const
+    {
+        return mFlags & lfPositive;
+    }
+
+    /** We can send on this line: we hold a balance, or the peer extends
+        credit we have not used up.
+    */
+    bool canSend () const
+    {
+        return mFlags & lfCanSend;
+    }
+
+    /** We can take more: our balance is below our limit. */
+    bool canReceive () const
+    {
+        return mFlags & lfCanReceive;
+    }
+
+    std::uint32_t getQualityIn () const
+    {
+        return mQualityIn;
+    }
+
+    std::uint32_t getQualityOut () const
+    {
+        return mQualityOut;
+    }
+
+    STAmount getBalance () const;
+    STAmount getLimit () const;
+    STAmount getLimitPeer () const;
+
+private:
+    enum
+    {
+        lfAuth          = 0x0001,
+        lfAuthPeer      = 0x0002,
+        lfNoSkywell     = 0x0004,
+        lfNoSkywellPeer = 0x0008,
+        lfFreeze        = 0x0010,
+        lfFreezePeer    = 0x0020,
+        lfPositive      = 0x0040,
+        lfCanSend       = 0x0080,
+        lfCanReceive    = 0x0100,
+
+        // Where the sign of each amount is kept
+        lfBalanceNegative   = 0x0200,
+        lfLimitNegative     = 0x0400,
+        lfLimitPeerNegative = 0x0800
+    };
+
+    STAmount makeAmount (Account const& issuer, std::uint64_t mantissa,
+        std::int8_t exponent, bool negative) const;
+
+    Account         mAccount;
+    Account         mPeer;
+    Currency        mCurrency;
+
+    std::uint64_t   mBalanceMantissa;
+    std::uint64_t   mLimitMantissa;
+    std::uint64_t   mLimitPeerMantissa;
+
+    std::uint32_t   mQualityIn;
+    std::uint32_t   mQualityOut;
+
+    std::int8_t     mBalanceExponent;
+    std::int8_t     mLimitExponent;
+    std::int8_t     mLimitPeerExponent;
+
+    std::uint16_t   mFlags;
+};
+
+} // truechain
+
+#endif
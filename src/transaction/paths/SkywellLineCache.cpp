@@ -27,19 +27,53 @@ SkywellLineCache::SkywellLineCache (Ledger::ref l)
 {
 }
 
-SkywellLineCache::SkywellStateVector const&
+SkywellLineCache::SkywellLineCache (Ledger::ref l,
+        SkywellLineCache& previous, LiquidityChanges const& changes)
+    : mLedger (l)
+{
+    ScopedLockType sl (previous.mLock);
+
+    // Keys carry their hash, so keep the hasher that made them
+    hasher_ = previous.hasher_;
+    mRLMap.reserve (previous.mRLMap.size ());
+
+    for (auto const& entry : previous.mRLMap)
+    {
+        if (!changes.hasChangedLines (entry.first.account_))
+            mRLMap.emplace (entry);
+    }
+}
+
+SkywellLineCache::SkywellLines const&
 SkywellLineCache::getSkywellLines (Account const& accountID)
 {
     AccountKey key (accountID, hasher_ (accountID));
 
-    ScopedLockType sl (mLock);
+    {
+        ScopedLockType sl (mLock);
+
+        auto it = mRLMap.find (key);
+        if (it != mRLMap.end ())
+            return *it->second;
+    }
+
+    // Walk the owner directory without holding the lock, so that other
+    // threads can read the lines already cached meanwhile
+    auto lines = std::make_shared <SkywellLines> ();
 
-    auto it = mRLMap.emplace (key, SkywellStateVector ());
+    mLedger->visitAccountItems (accountID,
+        [&lines, &accountID](SLE::ref sle)
+        {
+            if (sle && (sle->getType () == ltSKYWELL_STATE))
+                lines->emplace_back (accountID, *sle);
+        });
 
-    if (it.second)
-        it.first->second = truechain::getSkywellStateItems (accountID, mLedger);
+    lines->shrink_to_fit ();
+
+    ScopedLockType sl (mLock);
 
-    return it.first->second;
+    // If another thread got here first, use what it found
+    return *mRLMap.emplace (key, std::move (lines)).first->second;
 }
 
 } // truechain
@@ -20,7 +20,9 @@
 #ifndef SKYWELL_APP_PATHS_SKYWELLLINECACHE_H_INCLUDED
 #define SKYWELL_APP_PATHS_SKYWELLLINECACHE_H_INCLUDED
 
-#include <transaction/paths/SkywellState.h>
+#include <transaction/paths/SkywellLine.h>
+#include <ledger/Ledger.h>
+#include <transaction/paths/LiquidityChanges.h>
 #include <common/base/hardened_hash.h>
 #include <cstddef>
 #include <memory>
@@ -29,21 +31,30 @@
 namespace truechain {
 
 // Used by Pathfinder
+//
+// Each account's lines are read from the ledger the first time they are
+// asked for and kept as one flat array that is never changed afterwards.
 class SkywellLineCache
 {
 public:
-    typedef std::vector <SkywellState::pointer> SkywellStateVector;
+    typedef std::vector <SkywellLine> SkywellLines;
     typedef std::shared_ptr <SkywellLineCache> pointer;
     typedef pointer const& ref;
 
     explicit SkywellLineCache (Ledger::ref l);
 
+    /** Start from the lines cached for an earlier ledger, dropping the
+        accounts whose trust lines changed since.
+    */
+    SkywellLineCache (Ledger::ref l, SkywellLineCache& previous,
+        LiquidityChanges const& changes);
+
     Ledger::ref getLedger () //  TODO const?
     {
         return mLedger;
     }
 
-    std::vector<SkywellState::pointer> const&
+    SkywellLines const&
     getSkywellLines (Account const& accountID);
 
 private:
@@ -90,7 +101,9 @@ private:
         };
     };
 
-    hash_map <AccountKey, SkywellStateVector, AccountKey::Hash> mRLMap;
+    // Shared with the caches built from this one
+    hash_map <AccountKey, std::shared_ptr <SkywellLines const>,
+        AccountKey::Hash> mRLMap;
 };
 
 } // truechain
@@ -30,6 +30,13 @@ int const PATHFINDER_MAX_PATHS = 50;
 int const PATHFINDER_MAX_COMPLETE_PATHS = 1000;
 int const PATHFINDER_MAX_PATHS_FROM_SOURCE = 10;
 
+// The most ledgers a path request keeps its reply without searching again,
+// even when nothing its paths go through changed
+int const PATHFINDER_MAX_REUSED_LEDGERS = 10;
+
+// The most path sets and the most quotes kept for one ledger
+int const PATHFINDER_MAX_CACHED_QUOTES = 4096;
+
 } // truechain
 
 #endif
@@ -191,7 +191,7 @@ void truechainLiquidity (
 
         if (saPrvAct > saCurAct)
         {
-            Account const feeAccount(truechainCalc.mActiveLedger.getLedger()->getFeeAccountID());
+            Account const feeAccount(truechainCalc.mActiveLedger.getFeeAccountID());
             Account const issuerAccount(saPrvAct.getIssuer());
             Currency const currency(saPrvAct.getCurrency());
             if (feeAccount == issuerAccount)
@@ -52,6 +52,11 @@ public:
                 "Malformed transaction: Invalid flags set.";
            return temINVALID_FLAG;
        }
+
+       // Sets the source and fee accounts checked below
+       TER const terResult = Transactor::preCheck ();
+       if (terResult != tesSUCCESS)
+           return terResult;
    
        Account const uDstAccountID (mTxn.getFieldAccount160 (sfDestination));
        if (!uDstAccountID)
@@ -87,7 +92,13 @@ public:
           return temDST_IS_SRC;
        }
 
-       std::uint32_t const current_count(mTxnAccount->getFieldU32(sfOwnerCount));
+       // apply only reads the account root after preCheck
+       SLE::pointer const sleSrc (mEngine->view ().entryCache (
+           ltACCOUNT_ROOT, getAccountRootIndex (mTxnAccountID)));
+       if (!sleSrc)
+           return terNO_ACCOUNT;
+
+       std::uint32_t const current_count(sleSrc->getFieldU32(sfOwnerCount));
        if (current_count != 0)
        {
            m_journal.warning <<"Malformed transaction: "
@@ -95,7 +106,7 @@ public:
            return terOWNERS;
        }
 
-       return Transactor::preCheck ();
+       return tesSUCCESS;
     }
 
 
@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/transactors/Transactor.h>
+#include <common/base/Log.h>
+#include <protocol/Indexes.h>
+#include <protocol/TxFlags.h>
+
+namespace truechain {
+
+class CancelOffer
+    : public Transactor
+{
+public:
+    CancelOffer (
+        STTx const& txn,
+        TransactionEngineParams params,
+        TransactionEngine* engine)
+        : Transactor (
+            txn,
+            params,
+            engine,
+            deprecatedLogs().journal("CancelOffer"))
+    {
+
+    }
+
+    TER doApply () override
+    {
+        std::uint32_t const uOfferSequence = mTxn.getFieldU32 (sfOfferSequence);
+        std::uint32_t const uAccountSequenceNext = mTxnAccount->getFieldU32 (sfSequence);
+
+        m_journal.debug << "uAccountSequenceNext=" << uAccountSequenceNext <<
+            " uOfferSequence=" << uOfferSequence;
+
+        std::uint32_t const uTxFlags (mTxn.getFlags ());
+
+        if (uTxFlags & tfUniversalMask)
+        {
+            m_journal.trace << "Malformed transaction: " <<
+                "Invalid flags set.";
+            return temINVALID_FLAG;
+        }
+
+        if (!uOfferSequence || uAccountSequenceNext - 1 <= uOfferSequence)
+        {
+            m_journal.trace << "uAccountSequenceNext=" << uAccountSequenceNext <<
+                " uOfferSequence=" << uOfferSequence;
+            return temBAD_SEQUENCE;
+        }
+
+        uint256 const offerIndex (getOfferIndex (mTxnAccountID, uOfferSequence));
+
+        SLE::pointer sleOffer (mEngine->view ().entryCache (ltOFFER,
+            offerIndex));
+
+        if (sleOffer)
+        {
+            m_journal.debug << "Trying to cancel offer #" << uOfferSequence;
+            return mEngine->view ().offerDelete (sleOffer);
+        }
+
+        // It's not an error to cancel an offer that was already consumed or
+        // removed.
+        m_journal.debug << "Offer #" << uOfferSequence << " can't be found.";
+        return tesSUCCESS;
+    }
+};
+
+TER
+transact_CancelOffer (
+    STTx const& txn,
+    TransactionEngineParams params,
+    TransactionEngine* engine)
+{
+#if SKYWELL_ENABLE_OFFERS
+    return CancelOffer (txn, params, engine).apply ();
+#else
+    return temDISABLED;
+#endif
+}
+
+}
@@ -0,0 +1,955 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/book/OfferStream.h>
+#include <transaction/book/Taker.h>
+#include <transaction/transactors/Transactor.h>
+#include <common/base/Log.h>
+#include <protocol/Indexes.h>
+#include <protocol/TxFlags.h>
+#include <beast/cxx14/memory.h>
+#include <stdexcept>
+
+namespace truechain {
+
+class CreateOffer
+    : public Transactor
+{
+private:
+    // What kind of offer we are placing
+    core::CrossType cross_type_;
+
+    /** Determine if we are authorized to hold the asset we want to get */
+    TER
+    checkAcceptAsset (IssueRef issue) const
+    {
+        // Only valid for custom currencies
+        assert (!isSWT (issue.currency));
+
+        SLE::pointer const issuerAccount = mEngine->view ().entryCache (
+            ltACCOUNT_ROOT, getAccountRootIndex (issue.account));
+
+        if (!issuerAccount)
+        {
+            if (m_journal.warning) m_journal.warning <<
+                "delay: can't receive IOUs from non-existent issuer: " <<
+                to_string (issue.account);
+
+            return (mParams & tapRETRY) ? terNO_ACCOUNT : tecNO_ISSUER;
+        }
+
+        if (issuerAccount->getFieldU32 (sfFlags) & lsfRequireAuth)
+        {
+            SLE::pointer const trustLine = mEngine->view ().entryCache (
+                ltSKYWELL_STATE, getSkywellStateIndex (
+                    mTxnAccountID, issue.account, issue.currency));
+
+            if (!trustLine)
+                return (mParams & tapRETRY) ? terNO_LINE : tecNO_LINE;
+
+            // Entries have a canonical representation, determined by a
+            // lexicographical "greater than" comparison employing strict
+            // weak ordering. Determine which entry we need to access.
+            bool const canonical_gt (mTxnAccountID > issue.account);
+
+            bool const is_authorized (trustLine->getFieldU32 (sfFlags) &
+                (canonical_gt ? lsfLowAuth : lsfHighAuth));
+
+            if (!is_authorized)
+            {
+                if (m_journal.debug) m_journal.debug <<
+                    "delay: can't receive IOUs from issuer without auth.";
+
+                return (mParams & tapRETRY) ? terNO_AUTH : tecNO_AUTH;
+            }
+        }
+
+        return tesSUCCESS;
+    }
+
+    bool
+    dry_offer (core::LedgerView& view, core::Offer const& offer)
+    {
+        if (offer.fully_consumed ())
+            return true;
+
+        auto const funds (view.accountFunds (offer.owner (),
+            offer.amount ().out, fhZERO_IF_FROZEN));
+
+        return (funds <= zero);
+    }
+
+    static
+    std::pair<bool, core::Quality>
+    select_path (
+        bool have_direct, core::OfferStream const& direct,
+        bool have_bridge, core::OfferStream const& leg1,
+        core::OfferStream const& leg2)
+    {
+        // If we don't have any viable path, why are we here?!
+        assert (have_direct || have_bridge);
+
+        // If there's no bridged path, the direct is the best by default.
+        if (!have_bridge)
+            return std::make_pair (true, direct.tip ().quality ());
+
+        core::Quality const bridged_quality (core::composed_quality (
+            leg1.tip ().quality (), leg2.tip ().quality ()));
+
+        if (have_direct)
+        {
+            // We compare the quality of the composed quality of the bridged
+            // offers and compare it against the direct offer to pick the best.
+            core::Quality const direct_quality (direct.tip ().quality ());
+
+            if (bridged_quality < direct_quality)
+                return std::make_pair (true, direct_quality);
+        }
+
+        // Either there was no direct offer, or it didn't have a better quality
+        // than the bridge.
+        return std::make_pair (false, bridged_quality);
+    }
+
+    // Step through the stream for as long as possible, skipping any offers
+    // that are from the taker or which cross the taker's threshold.
+    // Return false if the is no offer in the book, true otherwise.
+    static
+    bool
+    step_account (core::OfferStream& stream, core::Taker const& taker)
+    {
+        while (stream.step ())
+        {
+            auto const& offer = stream.tip ();
+
+            // This offer at the tip crosses the taker's threshold. We're done.
+            if (taker.reject (offer.quality ()))
+                return true;
+
+            // This offer at the tip is not from the taker. We're done.
+            if (offer.owner () != taker.account ())
+                return true;
+        }
+
+        // We ran out of offers. Can't advance.
+        return false;
+    }
+
+    // The quality of the best directory in the book, if it has one.
+    static
+    bool
+    best_quality (core::LedgerView& view, Book const& book,
+        core::Quality& quality)
+    {
+        uint256 const base (getBookBase (book));
+        uint256 const dir (view.getNextLedgerIndex (base, getQualityNext (base)));
+
+        if (dir.isZero ())
+            return false;
+
+        quality = core::Quality (getQuality (dir));
+        return true;
+    }
+
+    // Returns true if no offer in the books could cross ours.
+    //
+    // Most offers placed into a busy book sit behind the best price and take
+    // nothing. Looking at the first directory of each book they could cross
+    // spares them setting up the taker and walking the books with it. The
+    // first directory is never worse than the first funded offer, so this
+    // can only miss offers that would have been rejected anyway. The offer
+    // streams still have to be stepped; see step_streams.
+    bool
+    cannot_cross (core::LedgerView& view, core::Amounts const& taker_amount)
+    {
+        core::Quality threshold (taker_amount);
+
+        if (mTxn.getFlags () & tfPassive)
+            ++threshold;
+
+        Issue const& in = taker_amount.in.issue ();
+        Issue const& out = taker_amount.out.issue ();
+
+        core::Quality direct;
+        if (best_quality (view, Book (in, out), direct) &&
+            !(direct < threshold))
+        {
+            return false;
+        }
+
+        if (cross_type_ == core::CrossType::IouToIou)
+        {
+            core::Quality leg1;
+            core::Quality leg2;
+
+            if (best_quality (view, Book (in, xrpIssue ()), leg1) &&
+                best_quality (view, Book (xrpIssue (), out), leg2) &&
+                !(core::composed_quality (leg1, leg2) < threshold))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Crossing steps the stream of each book it could use onto that book's
+    // first usable offer, removing the expired and unfunded offers before
+    // it. When nothing can cross, that offer is where crossing stops, so
+    // stepping each stream once leaves the same ledger behind.
+    void
+    step_streams (
+        core::LedgerView& view,
+        core::LedgerView& view_cancel,
+        core::Amounts const& taker_amount,
+        core::Clock::time_point const when)
+    {
+        Issue const& in = taker_amount.in.issue ();
+        Issue const& out = taker_amount.out.issue ();
+
+        if (cross_type_ == core::CrossType::IouToIou)
+        {
+            core::OfferStream offers_leg1 (view, view_cancel,
+                Book (in, xrpIssue ()), when, m_journal);
+
+            core::OfferStream offers_leg2 (view, view_cancel,
+                Book (xrpIssue (), out), when, m_journal);
+
+            if (offers_leg1.step ())
+                offers_leg2.step ();
+        }
+
+        core::OfferStream offers_direct (view, view_cancel,
+            Book (in, out), when, m_journal);
+
+        offers_direct.step ();
+    }
+
+    std::pair<TER, core::Amounts>
+    bridged_cross (
+        core::Taker& taker,
+        core::LedgerView& view,
+        core::LedgerView& view_cancel,
+        core::Clock::time_point const when)
+    {
+        auto const& taker_amount = taker.original_offer ();
+
+        assert (!isSWT (taker_amount.in) && !isSWT (taker_amount.out));
+
+        if (isSWT (taker_amount.in) || isSWT (taker_amount.out))
+            throw std::logic_error ("Bridging with SWT and an endpoint.");
+
+        core::OfferStream offers_direct (view, view_cancel,
+            Book (taker.issue_in (), taker.issue_out ()), when, m_journal);
+
+        core::OfferStream offers_leg1 (view, view_cancel,
+            Book (taker.issue_in (), xrpIssue ()), when, m_journal);
+
+        core::OfferStream offers_leg2 (view, view_cancel,
+            Book (xrpIssue (), taker.issue_out ()), when, m_journal);
+
+        TER cross_result = tesSUCCESS;
+
+        // Note the subtle distinction here: self-offers encountered in the
+        // bridge are taken, but self-offers encountered in the direct book
+        // are not.
+        bool have_bridge = offers_leg1.step () && offers_leg2.step ();
+        bool have_direct = step_account (offers_direct, taker);
+        int count = 0;
+
+        // Modifying the order or logic of the operations in the loop will cause
+        // a protocol breaking change.
+        while (have_direct || have_bridge)
+        {
+            bool leg1_consumed = false;
+            bool leg2_consumed = false;
+            bool direct_consumed = false;
+
+            core::Quality quality;
+            bool use_direct;
+
+            std::tie (use_direct, quality) = select_path (
+                have_direct, offers_direct,
+                have_bridge, offers_leg1, offers_leg2);
+
+            // We are always looking at the best quality; we are done with
+            // crossing as soon as we cross the quality boundary.
+            if (taker.reject(quality))
+                break;
+
+            count++;
+
+            if (use_direct)
+            {
+                if (m_journal.debug)
+                {
+                    m_journal.debug << count << " Direct:";
+                    m_journal.debug << "  offer: " << offers_direct.tip ();
+                    m_journal.debug << "     in: " << offers_direct.tip ().amount().in;
+                    m_journal.debug << "    out: " << offers_direct.tip ().amount ().out;
+                    m_journal.debug << "  owner: " << offers_direct.tip ().owner ();
+                }
+
+                cross_result = taker.cross (offers_direct.tip ());
+
+                m_journal.debug << "Direct Result: " << transToken (cross_result);
+
+                if (dry_offer (view, offers_direct.tip ()))
+                {
+                    direct_consumed = true;
+                    have_direct = step_account (offers_direct, taker);
+                }
+            }
+            else
+            {
+                if (m_journal.debug)
+                {
+                    auto const owner1_funds_before = view.accountFunds (
+                        offers_leg1.tip ().owner (),
+                        offers_leg1.tip ().amount ().out,
+                        fhIGNORE_FREEZE);
+
+                    auto const owner2_funds_before = view.accountFunds (
+                        offers_leg2.tip ().owner (),
+                        offers_leg2.tip ().amount ().out,
+                        fhIGNORE_FREEZE);
+
+                    m_journal.debug << count << " Bridge:";
+                    m_journal.debug << " offer1: " << offers_leg1.tip ();
+                    m_journal.debug << "     in: " << offers_leg1.tip ().amount().in;
+                    m_journal.debug << "    out: " << offers_leg1.tip ().amount ().out;
+                    m_journal.debug << "  owner: " << offers_leg1.tip ().owner ();
+                    m_journal.debug << "  funds: " << owner1_funds_before;
+                    m_journal.debug << " offer2: " << offers_leg2.tip ();
+                    m_journal.debug << "     in: " << offers_leg2.tip ().amount ().in;
+                    m_journal.debug << "    out: " << offers_leg2.tip ().amount ().out;
+                    m_journal.debug << "  owner: " << offers_leg2.tip ().owner ();
+                    m_journal.debug << "  funds: " << owner2_funds_before;
+                }
+
+                cross_result = taker.cross (offers_leg1.tip (), offers_leg2.tip ());
+
+                m_journal.debug << "Bridge Result: " << transToken (cross_result);
+
+                if (dry_offer (view, offers_leg1.tip ()))
+                {
+                    leg1_consumed = true;
+                    have_bridge = (have_bridge && offers_leg1.step ());
+                }
+                if (dry_offer (view, offers_leg2.tip ()))
+                {
+                    leg2_consumed = true;
+                    have_bridge = (have_bridge && offers_leg2.step ());
+                }
+            }
+
+            if (cross_result != tesSUCCESS)
+            {
+                cross_result = tecFAILED_PROCESSING;
+                break;
+            }
+
+            if (taker.done())
+            {
+                m_journal.debug << "The taker reports he's done during crossing!";
+                break;
+            }
+
+            // Postcondition: If we aren't done, then we *must* have consumed at
+            //                least one offer fully.
+            assert (direct_consumed || leg1_consumed || leg2_consumed);
+
+            if (!direct_consumed && !leg1_consumed && !leg2_consumed)
+                throw std::logic_error ("bridged crossing: nothing was fully consumed.");
+        }
+
+        return std::make_pair(cross_result, taker.remaining_offer ());
+    }
+
+    std::pair<TER, core::Amounts>
+    direct_cross (
+        core::Taker& taker,
+        core::LedgerView& view,
+        core::LedgerView& view_cancel,
+        core::Clock::time_point const when)
+    {
+        core::OfferStream offers (
+            view, view_cancel,
+            Book (taker.issue_in (), taker.issue_out ()),
+            when, m_journal);
+
+        TER cross_result (tesSUCCESS);
+        int count = 0;
+
+        bool have_offer = step_account (offers, taker);
+
+        // Modifying the order or logic of the operations in the loop will cause
+        // a protocol breaking change.
+        while (have_offer)
+        {
+            bool direct_consumed = false;
+            auto const& offer (offers.tip());
+
+            // We are done with crossing as soon as we cross the quality boundary
+            if (taker.reject (offer.quality()))
+                break;
+
+            count++;
+
+            if (m_journal.debug)
+            {
+                m_journal.debug << count << " Direct:";
+                m_journal.debug << "  offer: " << offer;
+                m_journal.debug << "     in: " << offer.amount ().in;
+                m_journal.debug << "    out: " << offer.amount ().out;
+                m_journal.debug << "  owner: " << offer.owner ();
+            }
+
+            cross_result = taker.cross (offer);
+
+            m_journal.debug << "Direct Result: " << transToken (cross_result);
+
+            if (dry_offer (view, offer))
+            {
+                direct_consumed = true;
+                have_offer = step_account (offers, taker);
+            }
+
+            if (cross_result != tesSUCCESS)
+            {
+                cross_result = tecFAILED_PROCESSING;
+                break;
+            }
+
+            if (taker.done())
+            {
+                m_journal.debug << "The taker reports he's done during crossing!";
+                break;
+            }
+
+            // Postcondition: If we aren't done, then we *must* have consumed the
+            //                offer on the books fully!
+            assert (direct_consumed);
+
+            if (!direct_consumed)
+                throw std::logic_error ("direct crossing: nothing was fully consumed.");
+        }
+
+        return std::make_pair(cross_result, taker.remaining_offer ());
+    }
+
+    // Fill offer as much as possible by consuming offers already on the books,
+    // and adjusting account balances accordingly.
+    //
+    // Charges fees on top to taker.
+    std::pair<TER, core::Amounts>
+    cross (
+        core::LedgerView& view,
+        core::LedgerView& cancel_view,
+        core::Amounts const& taker_amount)
+    {
+        core::Clock::time_point const when (
+            mEngine->getLedger ()->getParentCloseTimeNC ());
+
+        if (cannot_cross (view, taker_amount))
+        {
+            step_streams (view, cancel_view, taker_amount, when);
+            return std::make_pair (tesSUCCESS, taker_amount);
+        }
+
+        core::Taker taker (cross_type_, view, mTxnAccountID, taker_amount,
+            mTxn.getFlags());
+
+        try
+        {
+            if (cross_type_ == core::CrossType::IouToIou)
+                return bridged_cross (taker, view, cancel_view, when);
+
+            return direct_cross (taker, view, cancel_view, when);
+        }
+        catch (std::logic_error const& e)
+        {
+            m_journal.error << "Exception during offer crossing: " << e.what ();
+            return std::make_pair (tecINTERNAL, taker.remaining_offer ());
+        }
+    }
+
+public:
+    CreateOffer (
+        STTx const& txn,
+        TransactionEngineParams params,
+        TransactionEngine* engine)
+        : Transactor (
+            txn,
+            params,
+            engine,
+            deprecatedLogs().journal("CreateOffer"))
+        , cross_type_ (core::CrossType::IouToIou)
+    {
+        bool const pays_xrp = txn.getFieldAmount (sfTakerPays).isNative ();
+        bool const gets_xrp = txn.getFieldAmount (sfTakerGets).isNative ();
+
+        if (pays_xrp && !gets_xrp)
+            cross_type_ = core::CrossType::IouToXrp;
+        else if (gets_xrp && !pays_xrp)
+            cross_type_ = core::CrossType::XrpToIou;
+    }
+
+    TER
+    doApply () override
+    {
+        std::uint32_t const uTxFlags = mTxn.getFlags ();
+
+        bool const bPassive (uTxFlags & tfPassive);
+        bool const bImmediateOrCancel (uTxFlags & tfImmediateOrCancel);
+        bool const bFillOrKill (uTxFlags & tfFillOrKill);
+        bool const bSell (uTxFlags & tfSell);
+
+        STAmount saTakerPays = mTxn.getFieldAmount (sfTakerPays);
+        STAmount saTakerGets = mTxn.getFieldAmount (sfTakerGets);
+
+        if (!isLegalNet (saTakerPays) || !isLegalNet (saTakerGets))
+            return temBAD_AMOUNT;
+
+        auto const& uPaysIssuerID = saTakerPays.getIssuer ();
+        auto const& uPaysCurrency = saTakerPays.getCurrency ();
+
+        auto const& uGetsIssuerID = saTakerGets.getIssuer ();
+        auto const& uGetsCurrency = saTakerGets.getCurrency ();
+
+        bool const bHaveExpiration (mTxn.isFieldPresent (sfExpiration));
+        bool const bHaveCancel (mTxn.isFieldPresent (sfOfferSequence));
+
+        std::uint32_t const uExpiration = mTxn.getFieldU32 (sfExpiration);
+        std::uint32_t const uCancelSequence = mTxn.getFieldU32 (sfOfferSequence);
+
+        // The sequence of this transaction, which the account root has
+        // already moved past
+        std::uint32_t const uAccountSequenceNext = mTxnAccount->getFieldU32 (sfSequence);
+        std::uint32_t const uSequence = mTxn.getSequence ();
+
+        if (m_journal.debug)
+        {
+            m_journal.debug <<
+                "Creating offer node: " << to_string (getOfferIndex (
+                    mTxnAccountID, uSequence)) <<
+                " OfferSequence=" << uSequence;
+
+            if (uTxFlags & tfPassive)
+                m_journal.debug << "Passive: " << saTakerGets;
+            if (bImmediateOrCancel)
+                m_journal.debug << "Immediate or Cancel";
+            if (bFillOrKill)
+                m_journal.debug << "Fill or Kill";
+            if (bSell)
+                m_journal.debug << "Sell";
+        }
+
+        // This is the original rate of this offer, and is the rate at which it
+        // will be placed, even if crossing offers change the amounts.
+        std::uint64_t const uRate = getRate (saTakerGets, saTakerPays);
+
+        TER terResult (tesSUCCESS);
+
+        // This is the ledger view that we work against. Transactions are
+        // applied as we go on processing transactions.
+        core::LedgerView& view (mEngine->view ());
+
+        // This is a checkpoint with just the fees paid. If something goes
+        // wrong with this transaction, we roll back to this ledger.
+        core::LedgerView view_checkpoint (view.duplicate ());
+
+        view.bumpSeq (); // Begin ledger variance.
+
+        SLE::pointer sleCreator = view.entryCache (
+            ltACCOUNT_ROOT, getAccountRootIndex (mTxnAccountID));
+
+        if (uTxFlags & tfOfferCreateMask)
+        {
+            m_journal.debug <<
+                "Malformed transaction: Invalid flags set.";
+
+            terResult = temINVALID_FLAG;
+        }
+        else if (bImmediateOrCancel && bFillOrKill)
+        {
+            m_journal.debug <<
+                "Malformed transaction: both IoC and FoK set.";
+
+            terResult = temINVALID_FLAG;
+        }
+        else if (bHaveExpiration && !uExpiration)
+        {
+            m_journal.warning <<
+                "Malformed offer: bad expiration";
+
+            terResult = temBAD_EXPIRATION;
+        }
+        else if (saTakerPays.isNative () && saTakerGets.isNative ())
+        {
+            m_journal.warning <<
+                "Malformed offer: SWT for SWT";
+
+            terResult = temBAD_OFFER;
+        }
+        else if (saTakerPays <= zero || saTakerGets <= zero)
+        {
+            m_journal.warning <<
+                "Malformed offer: bad amount";
+
+            terResult = temBAD_OFFER;
+        }
+        else if (uPaysCurrency == uGetsCurrency && uPaysIssuerID == uGetsIssuerID)
+        {
+            m_journal.warning <<
+                "Malformed offer: redundant offer";
+
+            terResult = temREDUNDANT;
+        }
+        // We don't allow a non-native currency to use the currency code SWT.
+        else if (badCurrency() == uPaysCurrency || badCurrency() == uGetsCurrency)
+        {
+            m_journal.warning <<
+                "Malformed offer: Bad currency.";
+
+            terResult = temBAD_CURRENCY;
+        }
+        else if (saTakerPays.isNative () != !uPaysIssuerID ||
+                 saTakerGets.isNative () != !uGetsIssuerID)
+        {
+            m_journal.warning <<
+                "Malformed offer: bad issuer";
+
+            terResult = temBAD_ISSUER;
+        }
+        else if (view.isGlobalFrozen (uPaysIssuerID) ||
+                 view.isGlobalFrozen (uGetsIssuerID))
+        {
+            m_journal.warning <<
+                "Offer involves frozen asset";
+
+            terResult = tecFROZEN;
+        }
+        else if (view.accountFunds (
+            mTxnAccountID, saTakerGets, fhZERO_IF_FROZEN) <= zero)
+        {
+            m_journal.warning <<
+                "delay: Offers must be at least partially funded.";
+
+            terResult = tecUNFUNDED_OFFER;
+        }
+        // This can probably be simplified to make sure that you cancel sequences
+        // before the transaction sequence number.
+        else if (bHaveCancel && (!uCancelSequence || uAccountSequenceNext - 1 <= uCancelSequence))
+        {
+            m_journal.debug <<
+                "uAccountSequenceNext=" << uAccountSequenceNext <<
+                " uOfferSequence=" << uCancelSequence;
+
+            terResult = temBAD_SEQUENCE;
+        }
+
+        if (terResult != tesSUCCESS)
+        {
+            m_journal.debug << "final terResult=" << transToken (terResult);
+            return terResult;
+        }
+
+        // Process a cancellation request that's passed along with an offer.
+        if (bHaveCancel)
+        {
+            uint256 const uCancelIndex (
+                getOfferIndex (mTxnAccountID, uCancelSequence));
+            SLE::pointer sleCancel = view.entryCache (ltOFFER, uCancelIndex);
+
+            // It's not an error to not find the offer to cancel: it might have
+            // been consumed or removed as we are processing.
+            if (sleCancel)
+            {
+                m_journal.debug << "Create cancels order " << uCancelSequence;
+                terResult = view.offerDelete (sleCancel);
+            }
+        }
+
+        // Expiration is defined in terms of the close time of the parent ledger,
+        // because we definitively know the time that it closed but we do not
+        // know the closing time of the ledger that is under construction.
+        if (bHaveExpiration &&
+            (mEngine->getLedger ()->getParentCloseTimeNC () >= uExpiration))
+        {
+            return tesSUCCESS;
+        }
+
+        // Make sure that we are authorized to hold what the taker will pay us.
+        if (terResult == tesSUCCESS && !saTakerPays.isNative ())
+            terResult = checkAcceptAsset (Issue (uPaysCurrency, uPaysIssuerID));
+
+        bool crossed = false;
+        bool const bOpenLedger (mParams & tapOPEN_LEDGER);
+
+        if (terResult == tesSUCCESS)
+        {
+            // We reverse gets and pays because during offer crossing we are taking.
+            core::Amounts const taker_amount (saTakerGets, saTakerPays);
+
+            // The amount of the offer that we will need to place, after we finish
+            // offer crossing processing.
+            core::Amounts place_offer;
+
+            std::tie(terResult, place_offer) = cross (
+                view, view_checkpoint, taker_amount);
+
+            if (terResult == tecFAILED_PROCESSING && bOpenLedger)
+                terResult = telFAILED_PROCESSING;
+
+            if (terResult == tesSUCCESS)
+            {
+                // We now need to reduce the offer by the cross flow. We reverse
+                // in and out here, since during crossing we were takers.
+                assert (saTakerPays.getCurrency () == place_offer.out.getCurrency ());
+                assert (saTakerPays.getIssuer () == place_offer.out.getIssuer ());
+                assert (saTakerGets.getCurrency () == place_offer.in.getCurrency ());
+                assert (saTakerGets.getIssuer () == place_offer.in.getIssuer ());
+
+                if (taker_amount != place_offer)
+                    crossed = true;
+
+                if (m_journal.debug)
+                {
+                    m_journal.debug << "Offer Crossing: " << transToken (terResult);
+
+                    if (terResult == tesSUCCESS)
+                    {
+                        m_journal.debug <<
+                            "    takerPays: " << saTakerPays.getFullText () <<
+                            " -> " << place_offer.out.getFullText ();
+                        m_journal.debug <<
+                            "    takerGets: " << saTakerGets.getFullText () <<
+                            " -> " << place_offer.in.getFullText ();
+                    }
+                }
+
+                saTakerPays = place_offer.out;
+                saTakerGets = place_offer.in;
+            }
+        }
+
+        if (terResult != tesSUCCESS)
+        {
+            m_journal.debug << "final terResult=" << transToken (terResult);
+            return terResult;
+        }
+
+        if (m_journal.debug)
+        {
+            m_journal.debug <<
+                "takeOffers: saTakerPays=" << saTakerPays.getFullText ();
+            m_journal.debug <<
+                "takeOffers: saTakerGets=" << saTakerGets.getFullText ();
+            m_journal.debug <<
+                "takeOffers: mTxnAccountID=" << to_string (mTxnAccountID);
+            m_journal.debug <<
+                "takeOffers:         FUNDS=" << view.accountFunds (
+                    mTxnAccountID, saTakerGets, fhZERO_IF_FROZEN).getFullText ();
+        }
+
+        if (saTakerPays < zero || saTakerGets < zero)
+        {
+            // Earlier, we verified that the amounts, as specified in the offer,
+            // were not negative. That they are now suggests that something went
+            // very wrong with offer crossing.
+            m_journal.fatal << (crossed ? "Partially consumed" : "Full") <<
+                " offer has negative component:" <<
+                " pays=" << saTakerPays.getFullText () <<
+                " gets=" << saTakerGets.getFullText ();
+
+            assert (saTakerPays >= zero);
+            assert (saTakerGets >= zero);
+            return tefINTERNAL;
+        }
+
+        // If the offer had fully crossed, we're done
+        if (saTakerPays == zero || saTakerGets == zero)
+            return tesSUCCESS;
+
+        if (bFillOrKill)
+        {
+            // Fill or kill and have leftovers: undo everything but the fee
+            view.swapWith (view_checkpoint);
+            return tesSUCCESS;
+        }
+
+        // Immediate or cancel: what was taken stays taken, the rest is not
+        // placed
+        if (bImmediateOrCancel)
+            return tesSUCCESS;
+
+        // This is the "deferred" reserve check: the account doesn't need to
+        // keep the reserve for an offer that crossed fully.
+        {
+            std::uint64_t const uReserve = mEngine->getLedger ()->getReserve (
+                sleCreator->getFieldU32 (sfOwnerCount) + 1);
+
+            if (getNValue (mPriorBalance) < uReserve)
+            {
+                // If we are here, the signing account had an insufficient
+                // reserve *prior* to our processing. We use the prior balance
+                // to simplify client writing and make the user experience
+                // better.
+
+                if (bOpenLedger) // Ledger is not final, can vote no.
+                {
+                    // Hope for more reserve to come in or more offers to
+                    // consume. If we specified a local error this transaction
+                    // will not be retried, so specify a tec to distribute the
+                    // transaction and allow it to be retried. In particular,
+                    // it may have been successful to a degree (partially
+                    // filled) and if it hasn't, it might succeed.
+                    terResult = tecINSUF_RESERVE_OFFER;
+                }
+                else if (!crossed)
+                {
+                    // Ledger is final, insufficent reserve to create offer,
+                    // processed nothing.
+                    terResult = tecINSUF_RESERVE_OFFER;
+                }
+                else
+                {
+                    // Ledger is final, insufficent reserve to create offer,
+                    // processed something.
+
+                    // Consider the offer unfunded. Treat as tesSUCCESS.
+                    terResult = tesSUCCESS;
+                }
+
+                return terResult;
+            }
+        }
+
+        // We need to place the remainder of the offer into its order book.
+        auto const offer_index (getOfferIndex (mTxnAccountID, uSequence));
+
+        std::uint64_t uOwnerNode;
+        std::uint64_t uBookNode;
+        uint256 uDirectory;
+
+        // Add offer to owner's directory.
+        terResult = view.dirAdd (uOwnerNode,
+            getOwnerDirIndex (mTxnAccountID), offer_index,
+            std::bind (
+                &Ledger::ownerDirDescriber, std::placeholders::_1,
+                std::placeholders::_2, mTxnAccountID));
+
+        if (terResult == tesSUCCESS)
+        {
+            // Update owner count.
+            view.incrementOwnerCount (sleCreator);
+
+            uint256 const uBookBase (getBookBase (
+                {{uPaysCurrency, uPaysIssuerID},
+                    {uGetsCurrency, uGetsIssuerID}}));
+
+            if (m_journal.debug) m_journal.debug <<
+                "adding to book: " << to_string (uBookBase) <<
+                " : " << saTakerPays.getHumanCurrency () <<
+                "/" << to_string (saTakerPays.getIssuer ()) <<
+                " -> " << saTakerGets.getHumanCurrency () <<
+                "/" << to_string (saTakerGets.getIssuer ());
+
+            // We use the original rate to place the offer.
+            uDirectory = getQualityIndex (uBookBase, uRate);
+
+            // Add offer to order book.
+            terResult = view.dirAdd (uBookNode, uDirectory, offer_index,
+                std::bind (
+                    &Ledger::qualityDirDescriber, std::placeholders::_1,
+                    std::placeholders::_2, saTakerPays.getCurrency (),
+                    uPaysIssuerID, saTakerGets.getCurrency (),
+                    uGetsIssuerID, uRate));
+        }
+
+        if (terResult == tesSUCCESS)
+        {
+            if (m_journal.debug)
+            {
+                m_journal.debug <<
+                    "sfAccount=" << to_string (mTxnAccountID);
+                m_journal.debug <<
+                    "uPaysIssuerID=" << to_string (uPaysIssuerID);
+                m_journal.debug <<
+                    "uGetsIssuerID=" << to_string (uGetsIssuerID);
+                m_journal.debug <<
+                    "saTakerPays.isNative()=" << saTakerPays.isNative ();
+                m_journal.debug <<
+                    "saTakerGets.isNative()=" << saTakerGets.isNative ();
+                m_journal.debug <<
+                    "uPaysCurrency=" << saTakerPays.getHumanCurrency ();
+                m_journal.debug <<
+                    "uGetsCurrency=" << saTakerGets.getHumanCurrency ();
+            }
+
+            SLE::pointer sleOffer (view.entryCreate (ltOFFER, offer_index));
+
+            sleOffer->setFieldAccount (sfAccount, mTxnAccountID);
+            sleOffer->setFieldU32 (sfSequence, uSequence);
+            sleOffer->setFieldH256 (sfBookDirectory, uDirectory);
+            sleOffer->setFieldAmount (sfTakerPays, saTakerPays);
+            sleOffer->setFieldAmount (sfTakerGets, saTakerGets);
+            sleOffer->setFieldU64 (sfOwnerNode, uOwnerNode);
+            sleOffer->setFieldU64 (sfBookNode, uBookNode);
+
+            if (uExpiration)
+                sleOffer->setFieldU32 (sfExpiration, uExpiration);
+
+            if (bPassive)
+                sleOffer->setFlag (lsfPassive);
+
+            if (bSell)
+                sleOffer->setFlag (lsfSell);
+
+            if (m_journal.debug) m_journal.debug <<
+                "final terResult=" << transToken (terResult) <<
+                " sleOffer=" << sleOffer->getText ();
+        }
+
+        if (terResult != tesSUCCESS)
+        {
+            m_journal.debug <<
+                "final terResult=" << transToken (terResult);
+        }
+
+        return terResult;
+    }
+};
+
+TER
+transact_CreateOffer (
+    STTx const& txn,
+    TransactionEngineParams params,
+    TransactionEngine* engine)
+{
+#if SKYWELL_ENABLE_OFFERS
+    return CreateOffer (txn, params, engine).apply ();
+#else
+    return temDISABLED;
+#endif
+}
+
+}
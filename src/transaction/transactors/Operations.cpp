@@ -20,11 +20,15 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 #include <BeastConfig.h>
 #include <transaction/transactors/Operations.h>
 #include <common/core/Config.h>
+#include <common/core/WorkerPool.h>
 #include <transaction/transactors/Transactor.h>
 // #include <skywell/legacy/0.27/Emulate027.h>
 #include <protocol/Indexes.h>
 #include <main/Application.h>
 #include <ledger/LedgerMaster.h>
+#include <beast/cxx14/memory.h>
+#include <algorithm>
+#include <atomic>
 
 namespace truechain {
 
@@ -36,21 +40,43 @@ namespace truechain {
 
     }
 
-	TER Operations::precheckSig(STTx txn, TransactionEngineParams& params)
+	TER Operations::precheckSig(STTx const& txn, TransactionEngineParams& params)
+	{
+		Account const account = txn.getSourceAccount().getAccountID();
+
+		auto it = mAuthorized.find(account);
+		if (it == mAuthorized.end())
+		{
+			Authorization auth;
+			auth.master = false;
+			auth.result = checkAuthorization(account, auth.master);
+			it = mAuthorized.emplace(account, auth).first;
+		}
+
+		if (it->second.master)
+			params = static_cast<TransactionEngineParams> (params | tapMASTER_SIGN);
+
+		return it->second.result;
+	}
+
+	TER Operations::checkAuthorization(Account const& mTxnAccountID, bool& master)
 	{
 		
 		std::set<Account>::const_iterator it = mSigners.end();
-		Account mTxnAccountID = txn.getSourceAccount().getAccountID();
 		it = mSigners.find(mTxnAccountID);
 		auto mTxnAccount = mEngine->view().entryCache(ltACCOUNT_ROOT,
 			getAccountRootIndex(mTxnAccountID));
+
+		// Merged earlier in the batch, or never created
+		if (!mTxnAccount)
+			return terNO_ACCOUNT;
 		
 		if (it != mSigners.end())
 		{
 			if (mTxnAccount->isFlag(lsfDisableMaster))
 				return tefMASTER_DISABLED;
 
-			params = static_cast<TransactionEngineParams> (params | tapMASTER_SIGN);
+			master = true;
 			return tesSUCCESS;
 
 		} 
@@ -105,6 +131,61 @@ namespace truechain {
 		return tefBAD_AUTH;
 	}
 
+    void Operations::loadSTTxs()
+    {
+        enum
+        {
+            // Building an inner transaction is cheap; only hand out work in
+            // chunks big enough to pay for waking a thread.
+            minimumPerThread = 64
+        };
+
+        if (mTxn.getTxnType() != ttOPERATION)
+        {
+            mTxn.getSTTxs(mSTTxs);
+            return;
+        }
+
+        STArray const& operations = mTxn.getFieldArray(sfOperations);
+        std::size_t const count = operations.size();
+
+        // Each slot is filled by exactly one worker, so the workers only
+        // share the index of the next operation and the failure flag.
+        std::vector<std::unique_ptr<STTx>> txs(count);
+        std::atomic<std::size_t> next(0);
+        std::atomic<bool> failed(false);
+
+        auto build = [&]()
+        {
+            for (std::size_t i = next++; i < count && !failed; i = next++)
+            {
+                try
+                {
+                    STObject object(operations[i]);
+                    txs[i] = std::make_unique<STTx>(std::move(object));
+                }
+                catch (...)
+                {
+                    failed = true;
+                }
+            }
+        };
+
+        runParallel(parallelThreadCount(count, minimumPerThread), build);
+
+        if (failed)
+        {
+            WriteLog(lsWARNING, STTx) <<
+                "Transaction not legal for format";
+
+            throw std::runtime_error("invalid transaction type");
+        }
+
+        mSTTxs.reserve(count);
+        for (auto& tx : txs)
+            mSTTxs.push_back(std::move(*tx));
+    }
+
     TER Operations::doApply()
     {
        // bool const mBatchOperation = mTxn.getTxnType() == ttOPERATION ? true : false;
@@ -113,7 +194,7 @@ namespace truechain {
         try
         {
             mTxn.getSignAccount(mSigners);
-            mTxn.getSTTxs(mSTTxs);
+            loadSTTxs();
             if (mSTTxs.size() == 0)
             {
                 m_journal.warning << "transaction is empty";
@@ -143,6 +224,20 @@ namespace truechain {
             }
             if (!isTesSuccess(terResult))
                 break;
+
+            // These can change who may sign for an account, so later
+            // operations must look again.
+            switch (sttx.getTxnType())
+            {
+            case ttACCOUNT_SET:
+            case ttREGULAR_KEY_SET:
+            case ttSIGN_SET:
+            case ttACCOUNT_MERGE:
+                mAuthorized.clear();
+                break;
+            default:
+                break;
+            }
         }
         return terResult;
     }
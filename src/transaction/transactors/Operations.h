@@ -23,6 +23,7 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 #include <transaction/tx/TransactionEngine.h>
 #include <common/base/Log.h>
 #include <transaction/transactors/Transactor.h>
+#include <map>
 
 namespace truechain {
 
@@ -42,10 +43,25 @@ namespace truechain {
 
         TER doApply();
     private:
-		TER precheckSig(STTx txn, TransactionEngineParams &params);
+        // The outcome of checking one inner transaction account against the
+        // batch signers; it only depends on that account's root and signer
+        // list, so it is shared by every operation on the same account.
+        struct Authorization
+        {
+            TER result;
+            bool master;
+        };
+
+		TER precheckSig(STTx const& txn, TransactionEngineParams &params);
+        TER checkAuthorization(Account const& account, bool& master);
+
+        // Build the inner transactions of the batch, on several threads
+        // when it is large.
+        void loadSTTxs();
 
 		std::vector<STTx> mSTTxs;
 		std::set<Account> mSigners;
+        std::map<Account, Authorization> mAuthorized;
 
     };
 
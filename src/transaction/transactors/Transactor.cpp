@@ -36,6 +36,8 @@ TER transact_SetREL(STTx const& txn, TransactionEngineParams params, Transaction
 TER transact_Change(STTx const& txn, TransactionEngineParams params, TransactionEngine* engine);
 TER transact_CreateTicket(STTx const& txn, TransactionEngineParams params, TransactionEngine* engine);
 TER transact_CancelTicket(STTx const& txn, TransactionEngineParams params, TransactionEngine* engine);
+TER transact_CreateOffer(STTx const& txn, TransactionEngineParams params, TransactionEngine* engine);
+TER transact_CancelOffer(STTx const& txn, TransactionEngineParams params, TransactionEngine* engine);
 TER transact_Manage(STTx const& txn, TransactionEngineParams params, TransactionEngine* engine);
 TER transact_AccountMerge(STTx const& txn, TransactionEngineParams params, TransactionEngine* engine);
 TER transact_SetSign(STTx const& txn, TransactionEngineParams params, TransactionEngine* engine);
@@ -79,6 +81,12 @@ TransactionEngine* engine)
     case ttTICKET_CANCEL:
         return transact_CancelTicket(txn, params, engine);
 
+    case ttOFFER_CREATE:
+        return transact_CreateOffer(txn, params, engine);
+
+    case ttOFFER_CANCEL:
+        return transact_CancelOffer(txn, params, engine);
+
 	case ttNICKNAME_SET:
 		return  transact_SetNickName(txn, params, engine);
 
@@ -0,0 +1,344 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/tx/TransactionEngine.h>
+#include <transaction/tx/tests/TestLedger.h>
+#include <ledger/LedgerEntrySet.h>
+#include <protocol/Indexes.h>
+#include <beast/unit_test/suite.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace truechain {
+
+#if SKYWELL_ENABLE_OFFERS
+
+// Helpers for placing offers in a book of USD against SWT
+namespace {
+
+typedef test::TestAccount TestAccount;
+
+STAmount
+swt (std::uint64_t amount)
+{
+    return STAmount (amount * SYSTEM_CURRENCY_PARTS);
+}
+
+STTx::pointer
+trust (TestAccount& from, STAmount const& limit)
+{
+    auto txn = test::createTx (ttTRUST_SET, from);
+    txn->setFieldAmount (sfLimitAmount, limit);
+    return test::sign (txn, from);
+}
+
+STTx::pointer
+offer (TestAccount& from, STAmount const& takerPays, STAmount const& takerGets)
+{
+    auto txn = test::createTx (ttOFFER_CREATE, from);
+    txn->setFieldAmount (sfTakerPays, takerPays);
+    txn->setFieldAmount (sfTakerGets, takerGets);
+    return test::sign (txn, from);
+}
+
+STTx::pointer
+cancel (TestAccount& from, std::uint32_t sequence)
+{
+    auto txn = test::createTx (ttOFFER_CANCEL, from);
+    txn->setFieldU32 (sfOfferSequence, sequence);
+    return test::sign (txn, from);
+}
+
+}
+
+class CreateOffer_test : public beast::unit_test::suite
+{
+public:
+    TER
+    apply (TransactionEngine& engine, STTx::pointer const& txn)
+    {
+        return engine.applyTransaction (*txn, tapNO_CHECK_SIGN).first;
+    }
+
+    void
+    expectResult (TER result, TER expected, std::string const& what)
+    {
+        expect (result == expected, what + ": " + transToken (result) +
+            ", expected " + transToken (expected));
+    }
+
+    bool
+    hasOffer (Ledger::ref ledger, TestAccount const& owner,
+        std::uint32_t sequence)
+    {
+        return bool (ledger->getSLEi (getOfferIndex (
+            owner.publicKey.getAccountID (), sequence)));
+    }
+
+    STAmount
+    holds (Ledger::ref ledger, TestAccount const& owner, Issue const& issue)
+    {
+        LedgerEntrySet les (ledger, tapNONE);
+        return les.accountHolds (owner.publicKey.getAccountID (),
+            issue.currency, issue.account, fhIGNORE_FREEZE);
+    }
+
+    void
+    run ()
+    {
+        test::TestLedger testLedger;
+        Ledger::ref ledger = testLedger.open ();
+        TestAccount& master = testLedger.master ();
+        TransactionEngine engine (ledger);
+
+        TestAccount gateway = test::createAccount ("gateway");
+        TestAccount alice = test::createAccount ("alice");
+        TestAccount bob = test::createAccount ("bob");
+        TestAccount carol = test::createAccount ("carol");
+        TestAccount dave = test::createAccount ("dave");
+
+        Issue const usd (to_currency ("USD"),
+            gateway.publicKey.getAccountID ());
+
+        for (auto const* account : { &testLedger.feeAccount (), &gateway,
+            &alice, &bob, &carol, &dave })
+        {
+            expectResult (apply (engine,
+                test::pay (master, *account, swt (10000))),
+                    tesSUCCESS, "funding");
+        }
+
+        for (auto* account : { &alice, &bob, &carol, &dave })
+        {
+            expectResult (apply (engine,
+                trust (*account, STAmount (usd, 1000000))),
+                    tesSUCCESS, "trust line");
+        }
+
+        for (auto const* account : { &alice, &carol })
+        {
+            expectResult (apply (engine,
+                test::pay (gateway, *account, STAmount (usd, 100))),
+                    tesSUCCESS, "issuing");
+        }
+
+        // alice sells 100 USD for 300 SWT
+        std::uint32_t const aliceOffer = alice.sequence;
+        expectResult (apply (engine,
+            offer (alice, swt (300), STAmount (usd, 100))),
+                tesSUCCESS, "alice's offer");
+
+        testcase ("cannot cross");
+        {
+            // bob pays less than alice asks, so his offer only rests
+            std::uint32_t const bobOffer = bob.sequence;
+            expectResult (apply (engine,
+                offer (bob, STAmount (usd, 100), swt (100))),
+                    tesSUCCESS, "bob's offer");
+
+            expect (hasOffer (ledger, alice, aliceOffer), "alice's offer taken");
+            expect (hasOffer (ledger, bob, bobOffer), "bob's offer not placed");
+            expect (holds (ledger, bob, usd) == zero, "bob was paid");
+
+            testcase ("cancel");
+
+            expectResult (apply (engine, cancel (bob, bobOffer)),
+                tesSUCCESS, "cancel");
+            expect (!hasOffer (ledger, bob, bobOffer), "bob's offer remains");
+            expect (ledger->getAccountRoot (bob.publicKey)->getFieldU32 (
+                sfOwnerCount) == 1, "bob's owner count");
+
+            // Cancelling an offer that is already gone is not an error
+            expectResult (apply (engine, cancel (bob, bobOffer)),
+                tesSUCCESS, "second cancel");
+        }
+
+        testcase ("stale tip");
+        {
+            // carol asks less than alice, putting her offer at the front of
+            // the book, then gives her USD back so it is unfunded
+            std::uint32_t const carolOffer = carol.sequence;
+            expectResult (apply (engine,
+                offer (carol, swt (200), STAmount (usd, 100))),
+                    tesSUCCESS, "carol's offer");
+            expectResult (apply (engine,
+                test::pay (carol, gateway, STAmount (usd, 100))),
+                    tesSUCCESS, "carol's refund");
+            expect (hasOffer (ledger, carol, carolOffer),
+                "carol's offer was removed early");
+
+            // bob's offer crosses neither, but still clears carol's from the
+            // book as crossing would have
+            std::uint32_t const bobOffer = bob.sequence;
+            expectResult (apply (engine,
+                offer (bob, STAmount (usd, 100), swt (100))),
+                    tesSUCCESS, "bob's offer");
+
+            expect (!hasOffer (ledger, carol, carolOffer),
+                "carol's unfunded offer remains");
+            expect (hasOffer (ledger, alice, aliceOffer),
+                "alice's funded offer was removed");
+            expect (hasOffer (ledger, bob, bobOffer), "bob's offer not placed");
+
+            expectResult (apply (engine, cancel (bob, bobOffer)),
+                tesSUCCESS, "cancel");
+        }
+
+        testcase ("cross");
+        {
+            // dave pays what alice asks, taking her whole offer
+            std::uint32_t const daveOffer = dave.sequence;
+            expectResult (apply (engine,
+                offer (dave, STAmount (usd, 100), swt (300))),
+                    tesSUCCESS, "dave's offer");
+
+            expect (!hasOffer (ledger, alice, aliceOffer),
+                "alice's offer remains");
+            expect (!hasOffer (ledger, dave, daveOffer),
+                "dave's offer was placed");
+            expect (holds (ledger, dave, usd) == STAmount (usd, 100),
+                "dave's USD");
+            expect (holds (ledger, alice, usd) == zero, "alice's USD");
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CreateOffer,tx,truechain);
+
+//------------------------------------------------------------------------------
+
+// Times placing offers that rest in the book, and offers that take them
+class CreateOfferSpeed_test : public beast::unit_test::suite
+{
+public:
+    typedef std::chrono::high_resolution_clock clock_type;
+
+    enum
+    {
+        accountCount = 16,
+        offerCount = 5000
+    };
+
+    void
+    report (std::string const& what, std::size_t count,
+        clock_type::time_point start)
+    {
+        double const seconds = std::chrono::duration <double> (
+            clock_type::now () - start).count ();
+
+        log << what << ": " << std::to_string (count) << " offers in " <<
+            seconds << "s, " << static_cast<std::size_t> (count / seconds) <<
+                " per second";
+    }
+
+    void
+    run ()
+    {
+        test::TestLedger testLedger;
+        TestAccount& master = testLedger.master ();
+        TransactionEngine engine (testLedger.open ());
+
+        TestAccount gateway = test::createAccount ("gateway");
+        Issue const usd (to_currency ("USD"),
+            gateway.publicKey.getAccountID ());
+
+        std::vector<TestAccount> makers;
+        std::vector<TestAccount> takers;
+
+        engine.applyTransaction (*test::pay (master, testLedger.feeAccount (),
+            swt (1000)), tapNO_CHECK_SIGN);
+        engine.applyTransaction (*test::pay (master, gateway, swt (1000)),
+            tapNO_CHECK_SIGN);
+
+        for (int i = 0; i < accountCount; ++i)
+        {
+            makers.push_back (
+                test::createAccount ("maker" + std::to_string (i)));
+            takers.push_back (
+                test::createAccount ("taker" + std::to_string (i)));
+
+            for (auto* account : { &makers.back (), &takers.back () })
+            {
+                engine.applyTransaction (*test::pay (master, *account,
+                    swt (1000000)), tapNO_CHECK_SIGN);
+                engine.applyTransaction (*trust (*account,
+                    STAmount (usd, 1000000000)), tapNO_CHECK_SIGN);
+            }
+
+            engine.applyTransaction (*test::pay (gateway, makers.back (),
+                STAmount (usd, 1000000)), tapNO_CHECK_SIGN);
+        }
+
+        // Makers sell USD at 2 to 3 SWT each, spread over many qualities
+        std::vector<STTx::pointer> asks;
+        std::vector<STTx::pointer> bids;
+        std::vector<STTx::pointer> takes;
+
+        for (int i = 0; i < offerCount; ++i)
+        {
+            asks.push_back (offer (makers[i % accountCount],
+                swt (200 + i % 100), STAmount (usd, 100)));
+        }
+
+        // Sequences are taken as the offers are made, so each set is made
+        // in the order it is applied
+        for (int i = 0; i < offerCount; ++i)
+        {
+            bids.push_back (offer (takers[i % accountCount],
+                STAmount (usd, 100), swt (100)));
+        }
+
+        // Takers pay up to 3 SWT each, taking one ask apiece
+        for (int i = 0; i < offerCount; ++i)
+        {
+            takes.push_back (offer (takers[i % accountCount],
+                STAmount (usd, 100), swt (300)));
+        }
+
+        auto place = [&](std::string const& what,
+            std::vector<STTx::pointer> const& txns)
+        {
+            std::size_t failed = 0;
+            auto const start = clock_type::now ();
+
+            for (auto const& txn : txns)
+            {
+                if (engine.applyTransaction (
+                        *txn, tapNO_CHECK_SIGN).first != tesSUCCESS)
+                    ++failed;
+            }
+
+            report (what, txns.size (), start);
+            expect (failed == 0, what + ": " + std::to_string (failed) +
+                " failed");
+        };
+
+        place ("resting asks", asks);
+        place ("bids that cannot cross", bids);
+        place ("bids that cross", takes);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(CreateOfferSpeed,tx,truechain);
+
+#endif
+
+} // truechain
@@ -0,0 +1,318 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/tx/TransactionEngine.h>
+#include <transaction/tx/tests/TestLedger.h>
+#include <protocol/STArray.h>
+#include <protocol/TxFlags.h>
+#include <beast/unit_test/suite.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace truechain {
+
+// Helpers for building batch operations
+namespace {
+
+typedef test::TestAccount TestAccount;
+
+// An inner transaction. The batch is checked and charged as a whole, so
+// inner sequences are not used and the account's own is left alone.
+STTx::pointer
+createOp (TxType type, TestAccount const& from)
+{
+    TestAccount copy = from;
+    return test::createTx (type, copy);
+}
+
+STTx::pointer
+payOp (TestAccount const& from, TestAccount const& to, STAmount const& amount)
+{
+    auto op = createOp (ttPAYMENT, from);
+    op->setFieldAccount (sfDestination, to.publicKey);
+    op->setFieldAmount (sfAmount, amount);
+    return op;
+}
+
+STTx::pointer
+regularKeyOp (TestAccount const& from, TestAccount const& key)
+{
+    auto op = createOp (ttREGULAR_KEY_SET, from);
+    op->setFieldAccount (sfRegularKey, key.publicKey);
+    return op;
+}
+
+STTx::pointer
+disableMasterOp (TestAccount const& from)
+{
+    auto op = createOp (ttACCOUNT_SET, from);
+    op->setFieldU32 (sfSetFlag, asfDisableMaster);
+    return op;
+}
+
+// A signer list that one signature from the signer satisfies
+STTx::pointer
+signSetOp (TestAccount const& from, TestAccount const& signer)
+{
+    STObject entry (sfSignerEntry);
+    entry.setFieldAccount (sfAccount, signer.publicKey);
+    entry.setFieldU16 (sfWeight, 1);
+
+    STArray entries (sfSignerEntries);
+    entries.push_back (entry);
+
+    auto op = createOp (ttSIGN_SET, from);
+    op->setFieldU32 (sfQuorum, 1);
+    op->setFieldArray (sfSignerEntries, entries);
+    return op;
+}
+
+STTx::pointer
+mergeOp (TestAccount const& from, TestAccount const& to)
+{
+    auto op = createOp (ttACCOUNT_MERGE, from);
+    op->setFieldAccount (sfDestination, to.publicKey);
+    return op;
+}
+
+// Turns the inner transaction into a standalone one from its account
+STTx::pointer
+standalone (STTx::pointer const& op, TestAccount& from)
+{
+    op->setFieldU32 (sfSequence, from.sequence++);
+    return test::sign (op, from);
+}
+
+// The operations in one transaction, signed by the signer alone
+STTx::pointer
+batch (TestAccount& signer, std::vector<STTx::pointer> const& ops)
+{
+    STArray operations (sfOperations);
+
+    for (auto const& op : ops)
+    {
+        STObject operation (*op);
+        operation.setFName (sfOperation);
+        operations.push_back (std::move (operation));
+    }
+
+    auto txn = test::createTx (ttOPERATION, signer);
+    txn->setFieldArray (sfOperations, operations);
+    return test::sign (txn, signer);
+}
+
+}
+
+// Checks that operations which change who may sign for an account make
+// later operations in the same batch check that account again
+class Operations_test : public beast::unit_test::suite
+{
+public:
+    TER
+    apply (TransactionEngine& engine, STTx::pointer const& txn)
+    {
+        try
+        {
+            return engine.applyTransaction (*txn, tapNO_CHECK_SIGN).first;
+        }
+        catch (...)
+        {
+            return tefEXCEPTION;
+        }
+    }
+
+    void
+    expectResult (TER result, TER expected, std::string const& what)
+    {
+        expect (result == expected, what + ": " + transToken (result) +
+            ", expected " + transToken (expected));
+    }
+
+    void
+    run ()
+    {
+        test::TestLedger testLedger;
+        TestAccount& master = testLedger.master ();
+        TransactionEngine engine (testLedger.open ());
+
+        STAmount const funds (10000 * SYSTEM_CURRENCY_PARTS);
+        STAmount const small (SYSTEM_CURRENCY_PARTS);
+
+        // Each case has an account whose authorisation changes, and one to
+        // pay to
+        TestAccount alice = test::createAccount ("alice");
+        TestAccount bob = test::createAccount ("bob");
+        TestAccount carol = test::createAccount ("carol");
+        TestAccount dave = test::createAccount ("dave");
+        TestAccount eve = test::createAccount ("eve");
+
+        for (auto const* account :
+            { &testLedger.feeAccount (), &alice, &bob, &carol, &dave, &eve })
+        {
+            expectResult (apply (engine, test::pay (master, *account, funds)),
+                tesSUCCESS, "funding");
+        }
+
+        testcase ("account set");
+        {
+            // alice signs her own batch with her master key
+            expectResult (apply (engine,
+                standalone (regularKeyOp (alice, bob), alice)),
+                    tesSUCCESS, "regular key");
+
+            expectResult (apply (engine, batch (alice,
+                { payOp (alice, bob, small), payOp (alice, bob, small) })),
+                    tesSUCCESS, "before");
+
+            expectResult (apply (engine, batch (alice,
+                { payOp (alice, bob, small), disableMasterOp (alice),
+                    payOp (alice, bob, small) })),
+                        tefMASTER_DISABLED, "after disabling the master key");
+        }
+
+        testcase ("regular key set");
+        {
+            // An account whose regular key is itself may be used by any
+            // batch
+            expectResult (apply (engine,
+                standalone (regularKeyOp (bob, bob), bob)),
+                    tesSUCCESS, "regular key");
+
+            expectResult (apply (engine, batch (master,
+                { payOp (bob, carol, small), payOp (bob, carol, small) })),
+                    tesSUCCESS, "before");
+
+            expectResult (apply (engine, batch (master,
+                { payOp (bob, carol, small), regularKeyOp (bob, carol),
+                    payOp (bob, carol, small) })),
+                        tefBAD_AUTH, "after changing the regular key");
+        }
+
+        testcase ("sign set");
+        {
+            expectResult (apply (engine,
+                standalone (signSetOp (carol, master), carol)),
+                    tesSUCCESS, "signer list");
+
+            expectResult (apply (engine, batch (master,
+                { payOp (carol, dave, small), payOp (carol, dave, small) })),
+                    tesSUCCESS, "before");
+
+            expectResult (apply (engine, batch (master,
+                { payOp (carol, dave, small), signSetOp (carol, eve),
+                    payOp (carol, dave, small) })),
+                        tefBAD_AUTH, "after replacing the signer list");
+        }
+
+        testcase ("account merge");
+        {
+            expectResult (apply (engine,
+                standalone (regularKeyOp (dave, dave), dave)),
+                    tesSUCCESS, "regular key");
+            expectResult (apply (engine,
+                standalone (regularKeyOp (eve, eve), eve)),
+                    tesSUCCESS, "regular key");
+
+            expectResult (apply (engine, batch (master,
+                { payOp (dave, eve, small), payOp (eve, dave, small) })),
+                    tesSUCCESS, "before");
+
+            // dave is created again, without his regular key
+            expectResult (apply (engine, batch (master,
+                { payOp (dave, eve, small), mergeOp (dave, eve),
+                    payOp (eve, dave, funds), payOp (dave, eve, small) })),
+                        tefBAD_AUTH, "after merging the account");
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(Operations,tx,truechain);
+
+//------------------------------------------------------------------------------
+
+// Times batches of payments of growing size
+class OperationsSpeed_test : public beast::unit_test::suite
+{
+public:
+    typedef std::chrono::high_resolution_clock clock_type;
+
+    enum
+    {
+        accountCount = 16
+    };
+
+    void
+    run ()
+    {
+        test::TestLedger testLedger;
+        TestAccount& master = testLedger.master ();
+        std::vector<TestAccount> accounts;
+
+        {
+            TransactionEngine engine (testLedger.open ());
+            engine.applyTransaction (*test::pay (master,
+                testLedger.feeAccount (),
+                    STAmount (1000 * SYSTEM_CURRENCY_PARTS)), tapNO_CHECK_SIGN);
+
+            for (int i = 0; i < accountCount; ++i)
+            {
+                accounts.push_back (
+                    test::createAccount ("account" + std::to_string (i)));
+                engine.applyTransaction (*test::pay (master, accounts.back (),
+                    STAmount (1000 * SYSTEM_CURRENCY_PARTS)), tapNO_CHECK_SIGN);
+            }
+        }
+
+        for (int size : {1, 10, 100, 1000, 10000})
+        {
+            std::vector<STTx::pointer> ops;
+            ops.reserve (size);
+
+            for (int i = 0; i < size; ++i)
+            {
+                ops.push_back (payOp (master, accounts[i % accountCount],
+                    STAmount (1000)));
+            }
+
+            // Every batch is applied to its own copy of the same ledger
+            TestAccount signer = master;
+            STTx::pointer const txn = batch (signer, ops);
+            Ledger::pointer const ledger =
+                std::make_shared<Ledger> (*testLedger.open (), true);
+            TransactionEngine engine (ledger);
+
+            auto const start = clock_type::now ();
+            TER const result =
+                engine.applyTransaction (*txn, tapNO_CHECK_SIGN).first;
+            double const seconds = std::chrono::duration <double> (
+                clock_type::now () - start).count ();
+
+            expect (result == tesSUCCESS, transToken (result));
+            log << std::to_string (size) << " operations in " << seconds <<
+                "s, " << static_cast<std::size_t> (size / seconds) <<
+                    " per second";
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(OperationsSpeed,tx,truechain);
+
+} // truechain
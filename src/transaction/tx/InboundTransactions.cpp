@@ -156,6 +156,12 @@ public:
             return;
         }
 
+        if (packet.type () == protocol::liTS_SKETCH)
+        {
+            gotSketch (ta, peer, packet);
+            return;
+        }
+
         std::list<SHAMapNodeID> nodeIDs;
         std::list< Blob > nodeData;
         for (auto const &node : packet.nodes())
@@ -177,6 +183,36 @@ public:
             peer->charge (Resource::feeUnwantedData);
     }
 
+    /** A peer sent a sketch of a set we are acquiring.
+        We reconcile it against our own most recent position.
+    */
+    void gotSketch (TransactionAcquire::pointer const& ta,
+        std::shared_ptr<Peer> const& peer,
+        protocol::TMLedgerData const& packet)
+    {
+        if ((packet.nodes ().size () != 1) ||
+            !packet.nodes (0).has_nodedata ())
+        {
+            peer->charge (Resource::feeInvalidRequest);
+            return;
+        }
+
+        std::shared_ptr <SHAMap> localSet;
+        {
+            ScopedLockType sl (mLock);
+            localSet = m_localSet;
+        }
+
+        if (!localSet)
+            return;
+
+        auto const& data = packet.nodes (0).nodedata ();
+
+        if (ta->takeSketch (Blob (data.begin (), data.end ()),
+                localSet, peer).isInvalid ())
+            peer->charge (Resource::feeInvalidRequest);
+    }
+
     void giveSet (uint256 const& hash,
         std::shared_ptr <SHAMap> const& set,
         bool fromAcquire) override
@@ -198,6 +234,9 @@ public:
 
              inboundSet.mAcquire.reset ();
 
+            if (!fromAcquire)
+                m_localSet = set;
+
         }
 
         if (isNew && fromAcquire)
@@ -265,6 +304,7 @@ public:
         ScopedLockType lock (mLock);
 
         m_map.clear ();
+        m_localSet.reset ();
 
         stopped();
     }
@@ -284,6 +324,9 @@ private:
     // The empty transaction set whose hash is zero
     InboundTransactionSet& m_zeroSet;
 
+    // Our most recent position, used to reconcile sketches
+    std::shared_ptr <SHAMap> m_localSet;
+
     std::function <void (uint256 const&, std::shared_ptr <SHAMap> const&)> m_gotSet;
 };
 
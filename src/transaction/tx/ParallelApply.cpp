@@ -0,0 +1,327 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/tx/ParallelApply.h>
+#include <common/base/Log.h>
+#include <common/core/WorkerPool.h>
+#include <protocol/Indexes.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <set>
+
+namespace truechain {
+
+namespace {
+
+enum
+{
+    // Smaller batches are applied one at a time
+    minimumBatch = 32,
+
+    // Fewest transactions worth another thread
+    transactionsPerThread = 16
+};
+
+// A transaction run against the snapshot
+struct Prepared
+{
+    std::pair<TER, bool> result {tefEXCEPTION, false};
+    LedgerEntrySet view;
+    LedgerEntryReads reads;
+    bool threw = false;
+};
+
+// Keys the batch has written to the ledger so far
+typedef std::set<uint256> WriteSet;
+
+void
+noteWrites (LedgerEntrySet const& view, WriteSet& written)
+{
+    for (auto const& it : view)
+    {
+        if (it.second.mAction != taaCACHED)
+            written.insert (it.first);
+    }
+}
+
+// Whether any written key lies after first, up to and including last
+bool
+touches (WriteSet const& written, uint256 const& first, uint256 const& last)
+{
+    auto const it = written.upper_bound (first);
+    return (it != written.end ()) && (last.isZero () || (*it <= last));
+}
+
+// Whether a prepared transaction read anything written since the snapshot
+bool
+isStale (Prepared const& p, WriteSet const& written, uint256 const& feeIndex)
+{
+    if (written.empty ())
+        return false;
+
+    if (p.reads.untracked)
+        return true;
+
+    for (auto const& key : p.reads.keys)
+    {
+        if ((key != feeIndex) && (written.count (key) != 0))
+            return true;
+    }
+
+    // Entries created without being looked up first
+    for (auto const& it : p.view)
+    {
+        if ((it.first != feeIndex) && (written.count (it.first) != 0))
+            return true;
+    }
+
+    for (auto const& range : p.reads.ranges)
+    {
+        if (touches (written, range.first, range.second))
+            return true;
+    }
+
+    return false;
+}
+
+/*  Nearly every transaction credits its fee to the fee account, so they
+    would all conflict there. A transaction that did nothing to the fee
+    account but add to its balance is moved onto the current balance.
+    Returns false if the transaction depended on the fee account some
+    other way.
+*/
+bool
+rebaseFeeAccount (LedgerEntrySet& view, STTx const& txn,
+    Account const& feeAccount, uint256 const& feeIndex,
+    Ledger const& snapshot, Ledger const& ledger)
+{
+    if (txn.getSourceAccount ().getAccountID () == feeAccount)
+        return false;
+
+    LedgerEntryAction action;
+    SLE::pointer entry = view.getEntry (feeIndex, action);
+
+    // Looked at, but left alone
+    if (!entry || (action == taaCACHED))
+        return true;
+
+    if (action != taaMODIFY)
+        return false;
+
+    SLE::pointer before = snapshot.getSLE (feeIndex);
+    SLE::pointer current = ledger.getSLE (feeIndex);
+
+    if (!before || !current)
+        return false;
+
+    STAmount const balance = entry->getFieldAmount (sfBalance);
+    STAmount const credit = balance - before->getFieldAmount (sfBalance);
+
+    if (credit < zero)
+        return false;
+
+    before->setFieldAmount (sfBalance, balance);
+
+    if (!(*before == *entry))
+        return false;
+
+    current->setFieldAmount (sfBalance,
+        current->getFieldAmount (sfBalance) + credit);
+    *entry = *current;
+    return true;
+}
+
+// Apply one transaction to the engine's ledger
+std::pair<TER, bool>
+applyOne (TransactionEngine& engine, STTx const& txn,
+    TransactionEngineParams params, WriteSet& written)
+{
+    std::pair<TER, bool> result (tefEXCEPTION, false);
+
+    try
+    {
+        result = engine.prepareTransaction (txn, params);
+
+        if (result.second)
+        {
+            try
+            {
+                engine.commitTransaction (txn, result.first, params);
+            }
+            catch (...)
+            {
+                noteWrites (engine.view (), written);
+                throw;
+            }
+
+            noteWrites (engine.view (), written);
+        }
+    }
+    catch (std::exception const& e)
+    {
+        WriteLog (lsWARNING, TransactionEngine) <<
+            "Transaction " << txn.getTransactionID () << " throws: " << e.what ();
+        result = std::make_pair (tefEXCEPTION, false);
+    }
+
+    engine.view ().clear ();
+    return result;
+}
+
+} // anonymous namespace
+
+std::vector<std::pair<TER, bool>>
+applyInParallel (TransactionEngine& engine,
+    std::vector<STTx::pointer> const& txns,
+    std::vector<TransactionEngineParams> const& params)
+{
+    if (txns.size () < minimumBatch)
+        return applyInParallel (engine, txns, params, 1);
+
+    return applyInParallel (engine, txns, params,
+        parallelThreadCount (txns.size (), transactionsPerThread));
+}
+
+std::vector<std::pair<TER, bool>>
+applyInParallel (TransactionEngine& engine,
+    std::vector<STTx::pointer> const& txns,
+    std::vector<TransactionEngineParams> const& params,
+    int threads)
+{
+    assert (txns.size () == params.size ());
+
+    std::vector<std::pair<TER, bool>> results;
+    results.reserve (txns.size ());
+
+    WriteSet written;
+
+    if (threads < 2)
+    {
+        for (std::size_t i = 0; i < txns.size (); ++i)
+            results.push_back (applyOne (engine, *txns[i], params[i], written));
+
+        return results;
+    }
+
+    Ledger::pointer const ledger = engine.getLedger ();
+    Ledger::pointer const snapshot = std::make_shared<Ledger> (*ledger, false);
+
+    std::vector<Prepared> prepared (txns.size ());
+    std::atomic<std::size_t> next (0);
+
+    auto prepare = [&]()
+    {
+        TransactionEngine worker (snapshot);
+
+        for (std::size_t i; (i = next++) < txns.size ();)
+        {
+            Prepared& p = prepared[i];
+
+            worker.view ().trackReads (&p.reads);
+
+            try
+            {
+                p.result = worker.prepareTransaction (*txns[i], params[i]);
+            }
+            catch (...)
+            {
+                p.threw = true;
+            }
+
+            p.view.swapWith (worker.view ());
+            p.view.trackReads (nullptr);
+            worker.view ().clear ();
+        }
+    };
+
+    runParallel (threads, prepare);
+
+    // Write the results in order, rerunning any that saw stale entries
+    Account const feeAccount = ledger->getFeeAccountID ();
+    uint256 const feeIndex = getAccountRootIndex (feeAccount);
+    int rerun = 0;
+
+    // Once a management entry changes, the fee account taken above and
+    // anything the workers saw of it may be wrong, so the rest of the
+    // batch is applied one at a time.
+    uint256 const manageFeeIndex = Ledger::getLedgerManageFeeIndex ();
+    uint256 const manageIssuerIndex = Ledger::getLedgerManageIssuerIndex ();
+    bool managed = false;
+
+    for (std::size_t i = 0; i < txns.size (); ++i)
+    {
+        Prepared& p = prepared[i];
+        STTx const& txn = *txns[i];
+
+        if (!managed)
+        {
+            managed = (written.count (manageFeeIndex) != 0) ||
+                (written.count (manageIssuerIndex) != 0);
+        }
+
+        bool stale = managed || isStale (p, written, feeIndex);
+
+        if (!stale && (written.count (feeIndex) != 0) &&
+            (p.reads.keys.count (feeIndex) != 0))
+        {
+            stale = p.threw || !rebaseFeeAccount (p.view, txn,
+                feeAccount, feeIndex, *snapshot, *ledger);
+        }
+
+        if (stale)
+        {
+            ++rerun;
+            results.push_back (applyOne (engine, txn, params[i], written));
+            continue;
+        }
+
+        if (p.threw || !p.result.second)
+        {
+            results.push_back (p.result);
+            continue;
+        }
+
+        engine.view ().swapWith (p.view);
+        engine.view ().getLedger () = ledger;
+
+        try
+        {
+            engine.commitTransaction (txn, p.result.first, params[i]);
+            results.push_back (p.result);
+        }
+        catch (std::exception const& e)
+        {
+            WriteLog (lsWARNING, TransactionEngine) <<
+                "Transaction " << txn.getTransactionID () << " throws: " << e.what ();
+            results.push_back (std::make_pair (tefEXCEPTION, false));
+        }
+
+        noteWrites (engine.view (), written);
+        engine.view ().clear ();
+    }
+
+    WriteLog (lsDEBUG, TransactionEngine) << "Applied " << txns.size () <<
+        " transactions on " << threads << " threads, " << rerun << " rerun";
+
+    return results;
+}
+
+} // truechain
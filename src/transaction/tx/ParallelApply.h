@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_APP_TX_PARALLELAPPLY_H_INCLUDED
+#define SKYWELL_APP_TX_PARALLELAPPLY_H_INCLUDED
+
+#include <transaction/tx/TransactionEngine.h>
+#include <protocol/STTx.h>
+#include <utility>
+#include <vector>
+
+namespace truechain {
+
+/** Apply transactions to the engine's ledger, in order.
+
+    Each transaction is first run on a worker thread against a snapshot
+    of the ledger, recording what it reads. The results are then written
+    in order. A transaction that read something an earlier transaction
+    in the batch changed is run again against the ledger as it stands.
+    The ledger and metadata produced are the same as applying the batch
+    one transaction at a time.
+
+    @param engine  The engine whose ledger receives the transactions.
+    @param txns    The transactions, in the order they must be applied.
+    @param params  The engine parameters for each transaction.
+    @return        The result of applying each transaction. A transaction
+                   that threw reports tefEXCEPTION and was not applied.
+*/
+std::vector<std::pair<TER, bool>>
+applyInParallel (TransactionEngine& engine,
+    std::vector<STTx::pointer> const& txns,
+    std::vector<TransactionEngineParams> const& params);
+
+/** Apply transactions as above, preparing them on the given number of
+    threads however many the machine has. Fewer than two applies them
+    one at a time.
+*/
+std::vector<std::pair<TER, bool>>
+applyInParallel (TransactionEngine& engine,
+    std::vector<STTx::pointer> const& txns,
+    std::vector<TransactionEngineParams> const& params,
+    int threads);
+
+} // truechain
+
+#endif
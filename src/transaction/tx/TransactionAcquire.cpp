@@ -24,6 +24,9 @@
 #include <common/misc/NetworkOPs.h>
 #include <transaction/tx/TransactionAcquire.h>
 #include <transaction/tx/InboundTransactions.h>
+#include <transaction/tx/TransactionMaster.h>
+#include <transaction/tx/TxSetSketch.h>
+#include <protocol/BuildInfo.h>
 #include <network/overlay/Overlay.h>
 #include <beast/utility/make_lock.h>
 #include <memory>
@@ -37,12 +40,16 @@ enum
 
     NORM_TIMEOUTS = 4,
     MAX_TIMEOUTS = 20,
+
+    // How many peers we ask for a sketch of the set
+    MAX_SKETCH_REQUESTS = 2,
 };
 
 TransactionAcquire::TransactionAcquire (uint256 const& hash, clock_type& clock)
     : PeerSet (hash, TX_ACQUIRE_TIMEOUT, true, clock,
         deprecatedLogs().journal("TransactionAcquire"))
     , mHaveRoot (false)
+    , mSketchRequests (0)
 {
     mMap = std::make_shared<SHAMap> (SHAMapType::TRANSACTION, hash,
         getApp().family(), deprecatedLogs().journal("SHAMap"));
@@ -131,6 +138,18 @@ void TransactionAcquire::trigger (Peer::ptr const& peer)
 
         * (tmGL.add_nodeids ()) = SHAMapNodeID ().getRawString ();
         sendRequest (tmGL, peer);
+
+        // liTS_SKETCH was introduced with RTXP/1.3
+        if (peer && (getTimeouts () == 0) &&
+            (mSketchRequests < MAX_SKETCH_REQUESTS) &&
+            peer->supportsVersion (to_packed (ProtocolVersion (1, 3))))
+        {
+            protocol::TMGetLedger tmSketch;
+            tmSketch.set_ledgerhash (mHash.begin (), mHash.size ());
+            tmSketch.set_itype (protocol::liTS_SKETCH);
+            sendRequest (tmSketch, peer);
+            ++mSketchRequests;
+        }
     }
     else if (!mMap->isValid ())
     {
@@ -231,6 +250,86 @@ SHAMapAddNode TransactionAcquire::takeNodes (const std::list<SHAMapNodeID>& node
     }
 }
 
+SHAMapAddNode TransactionAcquire::takeSketch (Blob const& data,
+    std::shared_ptr<SHAMap> const& localSet, Peer::ptr const& peer)
+{
+    ScopedLockType sl (mLock);
+
+    if (mComplete || mFailed)
+        return SHAMapAddNode ();
+
+    std::vector<uint256> onlyTheirs;
+    std::vector<uint256> onlyOurs;
+
+    try
+    {
+        Serializer s (data.begin (), data.end ());
+        SerialIter sit (s);
+        TxSetSketch sketch (sit);
+
+        TxSetSketch ours (sketch.size ());
+        localSet->visitLeaves ([&ours](std::shared_ptr<SHAMapItem> const& item)
+        {
+            ours.insert (item->getTag ());
+        });
+
+        sketch.subtract (ours);
+
+        if (! sketch.decode (onlyTheirs, onlyOurs))
+        {
+            WriteLog (lsDEBUG, TransactionAcquire) <<
+                "TX set " << mHash << " too different to reconcile";
+            return SHAMapAddNode::duplicate ();
+        }
+    }
+    catch (...)
+    {
+        WriteLog (lsWARNING, TransactionAcquire) << "Peer sends us junky sketch";
+        return SHAMapAddNode::invalid ();
+    }
+
+    std::shared_ptr<SHAMap> map = localSet->snapShot (true);
+    map->setUnbacked ();
+
+    for (auto const& id : onlyOurs)
+        map->delItem (id);
+
+    for (auto const& id : onlyTheirs)
+    {
+        Transaction::pointer txn = getApp().getMasterTransaction().fetch (id, false);
+
+        if (!txn)
+        {
+            WriteLog (lsDEBUG, TransactionAcquire) <<
+                "TX set " << mHash << " needs " << onlyTheirs.size () <<
+                " transactions, fetching nodes";
+            return SHAMapAddNode::useful ();
+        }
+
+        Serializer s;
+        txn->getSTransaction ()->add (s);
+        map->addItem (SHAMapItem (id, std::move (s)), true, false);
+    }
+
+    if (map->getHash () != mHash)
+    {
+        WriteLog (lsDEBUG, TransactionAcquire) <<
+            "TX set " << mHash << " reconciled to wrong hash";
+        return SHAMapAddNode::duplicate ();
+    }
+
+    WriteLog (lsDEBUG, TransactionAcquire) <<
+        "Reconciled TX set " << mHash << ": +" << onlyTheirs.size () <<
+        " -" << onlyOurs.size ();
+
+    mMap = map;
+    mHaveRoot = true;
+    mComplete = true;
+    done ();
+    progress ();
+    return SHAMapAddNode::useful ();
+}
+
 void TransactionAcquire::addPeers (int numPeers)
 {
     getApp().overlay().selectPeers (*this, numPeers, ScoreHasTxSet (getHash()));
@@ -49,6 +49,12 @@ public:
     SHAMapAddNode takeNodes (const std::list<SHAMapNodeID>& IDs,
                              const std::list< Blob >& data, Peer::ptr const&);
 
+    /** Try to rebuild the set from a peer's sketch of it and a set we have.
+        Transactions we cannot find locally are left to the node fetch.
+    */
+    SHAMapAddNode takeSketch (Blob const& data,
+        std::shared_ptr<SHAMap> const& localSet, Peer::ptr const&);
+
     void init (int startPeers);
 
     void stillNeed ();
@@ -57,6 +63,7 @@ private:
 
     std::shared_ptr<SHAMap> mMap;
     bool                    mHaveRoot;
+    int                     mSketchRequests;
 
     void onTimer (bool progress, ScopedLockType& peerSetLock);
 
@@ -74,6 +74,8 @@ void TransactionEngine::txnWrite ()
 
             if (!mLedger->peekAccountStateMap ()->delItem (it.first))
                 assert (false);
+
+            mLedger->invalidateManagement (sleEntry->getType ());
         }
         break;
         }
@@ -84,6 +86,26 @@ std::pair<TER, bool>
 TransactionEngine::applyTransaction (
     STTx const& txn,
     TransactionEngineParams params)
+{
+    auto const result = prepareTransaction (txn, params);
+
+    if (result.second)
+        commitTransaction (txn, result.first, params);
+
+    mNodes.clear ();
+
+    if (!(params & tapOPEN_LEDGER) && isTemMalformed (result.first))
+    {
+        // XXX Malformed or failed transaction in closed ledger must bow out.
+    }
+
+    return result;
+}
+
+std::pair<TER, bool>
+TransactionEngine::prepareTransaction (
+    STTx const& txn,
+    TransactionEngineParams params)
 {
     assert (mLedger);
 
@@ -209,51 +231,50 @@ TransactionEngine::applyTransaction (
         terResult = tefINTERNAL;
     }
 
-    if (didApply)
-    {
-        // Transaction succeeded fully or (retries are not allowed and the
-        // transaction could claim a fee)
-        Serializer m;
-        mNodes.calcRawMeta (m, terResult, mTxnSeq++);
+    return { terResult, didApply };
+}
+
+void
+TransactionEngine::commitTransaction (
+    STTx const& txn,
+    TER terResult,
+    TransactionEngineParams params)
+{
+    uint256 const& txID = txn.getTransactionID ();
+
+    // Transaction succeeded fully or (retries are not allowed and the
+    // transaction could claim a fee)
+    Serializer m;
+    mNodes.calcRawMeta (m, terResult, mTxnSeq++);
 
-        txnWrite ();
+    txnWrite ();
 
-        Serializer s;
-        txn.add (s);
+    Serializer s;
+    txn.add (s);
 
-        if (params & tapOPEN_LEDGER)
+    if (params & tapOPEN_LEDGER)
+    {
+        if (!mLedger->addTransaction (txID, s))
         {
-            if (!mLedger->addTransaction (txID, s))
-            {
-                WriteLog (lsFATAL, TransactionEngine) <<
-                    "Duplicate transaction applied";
-                assert (false);
-                throw std::runtime_error ("Duplicate transaction applied");
-            }
+            WriteLog (lsFATAL, TransactionEngine) <<
+                "Duplicate transaction applied";
+            assert (false);
+            throw std::runtime_error ("Duplicate transaction applied");
         }
-        else
+    }
+    else
+    {
+        if (!mLedger->addTransaction (txID, s, m))
         {
-            if (!mLedger->addTransaction (txID, s, m))
-            {
-                WriteLog (lsFATAL, TransactionEngine) <<
-                    "Duplicate transaction applied to closed ledger";
-                assert (false);
-                throw std::runtime_error ("Duplicate transaction applied to closed ledger");
-            }
-
-            // Charge whatever fee they specified.
-//            mLedger->destroyCoins (getNValue (txn.getTransactionFee ()));
+            WriteLog (lsFATAL, TransactionEngine) <<
+                "Duplicate transaction applied to closed ledger";
+            assert (false);
+            throw std::runtime_error ("Duplicate transaction applied to closed ledger");
         }
-    }
-
-    mNodes.clear ();
 
-    if (!(params & tapOPEN_LEDGER) && isTemMalformed (terResult))
-    {
-        // XXX Malformed or failed transaction in closed ledger must bow out.
+        // Charge whatever fee they specified.
+//            mLedger->destroyCoins (getNValue (txn.getTransactionFee ()));
     }
-
-    return { terResult, didApply };
 }
 
 bool
@@ -77,6 +77,20 @@ public:
     std::pair<TER, bool>
     applyTransaction (STTx const&, TransactionEngineParams);
 
+    /** Run a transaction without writing it to the ledger.
+
+        On return the view holds the transaction's changes. If the
+        transaction applied, commitTransaction writes them and records
+        the transaction; either way the view must be cleared before the
+        next transaction.
+    */
+    std::pair<TER, bool>
+    prepareTransaction (STTx const&, TransactionEngineParams);
+
+    // Write a prepared transaction and its metadata to the ledger
+    void
+    commitTransaction (STTx const&, TER, TransactionEngineParams);
+
     bool
     checkInvariants (TER result, STTx const& txn, TransactionEngineParams params);
 };
@@ -28,6 +28,8 @@ namespace truechain {
 TransactionMaster::TransactionMaster ()
     : mCache ("TransactionCache", 65536, 1800, get_seconds_clock (),
         deprecatedLogs().journal("TaggedCache"))
+    , mParsedCache ("ParsedTransactionCache", 65536, 300, get_seconds_clock (),
+        deprecatedLogs().journal("TaggedCache"))
 {
 }
 
@@ -95,6 +97,34 @@ STTx::pointer TransactionMaster::fetch (std::shared_ptr<SHAMapItem> const& item,
     return txn;
 }
 
+STTx::pointer TransactionMaster::fetchParsed (uint256 const& txnID,
+    Serializer const& data)
+{
+    Transaction::pointer iTx = mCache.fetch (txnID);
+
+    if (iTx)
+        return iTx->getSTransaction ();
+
+    STTx::pointer txn = mParsedCache.fetch (txnID);
+
+    if (!txn)
+    {
+        SerialIter sit (data);
+        txn = std::make_shared<STTx> (std::ref (sit));
+
+        //  NOTE canonicalize can change the value of txn!
+        mParsedCache.canonicalize (txnID, txn);
+    }
+
+    return txn;
+}
+
+STTx::pointer TransactionMaster::fetchParsed (
+    std::shared_ptr<SHAMapItem> const& item)
+{
+    return fetchParsed (item->getTag (), item->peekSerializer ());
+}
+
 bool TransactionMaster::canonicalize (Transaction::pointer* pTransaction)
 {
     Transaction::pointer txn (*pTransaction);
@@ -119,6 +149,7 @@ bool TransactionMaster::canonicalize (Transaction::pointer* pTransaction)
 void TransactionMaster::sweep (void)
 {
     mCache.sweep ();
+    mParsedCache.sweep ();
 }
 
 TaggedCache <uint256, Transaction>& TransactionMaster::getCache()
@@ -37,6 +37,13 @@ public:
     STTx::pointer  fetch (std::shared_ptr<SHAMapItem> const& item, SHAMapTreeNode:: TNType type,
                                            bool checkDisk, std::uint32_t uCommitLedger);
 
+    /** Returns the canonical parsed form of a transaction without metadata.
+        Transactions already in memory are shared rather than parsed again.
+        @throws if the transaction must be parsed and is malformed.
+    */
+    STTx::pointer fetchParsed (uint256 const& txnID, Serializer const& data);
+    STTx::pointer fetchParsed (std::shared_ptr<SHAMapItem> const& item);
+
     // return value: true = we had the transaction already
     bool inLedger (uint256 const& hash, std::uint32_t ledger);
     bool canonicalize (Transaction::pointer* pTransaction);
@@ -45,6 +52,9 @@ public:
 
 private:
     TaggedCache <uint256, Transaction> mCache;
+
+    // Parsed transactions we have no Transaction object for
+    TaggedCache <uint256, STTx> mParsedCache;
 };
 
 } // truechain
@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/tx/TxSetSketch.h>
+#include <common/base/UnorderedContainers.h>
+#include <stdexcept>
+
+namespace truechain {
+
+enum
+{
+    // Each ID is stored in one cell of each of this many sub-tables
+    sketchHashes = 3,
+
+    // Smallest and largest sketch we build or accept
+    minSketchCells = 48,
+    maxSketchCells = 6144,
+};
+
+// Extract a 64-bit word from an ID in a platform independent way.
+// IDs are hashes, so their words are already uniformly distributed.
+static std::uint64_t
+sketchWord (uint256 const& id, int i)
+{
+    std::uint64_t ret = 0;
+    auto const p = id.begin () + (i * 8);
+    for (int j = 0; j < 8; ++j)
+        ret = (ret << 8) | p[j];
+    return ret;
+}
+
+static std::uint64_t
+sketchCheck (uint256 const& id)
+{
+    return (sketchWord (id, 3) ^ (sketchWord (id, 0) >> 17)) *
+        0x9E3779B97F4A7C15ULL;
+}
+
+TxSetSketch::TxSetSketch (std::size_t cells)
+    : cells_ (cells)
+{
+    if ((cells == 0) || (cells % sketchHashes) != 0)
+        throw std::runtime_error ("invalid sketch size");
+}
+
+TxSetSketch::TxSetSketch (SHAMap const& set)
+{
+    std::vector<uint256> ids;
+    set.visitLeaves ([&ids](std::shared_ptr<SHAMapItem> const& item)
+    {
+        ids.push_back (item->getTag ());
+    });
+
+    cells_.resize (cellsFor (ids.size ()));
+
+    for (auto const& id : ids)
+        insert (id);
+}
+
+TxSetSketch::TxSetSketch (SerialIter& sit)
+{
+    std::size_t const cells = sit.get32 ();
+
+    if ((cells < minSketchCells) || (cells > maxSketchCells) ||
+        (cells % sketchHashes) != 0)
+        throw std::runtime_error ("invalid sketch size");
+
+    cells_.resize (cells);
+
+    for (auto& cell : cells_)
+    {
+        cell.count = static_cast<std::int32_t> (sit.get32 ());
+        cell.keySum = sit.get256 ();
+        cell.checkSum = sit.get64 ();
+    }
+
+    if (! sit.empty ())
+        throw std::runtime_error ("trailing sketch data");
+}
+
+std::size_t
+TxSetSketch::cellsFor (std::size_t setSize)
+{
+    std::size_t cells = setSize / 4;
+
+    if (cells < minSketchCells)
+        cells = minSketchCells;
+    else if (cells > maxSketchCells)
+        cells = maxSketchCells;
+
+    return cells - (cells % sketchHashes);
+}
+
+void
+TxSetSketch::toggle (uint256 const& id, std::int32_t direction)
+{
+    std::size_t const width = cells_.size () / sketchHashes;
+    std::uint64_t const check = sketchCheck (id);
+
+    for (int i = 0; i < sketchHashes; ++i)
+    {
+        auto& cell = cells_[(i * width) + (sketchWord (id, i) % width)];
+        cell.count += direction;
+        cell.keySum ^= id;
+        cell.checkSum ^= check;
+    }
+}
+
+void
+TxSetSketch::insert (uint256 const& id)
+{
+    toggle (id, 1);
+}
+
+bool
+TxSetSketch::subtract (TxSetSketch const& other)
+{
+    if (other.cells_.size () != cells_.size ())
+        return false;
+
+    for (std::size_t i = 0; i < cells_.size (); ++i)
+    {
+        cells_[i].count -= other.cells_[i].count;
+        cells_[i].keySum ^= other.cells_[i].keySum;
+        cells_[i].checkSum ^= other.cells_[i].checkSum;
+    }
+
+    return true;
+}
+
+bool
+TxSetSketch::isPure (Cell const& cell)
+{
+    return ((cell.count == 1) || (cell.count == -1)) &&
+        (sketchCheck (cell.keySum) == cell.checkSum);
+}
+
+bool
+TxSetSketch::decode (std::vector<uint256>& added,
+    std::vector<uint256>& removed) const
+{
+    TxSetSketch work (*this);
+
+    // A genuine difference holds each ID once and no more IDs than
+    // cells. A crafted sketch can peel forever, or repeat an ID.
+    hash_set<uint256> seen;
+
+    bool progress = true;
+
+    while (progress)
+    {
+        progress = false;
+
+        for (auto const& cell : work.cells_)
+        {
+            if (! isPure (cell))
+                continue;
+
+            // Copy, since peeling modifies this cell
+            uint256 const id = cell.keySum;
+            std::int32_t const count = cell.count;
+
+            if ((seen.size () == work.cells_.size ()) ||
+                    ! seen.insert (id).second)
+                return false;
+
+            if (count > 0)
+                added.push_back (id);
+            else
+                removed.push_back (id);
+
+            work.toggle (id, -count);
+            progress = true;
+        }
+    }
+
+    for (auto const& cell : work.cells_)
+    {
+        if (! cell.empty ())
+            return false;
+    }
+
+    return true;
+}
+
+void
+TxSetSketch::add (Serializer& s) const
+{
+    s.add32 (static_cast<std::uint32_t> (cells_.size ()));
+
+    for (auto const& cell : cells_)
+    {
+        s.add32 (static_cast<std::uint32_t> (cell.count));
+        s.add256 (cell.keySum);
+        s.add64 (cell.checkSum);
+    }
+}
+
+} // truechain
@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_APP_TX_TXSETSKETCH_H_INCLUDED
+#define SKYWELL_APP_TX_TXSETSKETCH_H_INCLUDED
+
+#include <common/base/base_uint.h>
+#include <common/shamap/SHAMap.h>
+#include <protocol/Serializer.h>
+#include <cstdint>
+#include <vector>
+
+namespace truechain {
+
+/** An invertible Bloom lookup table over transaction IDs.
+
+    Two nodes holding similar transaction sets can find the difference
+    between them by exchanging a sketch whose size depends only on the
+    expected size of that difference. Subtracting one sketch from another
+    of the same size cancels the common transactions, and the differing
+    IDs can then be peeled out of the remaining cells.
+*/
+class TxSetSketch
+{
+public:
+    /** Create an empty sketch with the given number of cells.
+        A sketch can usually be decoded when the difference between the
+        two sets is at most two thirds of its cells.
+    */
+    explicit TxSetSketch (std::size_t cells);
+
+    /** Create a sketch sized for and filled from a transaction set. */
+    explicit TxSetSketch (SHAMap const& set);
+
+    /** Deserialize a sketch received from a peer.
+        @throws std::runtime_error if the data is malformed.
+    */
+    explicit TxSetSketch (SerialIter& sit);
+
+    std::size_t size () const
+    {
+        return cells_.size ();
+    }
+
+    void insert (uint256 const& id);
+
+    /** Remove the contents of another sketch.
+        @return false if the sketches do not have the same size.
+    */
+    bool subtract (TxSetSketch const& other);
+
+    /** Recover the IDs left after a subtraction.
+        @param added IDs present only in the sketch we subtracted from.
+        @param removed IDs present only in the sketch we subtracted.
+        @return false if the difference was too large to decode, or
+                the sketch could not have come from two sets.
+    */
+    bool decode (std::vector<uint256>& added,
+        std::vector<uint256>& removed) const;
+
+    void add (Serializer& s) const;
+
+    /** Returns the number of cells to use for a set of the given size. */
+    static std::size_t cellsFor (std::size_t setSize);
+
+private:
+    struct Cell
+    {
+        std::int32_t count = 0;
+        uint256 keySum;
+        std::uint64_t checkSum = 0;
+
+        bool empty () const
+        {
+            return count == 0 && checkSum == 0 && keySum.isZero ();
+        }
+    };
+
+    void toggle (uint256 const& id, std::int32_t direction);
+
+    static bool isPure (Cell const& cell);
+
+    std::vector<Cell> cells_;
+};
+
+} // truechain
+
+#endif
@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/tx/ParallelApply.h>
+#include <transaction/tx/tests/TestLedger.h>
+#include <beast/unit_test/suite.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace truechain {
+
+// Checks the parallel apply against applying the same batch serially
+class ParallelApply_test : public beast::unit_test::suite
+{
+public:
+    typedef test::TestAccount TestAccount;
+
+    enum
+    {
+        // Enough accounts for a batch to be split across threads
+        accountCount = 128,
+
+        // Forced, so the parallel path runs on small machines too
+        threadCount = 4
+    };
+
+    static STTx::pointer
+    setFeeAccount (TestAccount& manager, TestAccount const& feeAccount)
+    {
+        auto txn = test::createTx (ttMNGFEE, manager);
+        txn->setFieldAccount (sfFeeAccountID, feeAccount.publicKey);
+        return test::sign (txn, manager);
+    }
+
+    // Apply the batch both ways to copies of the parent and compare them
+    Ledger::pointer
+    check (Ledger& parent, std::vector<STTx::pointer> const& txns,
+        std::string const& batch)
+    {
+        std::vector<TransactionEngineParams> params (txns.size (), tapNONE);
+
+        Ledger::pointer parallelLedger = std::make_shared<Ledger> (parent, true);
+        TransactionEngine parallelEngine (parallelLedger);
+        auto const results =
+            applyInParallel (parallelEngine, txns, params, threadCount);
+
+        Ledger::pointer serialLedger = std::make_shared<Ledger> (parent, true);
+        TransactionEngine serialEngine (serialLedger);
+
+        for (std::size_t i = 0; i < txns.size (); ++i)
+        {
+            std::pair<TER, bool> result (tefEXCEPTION, false);
+
+            try
+            {
+                result = serialEngine.applyTransaction (*txns[i], params[i]);
+            }
+            catch (...)
+            {
+            }
+
+            expect (result.first == tesSUCCESS,
+                batch + ": " + transToken (result.first));
+            expect (result == results[i], batch + ": " +
+                transToken (results[i].first) + " in parallel, " +
+                transToken (result.first) + " serially");
+        }
+
+        expect (serialLedger->peekAccountStateMap ()->getHash () ==
+            parallelLedger->peekAccountStateMap ()->getHash (),
+                batch + ": state maps differ");
+        expect (serialLedger->peekTransactionMap ()->getHash () ==
+            parallelLedger->peekTransactionMap ()->getHash (),
+                batch + ": transaction maps differ");
+
+        return parallelLedger;
+    }
+
+    void
+    run ()
+    {
+        test::TestLedger testLedger;
+        TestAccount& master = testLedger.master ();
+        TestAccount& manager = testLedger.manager ();
+        std::vector<TestAccount> accounts;
+
+        for (int i = 0; i < accountCount; ++i)
+        {
+            accounts.push_back (
+                test::createAccount ("account" + std::to_string (i)));
+        }
+
+        Ledger::pointer ledger = testLedger.open ();
+        STAmount const funds (1000 * SYSTEM_CURRENCY_PARTS);
+        STAmount const part (100 * SYSTEM_CURRENCY_PARTS);
+        std::vector<STTx::pointer> txns;
+
+        // Every payment is from the same account
+        txns.push_back (test::pay (master, manager, funds));
+        txns.push_back (test::pay (master, testLedger.feeAccount (), funds));
+
+        for (auto const& account : accounts)
+            txns.push_back (test::pay (master, account, funds));
+
+        ledger = check (*ledger, txns, "funding");
+
+        // Nothing in common but the fee account
+        txns.clear ();
+
+        for (std::size_t i = 0; i + 1 < accounts.size (); i += 2)
+            txns.push_back (test::pay (accounts[i], accounts[i + 1], part));
+
+        ledger = check (*ledger, txns, "independent");
+
+        // Each payment is to the sender of the next
+        txns.clear ();
+
+        for (std::size_t i = 0; i < accounts.size (); ++i)
+        {
+            txns.push_back (test::pay (accounts[i],
+                accounts[(i + 1) % accounts.size ()], part));
+        }
+
+        ledger = check (*ledger, txns, "chained");
+
+        // The fee account changes part way through
+        txns.clear ();
+
+        for (std::size_t i = 0; i < accounts.size (); ++i)
+        {
+            if (i == accounts.size () / 2)
+                txns.push_back (setFeeAccount (manager, master));
+
+            txns.push_back (test::pay (accounts[i], master, part));
+        }
+
+        check (*ledger, txns, "fee account");
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ParallelApply,tx,truechain);
+
+} // truechain
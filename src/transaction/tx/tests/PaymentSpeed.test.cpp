@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/tx/TransactionEngine.h>
+#include <transaction/tx/tests/TestLedger.h>
+#include <beast/unit_test/suite.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace truechain {
+
+// Times applying payments between a set of funded accounts. Most of the
+// work outside signature checks is reading and writing the account roots,
+// so this shows the cost of computing ledger indexes.
+class PaymentSpeed_test : public beast::unit_test::suite
+{
+public:
+    typedef std::chrono::high_resolution_clock clock_type;
+
+    enum
+    {
+        accountCount = 100,
+
+        paymentCount = 10000
+    };
+
+    // Applies the payments to the ledger, returning seconds taken
+    double
+    apply (Ledger::pointer const& ledger,
+        std::vector<STTx::pointer> const& txns)
+    {
+        TransactionEngine engine (ledger);
+        std::size_t failed = 0;
+
+        auto const start = clock_type::now ();
+
+        for (auto const& txn : txns)
+        {
+            if (engine.applyTransaction (*txn, tapNO_CHECK_SIGN).first !=
+                    tesSUCCESS)
+                ++failed;
+        }
+
+        auto const elapsed = clock_type::now () - start;
+
+        expect (failed == 0, std::to_string (failed) + " payments failed");
+        return std::chrono::duration <double> (elapsed).count ();
+    }
+
+    void
+    run ()
+    {
+        test::TestLedger testLedger;
+        test::TestAccount& master = testLedger.master ();
+        std::vector<test::TestAccount> accounts;
+
+        for (int i = 0; i < accountCount; ++i)
+        {
+            accounts.push_back (
+                test::createAccount ("account" + std::to_string (i)));
+        }
+
+        std::vector<STTx::pointer> txns;
+        txns.push_back (test::pay (master, testLedger.feeAccount (),
+            STAmount (1000 * SYSTEM_CURRENCY_PARTS)));
+
+        for (auto const& account : accounts)
+        {
+            txns.push_back (test::pay (master, account,
+                STAmount (100000 * SYSTEM_CURRENCY_PARTS)));
+        }
+
+        Ledger::pointer const ledger = testLedger.open ();
+        apply (ledger, txns);
+
+        // Signed up front, so only the apply is timed
+        txns.clear ();
+
+        for (int i = 0; i < paymentCount; ++i)
+        {
+            txns.push_back (test::pay (accounts[i % accountCount],
+                accounts[(i * 7 + 1) % accountCount],
+                    STAmount (SYSTEM_CURRENCY_PARTS)));
+        }
+
+        double const seconds = apply (ledger, txns);
+
+        log << paymentCount << " payments in " << seconds << "s, " <<
+            static_cast<std::size_t> (paymentCount / seconds) <<
+                " per second";
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(PaymentSpeed,tx,truechain);
+
+} // truechain
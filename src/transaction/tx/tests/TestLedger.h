@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+/*
+	Copyright (c) 2012, 2013 Skywell Labs Inc.
+	Copyright (c) 2017-2018 TrueChain Foundation.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_APP_TX_TESTS_TESTLEDGER_H_INCLUDED
+#define SKYWELL_APP_TX_TESTS_TESTLEDGER_H_INCLUDED
+
+#include <ledger/Ledger.h>
+#include <ledger/LedgerMaster.h>
+#include <main/Application.h>
+#include <common/core/Config.h>
+#include <protocol/STTx.h>
+#include <protocol/SkywellAddress.h>
+#include <protocol/SystemParameters.h>
+#include <functional>
+#include <string>
+
+namespace truechain {
+namespace test {
+
+// Shared by the suites that apply transactions to a real ledger
+
+struct TestAccount
+{
+    SkywellAddress publicKey;
+    SkywellAddress secretKey;
+    std::uint32_t sequence;
+};
+
+enum
+{
+    testFee = 10000
+};
+
+inline
+TestAccount
+createAccount (std::string const& passphrase)
+{
+    SkywellAddress const seed =
+        SkywellAddress::createSeedGeneric (passphrase);
+    SkywellAddress const generator =
+        SkywellAddress::createGeneratorPublic (seed);
+
+    return { SkywellAddress::createAccountPublic (generator, 0),
+        SkywellAddress::createAccountPrivate (generator, seed, 0), 1 };
+}
+
+/** Start a transaction from the account, taking its next sequence.
+    Set the remaining fields, then call sign.
+*/
+inline
+STTx::pointer
+createTx (TxType type, TestAccount& from)
+{
+    auto txn = std::make_shared<STTx> (type);
+    txn->setSourceAccount (from.publicKey);
+    txn->setSigningPubKey (from.publicKey);
+    txn->setFieldAmount (sfFee, STAmount (testFee));
+    txn->setFieldU32 (sfSequence, from.sequence++);
+    return txn;
+}
+
+inline
+STTx::pointer
+sign (STTx::pointer const& txn, TestAccount const& from)
+{
+    txn->sign (from.secretKey);
+    return txn;
+}
+
+inline
+STTx::pointer
+pay (TestAccount& from, TestAccount const& to, STAmount const& amount)
+{
+    auto txn = createTx (ttPAYMENT, from);
+    txn->setFieldAccount (sfDestination, to.publicKey);
+    txn->setFieldAmount (sfAmount, amount);
+    return sign (txn, from);
+}
+
+/** A genesis ledger held by the master account, and an open ledger
+    after it.
+
+    Transactors read the manager and fee accounts from the config and
+    the last closed ledger, so they are set up here and the config is
+    put back afterwards.
+*/
+class TestLedger
+{
+public:
+    TestLedger ()
+        : master_ (createAccount ("masterpassphrase"))
+        , manager_ (createAccount ("manager"))
+        , feeAccount_ (createAccount ("fee"))
+        , oldManager_ (getConfig ().SMNG_ACCOUNTID)
+        , oldFeeAccount_ (getConfig ().FEE_ACCOUNTID)
+    {
+        getConfig ().SMNG_ACCOUNTID = manager_.publicKey;
+        getConfig ().FEE_ACCOUNTID = feeAccount_.publicKey;
+
+        Ledger::pointer genesis = std::make_shared<Ledger> (
+            master_.publicKey, SYSTEM_CURRENCY_START);
+        genesis->updateHash ();
+        genesis->setClosed ();
+        genesis->setAccepted ();
+        genesis->setImmutable ();
+
+        open_ = std::make_shared<Ledger> (true, std::ref (*genesis));
+        getApp ().getLedgerMaster ().pushLedger (genesis, open_);
+    }
+
+    ~TestLedger ()
+    {
+        getConfig ().SMNG_ACCOUNTID = oldManager_;
+        getConfig ().FEE_ACCOUNTID = oldFeeAccount_;
+    }
+
+    TestLedger (TestLedger const&) = delete;
+    TestLedger& operator= (TestLedger const&) = delete;
+
+    TestAccount& master () { return master_; }
+    TestAccount& manager () { return manager_; }
+    TestAccount& feeAccount () { return feeAccount_; }
+
+    /** The open ledger after genesis. */
+    Ledger::pointer const& open () const
+    {
+        return open_;
+    }
+
+private:
+    TestAccount master_;
+    TestAccount manager_;
+    TestAccount feeAccount_;
+    SkywellAddress const oldManager_;
+    SkywellAddress const oldFeeAccount_;
+    Ledger::pointer open_;
+};
+
+} // test
+} // truechain
+
+#endif